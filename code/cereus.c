@@ -1,5 +1,10 @@
 #include "everything.h"
 
+#if defined(_M_X64) || defined(__SSE2__)
+#define MOVEMENT_SIMD 1
+#include <immintrin.h>
+#endif
+
 #define FOR(i, n) for (int i = 0; i < n; i++)
 
 // TEMP: for profiling
@@ -144,8 +149,10 @@ typedef enum
     POPUP_TYPE_PHYSICS_TIMESTEP_CHANGE,
     POPUP_TYPE_CHEAT_MODE_TOGGLE,
     POPUP_TYPE_SHADER_MODE_CHANGE,
+    POPUP_TYPE_WATER_MODE_CHANGE,
     POPUP_TYPE_DRAW_TRAILING_HITBOX_TOGGLE,
     POPUP_TYPE_STEP_THROUGH_TOGGLE,
+    POPUP_TYPE_TURBO_MODE_TOGGLE,
     POPUP_TYPE_PAINT_BRUSH_RADIUS_CHANGE,
     POPUP_TYPE_EDITOR_BLOCK_PLACE_OOB,
     POPUP_TYPE_SUN_DIRECTION_CHANGE,
@@ -166,34 +173,52 @@ typedef struct Entity
     Direction direction;
     MirrorOrientation mirror_orientation;
     float yaw_offset; // in progress turn
-    float tilt_angle; // towards direction of movement
-    Vec3 settle_velocity; // max velocity along push
-    int32 settle_timer;
-    bool settle_do_extra_push;
-    Vec4 visual_tilt;
     Vec4 rotation;
 
     // movement state
     Vec3 velocity;
     Direction moving_direction; // deliberate movement: does not include falling.
     bool falling;
-    bool fall_handled; // reset each frame
+    int32 fall_handled_tick; // == physics_tick_count once this entity's fall has been handled this tick
+    int32 support_checked_tick; // last tick this entity was found resting on something. see columnSupportMayHaveChanged
     MoveType move_type;
 
     // for sources/lasers
     Color color;
 
-    // for win blocks
-    char next_level[64]; // TODO: make level names an enum so don't need to carry around 64 * char * 2 per entity
-
-    // for locked blocks (and other entities that are locked)
+    // for locked blocks (and other entities that are locked). unlocked_by lives in EntityMetadata
     bool locked;
-    char unlocked_by[64]; 
 }
 Entity;
 
 #define MAX_ENTITY_INSTANCE_COUNT 64
 #define ENTITY_TYPES 5
+#define ENTITY_SLOT_COUNT (2 + ENTITY_TYPES * MAX_ENTITY_INSTANCE_COUNT) // player + pack + every group
+
+// cold per-entity data, kept out of Entity so that the physics, undo and lookahead loops only touch the hot fields.
+// both tables are indexed by entity slot, i.e. the entity's position in WorldState (see entitySlot)
+typedef struct EntityVisuals
+{
+    float tilt_angle; // towards direction of movement
+    Vec3 settle_velocity; // max velocity along push
+    int32 settle_timer;
+    bool settle_do_extra_push;
+    Vec4 visual_tilt;
+}
+EntityVisuals;
+
+typedef struct EntityMetadata
+{
+    // for win blocks
+    char next_level[64]; // TODO: make level names an enum so don't need to carry around 64 * char * 2 per entity
+
+    // for locked blocks (and other entities that are locked)
+    char unlocked_by[64];
+}
+EntityMetadata;
+
+#define LEVEL_BUFFER_SIZE 100000
+#define MAX_LEVEL_TILES (LEVEL_BUFFER_SIZE / 2)
 
 // the approx. 2MB buffer is dense representation of the level encoded by coords
 typedef struct WorldState
@@ -206,7 +231,7 @@ typedef struct WorldState
     Entity win_blocks[MAX_ENTITY_INSTANCE_COUNT];
     Entity locked_blocks[MAX_ENTITY_INSTANCE_COUNT];
 
-    uint8 buffer[100000]; // 2 bytes info per tile
+    uint8 buffer[LEVEL_BUFFER_SIZE]; // 2 bytes info per tile
 
     char level_name[64];
 }
@@ -266,6 +291,71 @@ typedef struct VisualEffects
 }
 VisualEffects;
 
+// movement presses waiting for the player to be able to take them, oldest first
+#define MAX_QUEUED_INPUTS 4
+typedef struct QueuedInput
+{
+    Direction direction;
+    int32 press_tick; // physics_tick_count when pressed
+}
+QueuedInput;
+
+typedef struct InputQueue
+{
+    QueuedInput inputs[MAX_QUEUED_INPUTS];
+    int32 count;
+}
+InputQueue;
+
+// interactible entities (boxes, mirrors, sources) that might do something this tick. an entity leaves the set once it is at rest on a solid tile,
+// and is woken by anything that moves it or changes the tile under it. the player and pack are always processed, so aren't tracked here.
+typedef struct ActiveEntitySet
+{
+    int32 count;
+    int32 slots[ENTITY_SLOT_COUNT]; // kept sorted, so passes visit entities in the same order as a full scan of the groups
+    bool contains[ENTITY_SLOT_COUNT];
+}
+ActiveEntitySet;
+
+// structure-of-arrays copy of every entity being pushed this tick. gathered from the Entity structs, integrated a batch of lanes at a time, then scattered back.
+// padded so the vector loop can always run a full final batch without a scalar tail
+#define MOVEMENT_LANE_CAPACITY (ENTITY_SLOT_COUNT + 8)
+
+typedef enum MovementResult
+{
+    MOVEMENT_RESULT_REVERSED = 1, // target is behind the entity or more than half a tile ahead
+    MOVEMENT_RESULT_ARRIVED  = 2, // new position is exactly on coords
+}
+MovementResult;
+
+typedef struct MovementLanes
+{
+    int32 count;
+    Entity* entities[MOVEMENT_LANE_CAPACITY];
+    MoveType move_type[MOVEMENT_LANE_CAPACITY];
+    Direction moving_direction[MOVEMENT_LANE_CAPACITY];
+
+    float position_x[MOVEMENT_LANE_CAPACITY];
+    float position_y[MOVEMENT_LANE_CAPACITY];
+    float position_z[MOVEMENT_LANE_CAPACITY];
+    float velocity_x[MOVEMENT_LANE_CAPACITY];
+    float velocity_y[MOVEMENT_LANE_CAPACITY];
+    float velocity_z[MOVEMENT_LANE_CAPACITY];
+    float coords_x[MOVEMENT_LANE_CAPACITY];
+    float coords_y[MOVEMENT_LANE_CAPACITY];
+    float coords_z[MOVEMENT_LANE_CAPACITY];
+
+    // 1 on the moving_direction axis, 0 on the others
+    float axis_x[MOVEMENT_LANE_CAPACITY];
+    float axis_y[MOVEMENT_LANE_CAPACITY];
+    float axis_z[MOVEMENT_LANE_CAPACITY];
+    float sign[MOVEMENT_LANE_CAPACITY];
+    float root_offset[MOVEMENT_LANE_CAPACITY]; // root position - root coords along the moving axis
+
+    int32 result[MOVEMENT_LANE_CAPACITY]; // MovementResult flags, written by integrateMovementLanes
+}
+MovementLanes;
+
 // EDITOR STRUCTS
 
 typedef struct EditBuffer
@@ -360,6 +450,50 @@ typedef struct UndoBuffer
 }
 UndoBuffer;
 
+// SIMULATION CONTEXT
+
+// everything one running simulation owns. the core reads and writes through `sim`, which is per thread,
+// so each thread can step its own world (solvers, validators, replay checks) while the game uses default_sim_context.
+typedef struct SimContext
+{
+    WorldState world_state;
+    TemporaryState temp_state;
+    UndoBuffer undo_buffer;
+    Int3 level_dim;
+    Int3 level_origin;
+
+    // point into world_state. set by initializeSimContext
+    Entity* player;
+    Entity* pack;
+    Entity* all_entity_groups[5];
+    Entity* interactible_entity_groups[3];
+    Entity* lockable_entity_groups[4];
+
+    // side tables for world_state's entities (see EntityVisuals / EntityMetadata)
+    EntityVisuals entity_visuals[ENTITY_SLOT_COUNT];
+    EntityMetadata entity_metadata[ENTITY_SLOT_COUNT];
+
+    // simd movement
+    MovementLanes movement_lanes;
+
+    // active entities
+    ActiveEntitySet active_entities;
+    int32 physics_tick_count;
+
+    // gravity: physics_tick_count of the last tile change in each (x, z) column of the level
+    int32 column_change_tick[MAX_LEVEL_TILES];
+    int32 all_columns_change_tick; // bumped when the whole level is replaced (init, undo, reindex, etc.)
+
+    // copy of the tile types in world_state.buffer with a one tile border of walls, so neighbour lookups never need a bounds check.
+    // stepping to a neighbour is just index + padded_direction_stride[direction]. worst case size is a 1x1xN level: 3*3*(N+2)
+    uint8 padded_tiles[9 * (MAX_LEVEL_TILES + 2)];
+    Int3 padded_dim;
+    int32 padded_direction_stride[7]; // indexed by Direction
+
+    uint32 static_tile_generation; // bumped when a non-entity tile's type or direction changes, and on wholesale buffer replacement
+}
+SimContext;
+
 // CONSTS AND GLOBALS
 
 // continuous gameplay
@@ -380,7 +514,9 @@ const int32 MAX_BLUE_GAMEPLAY_TIME = 2;
 const int32 TRAILING_HITBOX_TIME = 7;
 const int32 FALL_TRAILING_HITBOX_TIME = 10;
 const int32 HALF_FAILED_PACK_TURN_COOLDOWN = 6;
-const int32 MAX_LOOKAHEAD_MOVEMENT_FRAMES = 16;
+const int32 INPUT_QUEUE_EXPIRY_TICKS = 16; // a press that can't be applied within this many ticks is dropped
+const int32 MAX_TURBO_RESOLVE_TICKS = 600; // guards against never settling, e.g. a box being pushed back and forth forever
+const int32 MAX_TURBO_RESOLVE_TICKS_PER_FRAME = 60; // a longer resolve is spread over the next frames, rather than stalling this one
 
 const int32 STANDARD_TIME_UNTIL_ALLOW_INPUT = 9;
 const int32 PLACE_BREAK_TIME_UNTIL_ALLOW_INPUT = 5;
@@ -465,19 +601,31 @@ const int32 OVERWORLD_SCREEN_SIZE_Z = 17;
 const float NO_WATER_PLANE_LOW_VALUE = -999.0f;
 
 // physics
-const double DEFAULT_PHYSICS_TIMESTEP = 1.0/60.0;
+const double DEFAULT_PHYSICS_TIMESTEP = GAME_TICK_SECONDS;
 double physics_timestep_multiplier = 1.0;
 double physics_accumulator = 0; // time accumulator affected by physics timestep
 double timer_accumulator = 0; // true time accumulator
 double global_time = 0; // will not work as a 'time elapsed' counter in editor mode because also affected by physics timestep
 bool step_mode = false;
 bool step_to_next_tick = false;
+bool turbo_mode = false; // resolve every move to its final discrete state on the frame it is made
+bool turbo_resolve_pending = false; // a move is still being resolved, and new movement waits for it
+int32 turbo_resolve_ticks = 0; // ticks spent on the pending resolve so far
+int32 turbo_resolve_frame_budget = 0; // ticks the pending resolve may still take this frame
+bool verify_fall_gating = false; // falling pass also runs the full scan on entities the column gate skips. see gameFallGatingCheck
+int32 fall_gating_mismatches = 0;
 
 DisplayInfo game_display = {0};
 Input prev_input = {0}; // copied from previous frame input to generate keys_pressed
 
-DrawCommand draw_commands[16384] = {0};
+DrawCommand draw_commands[MAX_DRAW_COMMANDS] = {0};
 int32 draw_command_count = 0;
+int32 draw_interpolation_id = 0; // stamped onto draw commands while set; see gameInterpolateSnapshots
+uint32 continuity_generation = 0; // bumped whenever the world jumps rather than moves, so snapshots on either side are not blended
+
+// interpolation ids: 0 for none, then one per entity slot, then one per laser_buffer entry
+#define LASER_INTERPOLATION_ID_BASE (ENTITY_SLOT_COUNT + 1)
+#define INTERPOLATION_ID_COUNT (LASER_INTERPOLATION_ID_BASE + 512) // at most MAX_INTERPOLATED_DRAWS, so every id fits in a snapshot
 
 // debug stuff
 const int32 FONT_FIRST_ASCII = 32;
@@ -500,6 +648,7 @@ DebugPopup debug_popups[32];
 
 EditorState editor_state = {0};
 ShaderMode game_shader_mode = SHADER_MODE_DEFAULT;
+WaterMode game_water_mode = WATER_MODE_BAKED_LOOP;
 bool draw_trailing_hitboxes = false;
 bool cheating = false;
 
@@ -529,12 +678,10 @@ float camera_lerp_t = 0.0f;
 int32 camera_target_plane = 0; // y level of xz plane which calculates targeted point during camera interpolation function
 
 // general state
-WorldState world_state = {0};
-TemporaryState temp_state = {0};
+SimContext default_sim_context = {0};
+__declspec(thread) SimContext* sim = &default_sim_context;
 VisualEffects visual_effects = {0};
 GameProgress game_progress = PROGRESS_START;
-Int3 level_dim = {0};
-Int3 level_origin = {0};
 Int3 overworld_restart_coords = {0};
 bool in_overworld = true;
 char solved_levels[64][64];
@@ -543,25 +690,20 @@ float water_plane_y = 0.0f; // NOTE: currently is never unset from 0. which is f
 Rgba8 water_texture_scratch[WATER_PAINT_MAX_SIDE * WATER_PAINT_MAX_SIDE] = {0};
 Vec3 sun_direction = {0};
 
-Entity* player = &world_state.player;
-Entity* pack = &world_state.pack;
-Entity* all_entity_groups[5] = { world_state.boxes, world_state.mirrors, world_state.locked_blocks, world_state.sources, world_state.win_blocks };
-Entity* interactible_entity_groups[3] = { world_state.boxes, world_state.mirrors, world_state.sources };
-Entity* lockable_entity_groups[4] = { world_state.boxes, world_state.mirrors, world_state.win_blocks, world_state.sources };
-
 WorldState leap_of_faith_world_state_snapshot = {0};
 TemporaryState leap_of_faith_temp_state_snapshot = {0};
-WorldState lookahead_world_state_snapshot = {0};
-TemporaryState lookahead_temp_state_snapshot = {0};
+
+// buffered movement input
+InputQueue input_queue = {0};
 
 WorldState overworld_zero_state = {0};
-uint8 temp_buffer_array[sizeof(world_state.buffer)];
+EntityMetadata overworld_zero_metadata[ENTITY_SLOT_COUNT] = {0};
+uint8 temp_buffer_array[LEVEL_BUFFER_SIZE];
 
 int32 time_until_allow_meta_input = 0;
 int32 time_until_allow_undo_or_restart_input = 0;
 
 // undos
-UndoBuffer undo_buffer = {0};
 int32 undos_performed = 0;
 bool restart_last_turn = false;
 
@@ -571,6 +713,36 @@ int32 profiling_frame_counter = 0;
 // water paint
 WaterPaintTexture water_paint_texture = {0};
 
+// SIM CONTEXT HELPERS
+
+// fixes up the pointers into the context's own world_state. needed once for any new context
+void initializeSimContext(SimContext* context)
+{
+    WorldState* ws = &context->world_state;
+    context->player = &ws->player;
+    context->pack = &ws->pack;
+
+    Entity* all_groups[5] = { ws->boxes, ws->mirrors, ws->locked_blocks, ws->sources, ws->win_blocks };
+    Entity* interactible_groups[3] = { ws->boxes, ws->mirrors, ws->sources };
+    Entity* lockable_groups[4] = { ws->boxes, ws->mirrors, ws->win_blocks, ws->sources };
+    memcpy(context->all_entity_groups, all_groups, sizeof(all_groups));
+    memcpy(context->interactible_entity_groups, interactible_groups, sizeof(interactible_groups));
+    memcpy(context->lockable_entity_groups, lockable_groups, sizeof(lockable_groups));
+}
+
+// e.g. to fork the game's current simulation into a solver's context
+void copySimContext(SimContext* to, SimContext* from)
+{
+    memcpy(to, from, sizeof(SimContext));
+    initializeSimContext(to);
+}
+
+// all core functions act on the calling thread's current context
+void setSimContext(SimContext* context)
+{
+    sim = context;
+}
+
 // MATH HELPER FUNCTIONS
 
 float floatMax(float a, float b)
@@ -744,6 +916,14 @@ Vec4 quaternionNormalize(Vec4 q)
     return (Vec4){ q.x * inverse_length, q.y * inverse_length, q.z * inverse_length, q.w * inverse_length };
 }
 
+// normalised lerp, along the shorter arc. fine for the small steps between two frames
+Vec4 quaternionNlerp(Vec4 q_a, Vec4 q_b, float t)
+{
+    if (quaternionInnerProduct(q_a, q_b) < 0.0f) q_b = quaternionNegate(q_b);
+    Vec4 q = { q_a.x + (q_b.x - q_a.x) * t, q_a.y + (q_b.y - q_a.y) * t, q_a.z + (q_b.z - q_a.z) * t, q_a.w + (q_b.w - q_a.w) * t };
+    return quaternionNormalize(q);
+}
+
 // NOTE: could use the optimised version when i understand quaternions better. for now, this is more transparent
 Vec3 vec3RotateByQuaternion(Vec3 v, Vec4 q)
 {
@@ -858,16 +1038,16 @@ void cameraBasisFromYaw(float yaw, Vec3* right, Vec3* forward)
 
 bool intCoordsWithinLevelBounds(Int3 coords) 
 {
-    return coords.x >= level_origin.x && coords.y >= level_origin.y && coords.z >= level_origin.z
-        && coords.x < level_origin.x + level_dim.x && coords.y < level_origin.y + level_dim.y && coords.z < level_origin.z + level_dim.z;
+    return coords.x >= sim->level_origin.x && coords.y >= sim->level_origin.y && coords.z >= sim->level_origin.z
+        && coords.x < sim->level_origin.x + sim->level_dim.x && coords.y < sim->level_origin.y + sim->level_dim.y && coords.z < sim->level_origin.z + sim->level_dim.z;
 }
 
 int32 coordsToBufferIndexType(Int3 coords)
 {
-    int32 x = coords.x - level_origin.x;
-    int32 y = coords.y - level_origin.y;
-    int32 z = coords.z - level_origin.z;
-    return 2 * (level_dim.x*level_dim.z*y + level_dim.x*z + x);
+    int32 x = coords.x - sim->level_origin.x;
+    int32 y = coords.y - sim->level_origin.y;
+    int32 z = coords.z - sim->level_origin.z;
+    return 2 * (sim->level_dim.x*sim->level_dim.z*y + sim->level_dim.x*z + x);
 }
 
 int32 coordsToBufferIndexDirection(Int3 coords)
@@ -879,20 +1059,66 @@ Int3 bufferIndexToCoords(int32 buffer_index)
 {
     int32 tile_index = buffer_index / 2; // TODO: probably redo this with a struct instead of always dealing with "two bytes"?
     return (Int3){
-        (tile_index % level_dim.x) + level_origin.x,
-        tile_index / (level_dim.x*level_dim.z) + level_origin.y,
-        (tile_index / level_dim.x) % level_dim.z + level_origin.z,
+        (tile_index % sim->level_dim.x) + sim->level_origin.x,
+        tile_index / (sim->level_dim.x*sim->level_dim.z) + sim->level_origin.y,
+        (tile_index / sim->level_dim.x) % sim->level_dim.z + sim->level_origin.z,
     };
 }
 
-void setTileType(TileType type, Int3 coords) 
+int32 coordsToColumnIndex(Int3 coords)
 {
-    world_state.buffer[coordsToBufferIndexType(coords)] = type; 
+    return sim->level_dim.x*(coords.z - sim->level_origin.z) + (coords.x - sim->level_origin.x);
 }
 
-void setTileDirection(Direction direction, Int3 coords, MirrorOrientation mirror_orientation)
+void markColumnChanged(Int3 coords)
+{
+    if (!intCoordsWithinLevelBounds(coords)) return;
+    sim->column_change_tick[coordsToColumnIndex(coords)] = sim->physics_tick_count;
+}
+
+void markAllColumnsChanged()
+{
+    sim->all_columns_change_tick = sim->physics_tick_count;
+}
+
+// an entity's support can only be gone if some tile in its column changed since it was last found resting
+bool columnSupportMayHaveChanged(Entity* e)
+{
+    if (!intCoordsWithinLevelBounds(e->coords)) return true;
+    int32 change_tick = sim->column_change_tick[coordsToColumnIndex(e->coords)];
+    if (sim->all_columns_change_tick > change_tick) change_tick = sim->all_columns_change_tick;
+    return change_tick >= e->support_checked_tick;
+}
+
+// valid for coords inside the level or on its border
+int32 coordsToPaddedIndex(Int3 coords)
+{
+    int32 x = coords.x - sim->level_origin.x + 1;
+    int32 y = coords.y - sim->level_origin.y + 1;
+    int32 z = coords.z - sim->level_origin.z + 1;
+    return sim->padded_dim.x*sim->padded_dim.z*y + sim->padded_dim.x*z + x;
+}
+
+// called whenever level_dim / level_origin change or the buffer is replaced wholesale
+void rebuildPaddedGrid()
 {
-    world_state.buffer[coordsToBufferIndexDirection(coords)] = (uint8)(direction + 8*mirror_orientation);
+    sim->padded_dim = int3Add(sim->level_dim, (Int3){ 2,2,2 });
+    sim->padded_direction_stride[NO_DIRECTION] = 0;
+    sim->padded_direction_stride[NORTH] = -sim->padded_dim.x;
+    sim->padded_direction_stride[WEST]  = -1;
+    sim->padded_direction_stride[SOUTH] =  sim->padded_dim.x;
+    sim->padded_direction_stride[EAST]  =  1;
+    sim->padded_direction_stride[UP]    =  sim->padded_dim.x*sim->padded_dim.z;
+    sim->padded_direction_stride[DOWN]  = -sim->padded_dim.x*sim->padded_dim.z;
+
+    memset(sim->padded_tiles, TILE_TYPE_WALL, sim->padded_dim.x*sim->padded_dim.y*sim->padded_dim.z);
+    FOR(y, sim->level_dim.y) FOR(z, sim->level_dim.z)
+    {
+        uint8* padded_row = &sim->padded_tiles[coordsToPaddedIndex(int3Add(sim->level_origin, (Int3){ 0, y, z }))];
+        uint8* buffer_row = &sim->world_state.buffer[2 * (sim->level_dim.x*sim->level_dim.z*y + sim->level_dim.x*z)];
+        FOR(x, sim->level_dim.x) padded_row[x] = buffer_row[2*x];
+    }
+    sim->static_tile_generation++;
 }
 
 TileType getTileType(Int3 coords) 
@@ -901,13 +1127,13 @@ TileType getTileType(Int3 coords)
     {
         return TILE_TYPE_WALL;
     }
-    return world_state.buffer[coordsToBufferIndexType(coords)]; 
+    return sim->world_state.buffer[coordsToBufferIndexType(coords)]; 
 }
 
 Direction getTileDirection(Int3 coords) 
 {
     if (!intCoordsWithinLevelBounds(coords)) return NO_DIRECTION;
-    return world_state.buffer[coordsToBufferIndexDirection(coords)]; 
+    return sim->world_state.buffer[coordsToBufferIndexDirection(coords)]; 
 }
 
 TileType getTileTypeFromId(int32 id)
@@ -933,28 +1159,13 @@ TileType getTileTypeFromId(int32 id)
     else return TILE_TYPE_NONE;
 }
 
-// sets coords and position of an entity to some values, and updates the buffer accordingly 
-void moveEntityInBufferAndState(Entity* e, Int3 end_coords, Direction end_direction)
-{
-    TileType type = getTileTypeFromId(e->id);
-    if (getTileType(e->coords) == type) 
-    {
-        setTileType(TILE_TYPE_NONE, e->coords);
-        setTileDirection(NO_DIRECTION, e->coords, e->mirror_orientation);
-    }
-    e->coords = end_coords;
-    e->direction = end_direction;
-    setTileType(type, end_coords);
-    setTileDirection(end_direction, end_coords, e->mirror_orientation);
-}
-
 void getLevelMinAndMax(Int3* level_min, Int3* level_max)
 {
     *level_min = (Int3){ INT32_MAX, INT32_MAX, INT32_MAX };
     *level_max = (Int3){ INT32_MIN, INT32_MIN, INT32_MIN };
-    for (int32 tile_index = 0; tile_index < 2 * level_dim.x*level_dim.y*level_dim.z; tile_index += 2)
+    for (int32 tile_index = 0; tile_index < 2 * sim->level_dim.x*sim->level_dim.y*sim->level_dim.z; tile_index += 2)
     {
-        if (world_state.buffer[tile_index] == TILE_TYPE_NONE) continue;
+        if (sim->world_state.buffer[tile_index] == TILE_TYPE_NONE) continue;
         Int3 coords = bufferIndexToCoords(tile_index);
         if (coords.x > level_max->x) level_max->x = coords.x;
         if (coords.y > level_max->y) level_max->y = coords.y;
@@ -969,26 +1180,26 @@ void getLevelMinAndMax(Int3* level_min, Int3* level_max)
 bool reindexBuffer(Int3 new_origin, Int3 new_dim)
 {
     int32 new_total_tiles = new_dim.x*new_dim.y*new_dim.z;
-    if (new_total_tiles * 2 > (int32)sizeof(world_state.buffer)) return false;
+    if (new_total_tiles * 2 > (int32)sizeof(sim->world_state.buffer)) return false;
 
-    for (int32 tile_index = 0; tile_index < 2 * level_dim.x*level_dim.y*level_dim.z; tile_index += 2)
+    for (int32 tile_index = 0; tile_index < 2 * sim->level_dim.x*sim->level_dim.y*sim->level_dim.z; tile_index += 2)
     {
-        if (world_state.buffer[tile_index] == TILE_TYPE_NONE) continue;
+        if (sim->world_state.buffer[tile_index] == TILE_TYPE_NONE) continue;
         Int3 coords = bufferIndexToCoords(tile_index);
         int32 new_x = coords.x - new_origin.x;
         int32 new_y = coords.y - new_origin.y;
         int32 new_z = coords.z - new_origin.z;
         if (new_x < 0 || new_y < 0 || new_z < 0 || new_x >= new_dim.x || new_y >= new_dim.y || new_z >= new_dim.z) continue;
         int32 new_index = 2 * (new_dim.x*new_dim.z*new_y + new_dim.x*new_z + new_x);
-        temp_buffer_array[new_index] = world_state.buffer[tile_index];
-        temp_buffer_array[new_index + 1] = world_state.buffer[tile_index + 1];
+        temp_buffer_array[new_index] = sim->world_state.buffer[tile_index];
+        temp_buffer_array[new_index + 1] = sim->world_state.buffer[tile_index + 1];
     }
-    memcpy(world_state.buffer, temp_buffer_array, new_total_tiles * 2);
+    memcpy(sim->world_state.buffer, temp_buffer_array, new_total_tiles * 2);
     memset(temp_buffer_array, 0, new_total_tiles*2);
 
     // reindex water texture
-    int32 old_width  = level_dim.x * WATER_PAINT_RESOLUTION;
-    int32 old_height = level_dim.z * WATER_PAINT_RESOLUTION;
+    int32 old_width  = sim->level_dim.x * WATER_PAINT_RESOLUTION;
+    int32 old_height = sim->level_dim.z * WATER_PAINT_RESOLUTION;
     if (old_width  > WATER_PAINT_MAX_SIDE) old_width  = WATER_PAINT_MAX_SIDE;
     if (old_height > WATER_PAINT_MAX_SIDE) old_height = WATER_PAINT_MAX_SIDE;
     int32 new_width  = new_dim.x * WATER_PAINT_RESOLUTION;
@@ -996,8 +1207,8 @@ bool reindexBuffer(Int3 new_origin, Int3 new_dim)
     if (new_width  > WATER_PAINT_MAX_SIDE) new_width  = WATER_PAINT_MAX_SIDE;
     if (new_height > WATER_PAINT_MAX_SIDE) new_height = WATER_PAINT_MAX_SIDE;
 
-    int32 shift_x = (new_origin.x - level_origin.x) * WATER_PAINT_RESOLUTION;
-    int32 shift_z = (new_origin.z - level_origin.z) * WATER_PAINT_RESOLUTION;
+    int32 shift_x = (new_origin.x - sim->level_origin.x) * WATER_PAINT_RESOLUTION;
+    int32 shift_z = (new_origin.z - sim->level_origin.z) * WATER_PAINT_RESOLUTION;
 
     FOR(scratch_index, new_width * new_height) water_texture_scratch[scratch_index] = (Rgba8){ 0, 0, 0, 0 };
 
@@ -1013,10 +1224,11 @@ bool reindexBuffer(Int3 new_origin, Int3 new_dim)
         }
     }
     memcpy(water_paint_texture.values, water_texture_scratch, sizeof(Rgba8) * new_width * new_height);
-    water_paint_texture.dirty = true;
+    water_paint_texture.generation++;
 
-    level_origin = new_origin;
-    level_dim = new_dim;
+    sim->level_origin = new_origin;
+    sim->level_dim = new_dim;
+    rebuildPaddedGrid();
     return true;
 }
 
@@ -1038,6 +1250,29 @@ bool isEntity(TileType type)
     return (type == TILE_TYPE_BOX || type == TILE_TYPE_MIRROR || type == TILE_TYPE_PACK || type == TILE_TYPE_PLAYER || type == TILE_TYPE_WIN_BLOCK || type == TILE_TYPE_LOCKED_BLOCK || isSource(type));
 }
 
+// drawn by drawStaticTiles, rather than per entity
+bool isStaticTile(TileType type)
+{
+    return type != TILE_TYPE_NONE && !isEntity(type);
+}
+
+void setTileType(TileType type, Int3 coords) 
+{
+    uint8* buffer_type = &sim->world_state.buffer[coordsToBufferIndexType(coords)];
+    if (*buffer_type != type && (isStaticTile(*buffer_type) || isStaticTile(type))) sim->static_tile_generation++; // entity moves leave the static draws alone
+    *buffer_type = type; 
+    sim->padded_tiles[coordsToPaddedIndex(coords)] = (uint8)type;
+    markColumnChanged(coords);
+}
+
+void setTileDirection(Direction direction, Int3 coords, MirrorOrientation mirror_orientation)
+{
+    uint8* buffer_direction = &sim->world_state.buffer[coordsToBufferIndexDirection(coords)];
+    uint8 new_direction = (uint8)(direction + 8*mirror_orientation);
+    if (*buffer_direction != new_direction && isStaticTile(sim->world_state.buffer[coordsToBufferIndexType(coords)])) sim->static_tile_generation++;
+    *buffer_direction = new_direction;
+}
+
 Color getEntityColor(Int3 coords)
 {
     switch (getTileType(coords))
@@ -1053,15 +1288,15 @@ Entity* getEntityAtCoords(Int3 coords)
 {
     TileType tile = getTileType(coords);
     Entity *entity_group = 0;
-    if (isSource(tile)) entity_group = world_state.sources;
+    if (isSource(tile)) entity_group = sim->world_state.sources;
     else switch(tile)
     {
-        case TILE_TYPE_BOX:          entity_group = world_state.boxes;         break;
-        case TILE_TYPE_MIRROR:       entity_group = world_state.mirrors;       break;
-        case TILE_TYPE_WIN_BLOCK:    entity_group = world_state.win_blocks;    break;
-        case TILE_TYPE_LOCKED_BLOCK: entity_group = world_state.locked_blocks; break;
-        case TILE_TYPE_PLAYER: return &world_state.player;
-        case TILE_TYPE_PACK:   return &world_state.pack;
+        case TILE_TYPE_BOX:          entity_group = sim->world_state.boxes;         break;
+        case TILE_TYPE_MIRROR:       entity_group = sim->world_state.mirrors;       break;
+        case TILE_TYPE_WIN_BLOCK:    entity_group = sim->world_state.win_blocks;    break;
+        case TILE_TYPE_LOCKED_BLOCK: entity_group = sim->world_state.locked_blocks; break;
+        case TILE_TYPE_PLAYER: return &sim->world_state.player;
+        case TILE_TYPE_PACK:   return &sim->world_state.pack;
         default: return 0;
     }
     for (int entity_index = 0; entity_index < MAX_ENTITY_INSTANCE_COUNT; entity_index++)
@@ -1075,23 +1310,164 @@ Entity* getEntityAtCoords(Int3 coords)
 Entity* getEntityFromId(int32 id)
 {
     if (id <= 0) return 0;
-    if (id == PLAYER_ID) return &world_state.player;
-    else if (id == PACK_ID) return &world_state.pack;
+    if (id == PLAYER_ID) return &sim->world_state.player;
+    else if (id == PACK_ID) return &sim->world_state.pack;
     else 
     {
         Entity* entity_group = 0;
         int32 switch_value =  ((id / 100) * 100);
-        if      (switch_value == ID_OFFSET_BOX)          entity_group = world_state.boxes; 
-        else if (switch_value == ID_OFFSET_MIRROR)       entity_group = world_state.mirrors;
-        else if (switch_value >= ID_OFFSET_SOURCE && switch_value < ID_OFFSET_WIN_BLOCK) entity_group = world_state.sources;
-        else if (switch_value == ID_OFFSET_WIN_BLOCK)    entity_group = world_state.win_blocks;
-        else if (switch_value == ID_OFFSET_LOCKED_BLOCK) entity_group = world_state.locked_blocks;
+        if      (switch_value == ID_OFFSET_BOX)          entity_group = sim->world_state.boxes; 
+        else if (switch_value == ID_OFFSET_MIRROR)       entity_group = sim->world_state.mirrors;
+        else if (switch_value >= ID_OFFSET_SOURCE && switch_value < ID_OFFSET_WIN_BLOCK) entity_group = sim->world_state.sources;
+        else if (switch_value == ID_OFFSET_WIN_BLOCK)    entity_group = sim->world_state.win_blocks;
+        else if (switch_value == ID_OFFSET_LOCKED_BLOCK) entity_group = sim->world_state.locked_blocks;
 
         FOR(entity_index, MAX_ENTITY_INSTANCE_COUNT) if (entity_group[entity_index].id == id) return &entity_group[entity_index];
         return 0;
     }
 }
 
+// all entities in a WorldState are laid out back to back (player, pack, then each group), so the slot is just the offset from player
+int32 entitySlot(WorldState* state, Entity* e)
+{
+    return (int32)(((uint8*)e - (uint8*)&state->player) / sizeof(Entity));
+}
+
+EntityVisuals* getEntityVisuals(Entity* e)
+{
+    return &sim->entity_visuals[entitySlot(&sim->world_state, e)];
+}
+
+EntityMetadata* getEntityMetadata(Entity* e)
+{
+    return &sim->entity_metadata[entitySlot(&sim->world_state, e)];
+}
+
+Entity* getEntityFromSlot(int32 slot)
+{
+    return (Entity*)((uint8*)&sim->world_state.player + slot * sizeof(Entity));
+}
+
+// ACTIVE ENTITIES
+
+bool slotIsInteractible(int32 slot)
+{
+    int32 first_slot = entitySlot(&sim->world_state, sim->world_state.boxes);
+    return slot >= first_slot && slot < first_slot + 3 * MAX_ENTITY_INSTANCE_COUNT; // boxes, mirrors, sources are laid out back to back
+}
+
+void wakeEntity(Entity* e)
+{
+    int32 slot = entitySlot(&sim->world_state, e);
+    if (!slotIsInteractible(slot) || sim->active_entities.contains[slot]) return;
+
+    // sorted insert. the set is small, so shifting is cheap
+    int32 insert_index = sim->active_entities.count;
+    while (insert_index > 0 && sim->active_entities.slots[insert_index - 1] > slot)
+    {
+        sim->active_entities.slots[insert_index] = sim->active_entities.slots[insert_index - 1];
+        insert_index--;
+    }
+    sim->active_entities.slots[insert_index] = slot;
+    sim->active_entities.contains[slot] = true;
+    sim->active_entities.count++;
+}
+
+// the entity at coords may have been moved or replaced, and the one above may have lost its support
+void wakeEntitiesAroundTile(Int3 coords)
+{
+    FOR(offset_y, 2)
+    {
+        Int3 wake_coords = { coords.x, coords.y + offset_y, coords.z };
+        if (!isPushable(getTileType(wake_coords))) continue;
+        Entity* e = getEntityAtCoords(wake_coords);
+        if (e) wakeEntity(e);
+    }
+}
+
+// called whenever the whole world is replaced, so also invalidates every column's support
+void wakeAllEntities()
+{
+    markAllColumnsChanged();
+    rebuildPaddedGrid();
+    memset(&sim->active_entities, 0, sizeof(ActiveEntitySet));
+    FOR(group_index, 3)
+    {
+        FOR(entity_index, MAX_ENTITY_INSTANCE_COUNT)
+        {
+            Entity* e = &sim->interactible_entity_groups[group_index][entity_index];
+            if (e->in_use) wakeEntity(e);
+        }
+    }
+}
+
+// walks active entities in slot order, then the player, then the pack. entities woken mid-walk are still visited if they come later in the order, same as a full scan
+Entity* nextActiveEntity(int32* cursor)
+{
+    if (*cursor < ENTITY_SLOT_COUNT)
+    {
+        FOR(active_index, sim->active_entities.count)
+        {
+            if (sim->active_entities.slots[active_index] <= *cursor) continue;
+            *cursor = sim->active_entities.slots[active_index];
+            return getEntityFromSlot(*cursor);
+        }
+        *cursor = ENTITY_SLOT_COUNT;
+        return sim->player;
+    }
+    if (*cursor == ENTITY_SLOT_COUNT)
+    {
+        *cursor = ENTITY_SLOT_COUNT + 1;
+        return sim->pack;
+    }
+    return 0;
+}
+
+// true if nothing in doPhysicsTick will touch this entity until something wakes it
+bool entityCanSleep(Entity* e)
+{
+    if (!e->in_use || e->removed) return true;
+    if (e->move_type != MOVE_TYPE_NONE || e->moving_direction != NO_DIRECTION || e->falling) return false;
+    if (!vec3IsZero(e->velocity) || !vec3IsEqual(e->position, vec3FromInt3(e->coords))) return false;
+    if (getEntityVisuals(e)->settle_timer > 0) return false;
+
+    // resting on something solid, so only a change to that tile can make it fall. (a trailing hitbox below can expire without a tile change)
+    TileType type_below = getTileType((Int3){ e->coords.x, e->coords.y - 1, e->coords.z });
+    return type_below != TILE_TYPE_NONE && type_below != TILE_TYPE_VOID;
+}
+
+void sleepSettledEntities()
+{
+    int32 keep_count = 0;
+    FOR(active_index, sim->active_entities.count)
+    {
+        int32 slot = sim->active_entities.slots[active_index];
+        if (entityCanSleep(getEntityFromSlot(slot))) sim->active_entities.contains[slot] = false;
+        else sim->active_entities.slots[keep_count++] = slot;
+    }
+    sim->active_entities.count = keep_count;
+}
+
+// sets coords and position of an entity to some values, and updates the buffer accordingly 
+void moveEntityInBufferAndState(Entity* e, Int3 end_coords, Direction end_direction)
+{
+    TileType type = getTileTypeFromId(e->id);
+    Int3 start_coords = e->coords;
+    if (getTileType(e->coords) == type) 
+    {
+        setTileType(TILE_TYPE_NONE, e->coords);
+        setTileDirection(NO_DIRECTION, e->coords, e->mirror_orientation);
+    }
+    e->coords = end_coords;
+    e->direction = end_direction;
+    setTileType(type, end_coords);
+    setTileDirection(end_direction, end_coords, e->mirror_orientation);
+
+    wakeEntity(e);
+    wakeEntitiesAroundTile(start_coords);
+    wakeEntitiesAroundTile(end_coords);
+}
+
 Direction oppositeDirection(Direction direction)
 {
     switch (direction)
@@ -1108,11 +1484,11 @@ Direction oppositeDirection(Direction direction)
 
 int32 entityIdOffset(Entity *entity, Color color)
 {
-    if      (entity == world_state.boxes)         return ID_OFFSET_BOX;
-    else if (entity == world_state.mirrors)       return ID_OFFSET_MIRROR;
-    else if (entity == world_state.win_blocks)    return ID_OFFSET_WIN_BLOCK;
-    else if (entity == world_state.locked_blocks) return ID_OFFSET_LOCKED_BLOCK;
-    else if (entity == world_state.sources)       return ID_OFFSET_SOURCE + ((color - 1) * 100);
+    if      (entity == sim->world_state.boxes)         return ID_OFFSET_BOX;
+    else if (entity == sim->world_state.mirrors)       return ID_OFFSET_MIRROR;
+    else if (entity == sim->world_state.win_blocks)    return ID_OFFSET_WIN_BLOCK;
+    else if (entity == sim->world_state.locked_blocks) return ID_OFFSET_LOCKED_BLOCK;
+    else if (entity == sim->world_state.sources)       return ID_OFFSET_SOURCE + ((color - 1) * 100);
     return 0;
 }
 
@@ -1166,15 +1542,16 @@ int32 setEntityInstanceInGroup(Entity* entity_group, Int3 coords, Direction dire
         e->position = vec3FromInt3(coords); 
         e->direction = direction;
         e->yaw_offset = 0;
-        e->visual_tilt = IDENTITY_QUATERNION;
+        getEntityVisuals(e)->visual_tilt = IDENTITY_QUATERNION;
         e->rotation = composeRotation(direction, orientation, 0.0f, IDENTITY_QUATERNION);
         e->velocity = (Vec3){0};
         e->color = color;
         e->id = entity_index + entityIdOffset(entity_group, color);
         e->removed = false;
         e->in_use = true;
-        e->unlocked_by[0] = '\0';
-        e->next_level[0] = '\0';
+        getEntityMetadata(e)->unlocked_by[0] = '\0';
+        getEntityMetadata(e)->next_level[0] = '\0';
+        wakeEntity(e);
         return entity_group[entity_index].id;
     }
     return 0;
@@ -1209,14 +1586,14 @@ Direction getDirectionFromCoordDiff(Int3 to_coords, Int3 from_coords)
 
 int32 getPushableStackSize(Int3 first_coords, Direction seek_direction)
 {
-    Int3 current_stack_coords = first_coords;
+    int32 tile_index = coordsToPaddedIndex(first_coords);
+    int32 stride = sim->padded_direction_stride[seek_direction];
     int32 stack_size = 0;
     FOR(find_stack_size_index, MAX_PUSHABLE_STACK_SIZE)
     {
-        TileType next_tile_type = getTileType(current_stack_coords);
-        if (!isPushable(next_tile_type)) break;
+        if (!isPushable(sim->padded_tiles[tile_index])) break;
         stack_size++;
-        current_stack_coords = getNextCoords(current_stack_coords, seek_direction);
+        tile_index += stride;
     }
     return stack_size;
 }
@@ -1278,12 +1655,12 @@ void loadBufferInfo(FILE* file)
 
     int32 size = 0;
     fread(&size, 4, 1, file);
-    fread(&level_dim.x, 4, 1, file);
-    fread(&level_dim.y, 4, 1, file);
-    fread(&level_dim.z, 4, 1, file);
-    fread(&level_origin.x, 4, 1, file);
-    fread(&level_origin.y, 4, 1, file);
-    fread(&level_origin.z, 4, 1, file);
+    fread(&sim->level_dim.x, 4, 1, file);
+    fread(&sim->level_dim.y, 4, 1, file);
+    fread(&sim->level_dim.z, 4, 1, file);
+    fread(&sim->level_origin.x, 4, 1, file);
+    fread(&sim->level_origin.y, 4, 1, file);
+    fread(&sim->level_origin.z, 4, 1, file);
 
     int32 tile_count = (size - 24) / 6;
     FOR(tile_index, tile_count)
@@ -1294,9 +1671,10 @@ void loadBufferInfo(FILE* file)
         fread(&buffer_index, 4, 1, file);
         fread(&type, 1, 1, file);
         fread(&direction, 1, 1, file);
-        world_state.buffer[buffer_index] = type;
-        world_state.buffer[buffer_index + 1] = direction;
+        sim->world_state.buffer[buffer_index] = type;
+        sim->world_state.buffer[buffer_index + 1] = direction;
     }
+    rebuildPaddedGrid();
 }
 
 Camera loadCameraInfo(FILE* file, bool use_alt_camera)
@@ -1340,10 +1718,10 @@ void loadWinBlockPaths(FILE* file)
 
         FOR(wb_index, MAX_ENTITY_INSTANCE_COUNT)
         {
-            Entity* wb = &world_state.win_blocks[wb_index];
+            Entity* wb = &sim->world_state.win_blocks[wb_index];
             if (wb->coords.x == x && wb->coords.y == y && wb->coords.z == z)
             {
-                memcpy(wb->next_level, path, sizeof(wb->next_level));
+                memcpy(getEntityMetadata(wb)->next_level, path, sizeof(getEntityMetadata(wb)->next_level));
                 break;
             }
         }
@@ -1371,10 +1749,10 @@ void loadLockedInfoPaths(FILE* file)
         {
             FOR(entity_index, MAX_ENTITY_INSTANCE_COUNT)
             {
-                Entity* e = &all_entity_groups[group_index][entity_index];
+                Entity* e = &sim->all_entity_groups[group_index][entity_index];
                 if (e->coords.x == x && e->coords.y == y && e->coords.z == z)
                 {
-                    memcpy(e->unlocked_by, path, sizeof(e->unlocked_by));
+                    memcpy(getEntityMetadata(e)->unlocked_by, path, sizeof(getEntityMetadata(e)->unlocked_by));
                     break;
                 }
             }
@@ -1414,19 +1792,19 @@ void writeTileChunkToFile(FILE* file)
     int32 size_pos = ftell(file); // will backsolve size at this point later
     fseek(file, 4, SEEK_CUR);
 
-    fwrite(&level_dim.x, 4, 1, file);
-    fwrite(&level_dim.y, 4, 1, file);
-    fwrite(&level_dim.z, 4, 1, file);
-    fwrite(&level_origin.x, 4, 1, file);
-    fwrite(&level_origin.y, 4, 1, file);
-    fwrite(&level_origin.z, 4, 1, file);
+    fwrite(&sim->level_dim.x, 4, 1, file);
+    fwrite(&sim->level_dim.y, 4, 1, file);
+    fwrite(&sim->level_dim.z, 4, 1, file);
+    fwrite(&sim->level_origin.x, 4, 1, file);
+    fwrite(&sim->level_origin.y, 4, 1, file);
+    fwrite(&sim->level_origin.z, 4, 1, file);
 
     int32 tile_count = 0;
-    for (int buffer_index = 0; buffer_index < level_dim.x*level_dim.y*level_dim.z * 2; buffer_index += 2)
+    for (int buffer_index = 0; buffer_index < sim->level_dim.x*sim->level_dim.y*sim->level_dim.z * 2; buffer_index += 2)
     {
-        if (world_state.buffer[buffer_index] == TILE_TYPE_NONE) continue;
-        uint8 type = world_state.buffer[buffer_index];
-        uint8 direction = world_state.buffer[buffer_index + 1];
+        if (sim->world_state.buffer[buffer_index] == TILE_TYPE_NONE) continue;
+        uint8 type = sim->world_state.buffer[buffer_index];
+        uint8 direction = sim->world_state.buffer[buffer_index + 1];
         fwrite(&buffer_index, 4, 1, file);
         fwrite(&type, 1, 1, file);
         fwrite(&direction, 1, 1, file);
@@ -1464,7 +1842,7 @@ void writeWinBlockToFile(FILE* file, Entity* wb)
     fwrite(&wb->coords.y, 4, 1, file);
     fwrite(&wb->coords.z, 4, 1, file);
     char next_level[64] = {0};
-    memcpy(next_level, wb->next_level, 63);
+    memcpy(next_level, getEntityMetadata(wb)->next_level, 63);
     fwrite(next_level, 1, 64, file);
 }
 
@@ -1476,7 +1854,7 @@ void writeLockedInfoToFile(FILE* file, Entity* e)
     fwrite(&e->coords.y, 4, 1, file);
     fwrite(&e->coords.z, 4, 1, file);
     char unlocked_by[64] = {0};
-    memcpy(unlocked_by, e->unlocked_by, 63);
+    memcpy(unlocked_by, getEntityMetadata(e)->unlocked_by, 63);
     fwrite(unlocked_by, 1, 64, file);
 }
 
@@ -1512,8 +1890,8 @@ void writeBaseLevelInfo(char* folder_path)
 
     FOR(win_block_index, MAX_ENTITY_INSTANCE_COUNT)
     {
-        Entity* wb = &world_state.win_blocks[win_block_index];
-        if (wb->next_level[0] == '\0') continue;
+        Entity* wb = &sim->world_state.win_blocks[win_block_index];
+        if (getEntityMetadata(wb)->next_level[0] == '\0') continue;
         if (wb->removed) continue;
         writeWinBlockToFile(file, wb);
     }
@@ -1522,9 +1900,9 @@ void writeBaseLevelInfo(char* folder_path)
     {
         FOR(entity_index, MAX_ENTITY_INSTANCE_COUNT)
         {
-            Entity* e = &all_entity_groups[group_index][entity_index];
+            Entity* e = &sim->all_entity_groups[group_index][entity_index];
             if (e->removed) continue;
-            if (e->unlocked_by[0] == '\0') continue;
+            if (getEntityMetadata(e)->unlocked_by[0] == '\0') continue;
             writeLockedInfoToFile(file, e);
         }
     }
@@ -1535,7 +1913,7 @@ void writeBaseLevelInfo(char* folder_path)
 
 void loadWaterTexture(char* folder_path)
 {
-    water_paint_texture.dirty = true;
+    water_paint_texture.generation++;
 
     // default empty so a level with no texture file doesn't inherit from previous... shouldn't actually matter, i guess
     FOR(pixel, WATER_PAINT_MAX_SIDE * WATER_PAINT_MAX_SIDE) water_paint_texture.values[pixel] = (Rgba8){ 0, 0, 0, 0};
@@ -1545,8 +1923,8 @@ void loadWaterTexture(char* folder_path)
     FILE* file = fopen(texture_path, "rb");
     if (!file) return;
 
-    int32 texture_width  = level_dim.x * WATER_PAINT_RESOLUTION;
-    int32 texture_height = level_dim.z * WATER_PAINT_RESOLUTION;
+    int32 texture_width  = sim->level_dim.x * WATER_PAINT_RESOLUTION;
+    int32 texture_height = sim->level_dim.z * WATER_PAINT_RESOLUTION;
     if (texture_width  > WATER_PAINT_MAX_SIDE) texture_width  = WATER_PAINT_MAX_SIDE;
     if (texture_height > WATER_PAINT_MAX_SIDE) texture_height = WATER_PAINT_MAX_SIDE;
 
@@ -1576,8 +1954,8 @@ void writeWaterTexture(char folder_path[64])
         return;
     }
 
-    int32 texture_width  = level_dim.x * WATER_PAINT_RESOLUTION;
-    int32 texture_height = level_dim.z * WATER_PAINT_RESOLUTION;
+    int32 texture_width  = sim->level_dim.x * WATER_PAINT_RESOLUTION;
+    int32 texture_height = sim->level_dim.z * WATER_PAINT_RESOLUTION;
     if (texture_width  > WATER_PAINT_MAX_SIDE) texture_width  = WATER_PAINT_MAX_SIDE;
     if (texture_height > WATER_PAINT_MAX_SIDE) texture_height = WATER_PAINT_MAX_SIDE;
 
@@ -1721,6 +2099,46 @@ void drawAsset(SpriteId id, AssetType type, Vec3 coords, Vec3 scale, Vec4 rotati
     command->color = color;
     command->start_clip_plane = start_clip_plane;
     command->end_clip_plane = end_clip_plane;
+    command->interpolation_id = draw_interpolation_id;
+}
+
+// STATIC DRAW CACHE
+
+// draws for non-entity tiles only depend on the tile buffer, so they are built once and copied in until the buffer changes.
+// they always go at the very start of the draw list, which lets the renderer keep their instance data too (see RendererInfo).
+DrawCommand static_draw_commands[MAX_DRAW_COMMANDS] = {0};
+int32 static_draw_command_count = 0;
+SimContext* static_draw_context = 0; // which context's buffer the cache was built from
+uint32 static_draw_generation = 0; // ...and at which static_tile_generation
+uint32 static_draw_version = 0; // bumped on every rebuild. this is what the renderer compares against
+
+// call with an empty draw list
+void drawStaticTiles()
+{
+    if (static_draw_context == sim && static_draw_generation == sim->static_tile_generation)
+    {
+        memcpy(draw_commands, static_draw_commands, static_draw_command_count * sizeof(DrawCommand));
+        draw_command_count = static_draw_command_count;
+        return;
+    }
+
+    for (int tile_index = 0; tile_index < 2 * sim->level_dim.x*sim->level_dim.y*sim->level_dim.z; tile_index += 2)
+    {
+        TileType draw_tile = sim->world_state.buffer[tile_index];
+        if (draw_tile == TILE_TYPE_NONE || isEntity(draw_tile)) continue;
+        drawAsset(getCube3DId(draw_tile), CUBE_3D, vec3FromInt3(bufferIndexToCoords(tile_index)), DEFAULT_SCALE, composeRotation(sim->world_state.buffer[tile_index + 1], MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION), (Vec4){0}, (Vec4){0}, (Vec4){0});
+    }
+
+    // a different context can hold the same level, so only announce a new version on a real change, since the renderer rebuilds the level mesh from it
+    bool changed = draw_command_count != static_draw_command_count || memcmp(static_draw_commands, draw_commands, draw_command_count * sizeof(DrawCommand)) != 0;
+    if (changed)
+    {
+        memcpy(static_draw_commands, draw_commands, draw_command_count * sizeof(DrawCommand));
+        static_draw_command_count = draw_command_count;
+        static_draw_version++;
+    }
+    static_draw_context = sim;
+    static_draw_generation = sim->static_tile_generation;
 }
 
 // uses color.x as alpha channel.
@@ -1848,11 +2266,11 @@ RaycastHit raycastHitCube(Vec3 start, Vec3 direction, float max_distance)
 
 void editorPlaceOnlyInstanceOfTile(Entity* entity, Int3 coords, TileType tile, int32 id)
 {
-    for (int buffer_index = 0; buffer_index < 2 * level_dim.x*level_dim.y*level_dim.z; buffer_index += 2)
+    for (int buffer_index = 0; buffer_index < 2 * sim->level_dim.x*sim->level_dim.y*sim->level_dim.z; buffer_index += 2)
     {
-        if (world_state.buffer[buffer_index] != tile) continue;
-        world_state.buffer[buffer_index] = TILE_TYPE_NONE;
-        world_state.buffer[buffer_index + 1] = NORTH;
+        if (sim->world_state.buffer[buffer_index] != tile) continue;
+        setTileType(TILE_TYPE_NONE, bufferIndexToCoords(buffer_index));
+        setTileDirection(NORTH, bufferIndexToCoords(buffer_index), 0);
     }
     entity->coords = coords;
     entity->position = vec3FromInt3(coords);
@@ -1869,22 +2287,22 @@ void createTrailingHitbox(int32 id, Int3 coords, int32 frames)
     int32 hitbox_index = -1;
     FOR(find_hitbox_index, MAX_TRAILING_HITBOX_COUNT)
     {
-        if (temp_state.trailing_hitboxes[find_hitbox_index].frames != 0) continue;
+        if (sim->temp_state.trailing_hitboxes[find_hitbox_index].frames != 0) continue;
         hitbox_index = find_hitbox_index;
         break;
     }
     if (hitbox_index == -1) return;
-    temp_state.trailing_hitboxes[hitbox_index].id = id;
-    temp_state.trailing_hitboxes[hitbox_index].coords = coords;
-    temp_state.trailing_hitboxes[hitbox_index].frames = frames;
-    temp_state.trailing_hitboxes[hitbox_index].type = getTileTypeFromId(id);
+    sim->temp_state.trailing_hitboxes[hitbox_index].id = id;
+    sim->temp_state.trailing_hitboxes[hitbox_index].coords = coords;
+    sim->temp_state.trailing_hitboxes[hitbox_index].frames = frames;
+    sim->temp_state.trailing_hitboxes[hitbox_index].type = getTileTypeFromId(id);
 }
 
 bool trailingHitboxAtCoords(Int3 coords, TrailingHitbox* trailing_hitbox)
 {
     FOR(trailing_hitbox_index, MAX_TRAILING_HITBOX_COUNT) 
     {
-        TrailingHitbox th = temp_state.trailing_hitboxes[trailing_hitbox_index];
+        TrailingHitbox th = sim->temp_state.trailing_hitboxes[trailing_hitbox_index];
         if (int3IsEqual(coords, th.coords) && th.frames > 0) 
         {
             *trailing_hitbox = th;
@@ -1894,6 +2312,19 @@ bool trailingHitboxAtCoords(Int3 coords, TrailingHitbox* trailing_hitbox)
     return false;
 }
 
+// canFall only trusts a trailing hitbox while its owner isn't falling, so whatever rests on the owner's hitboxes can lose (or gain) its
+// support here without any tile changing. those columns are marked so the falling pass doesn't skip them
+void setEntityFalling(Entity* e, bool falling)
+{
+    if (e->falling == falling) return;
+    e->falling = falling;
+    FOR(th_index, MAX_TRAILING_HITBOX_COUNT)
+    {
+        TrailingHitbox* th = &sim->temp_state.trailing_hitboxes[th_index];
+        if (th->frames > 0 && th->id == e->id) markColumnChanged(th->coords);
+    }
+}
+
 // VECTOR POSITION HELPERS
 
 float getFloatAlongDirection(Direction direction, Vec3 vector)
@@ -1969,7 +2400,9 @@ float getDistanceAlongAxis(Direction direction, Vec3 axis_position, Vec3 entity_
 bool canPush(Int3 coords, Direction direction)
 {
     Int3 current_coords = coords;
-    TileType current_tile = getTileType(current_coords);
+    int32 current_index = coordsToPaddedIndex(coords);
+    int32 stride = sim->padded_direction_stride[direction];
+    TileType current_tile = sim->padded_tiles[current_index];
     FOR(push_index, MAX_ENTITY_PUSH_COUNT)
     {
         Entity* e = getEntityAtCoords(current_coords);
@@ -1978,13 +2411,12 @@ bool canPush(Int3 coords, Direction direction)
         if (e->falling) return false;
 
         // if will fall, don't allow push.
-        Int3 coords_below = getNextCoords(current_coords, DOWN);
-        TileType type_below = getTileType(coords_below);
-        if (type_below == TILE_TYPE_NONE && temp_state.blue_gameplay_timer == 0) return false;
+        TileType type_below = sim->padded_tiles[current_index + sim->padded_direction_stride[DOWN]];
+        if (type_below == TILE_TYPE_NONE && sim->temp_state.blue_gameplay_timer == 0) return false;
 
-        // check within bounds
+        // step forward. leaving the level lands on the wall border, which fails below
         current_coords = getNextCoords(current_coords, direction);
-        if (!intCoordsWithinLevelBounds(current_coords)) return false;
+        current_index += stride;
 
         /*
         // NOTE: this causes edge case in climb up-down-up, go forward, and then try go back again, within trailing hitbox time, when at least 2 tiles are on the players head.
@@ -1993,7 +2425,7 @@ bool canPush(Int3 coords, Direction direction)
         if (trailingHitboxAtCoords(current_coords, &th) && th.id != e->id) return false;
         */
 
-        current_tile = getTileType(current_coords);
+        current_tile = sim->padded_tiles[current_index];
         if (current_tile == TILE_TYPE_NONE) return true;
         if (current_tile == TILE_TYPE_GRID || current_tile == TILE_TYPE_WALL || current_tile == TILE_TYPE_LADDER ) return false;
     }
@@ -2013,26 +2445,31 @@ bool canPushVertical(Int3 coords, Direction direction)
 // assumes at least the bottom of the stack is able to be pushed 
 void pushAll(Int3 coords, Direction direction, MoveType move_type, bool push_stacks)
 {
+    int32 stride = sim->padded_direction_stride[direction];
     Int3 current_coords = coords;
+    int32 current_index = coordsToPaddedIndex(coords);
     int32 push_count = 0;
     FOR(push_index, MAX_ENTITY_PUSH_COUNT)
     {
-        if (getTileType(current_coords) == TILE_TYPE_NONE) break;
+        if (sim->padded_tiles[current_index] == TILE_TYPE_NONE) break;
         current_coords = getNextCoords(current_coords, direction);
+        current_index += stride;
         push_count++;
     }
     current_coords = getNextCoords(current_coords, oppositeDirection(direction));
+    current_index -= stride;
 
     for (int32 inverse_push_index = push_count; inverse_push_index != 0; inverse_push_index--)
     {
         int32 stack_size = 1;
         if (push_stacks) stack_size = getPushableStackSize(current_coords, UP);
         Int3 current_stack_coords = current_coords;
+        int32 current_stack_index = current_index;
         FOR(stack_index, stack_size)
         {
             Entity* e = getEntityAtCoords(current_stack_coords);
             Int3 next_coords = getNextCoords(e->coords, direction);
-            TileType next_type = getTileType(next_coords);
+            TileType next_type = sim->padded_tiles[current_stack_index + stride];
 
             if (next_type != TILE_TYPE_NONE) break; // this is possible because of the inverse push index seeking. if not none, won't be pushable either, so break.
 
@@ -2041,10 +2478,13 @@ void pushAll(Int3 coords, Direction direction, MoveType move_type, bool push_sta
 
             e->moving_direction = direction;
             e->move_type = move_type;
+            wakeEntity(e);
 
             current_stack_coords = getNextCoords(current_stack_coords, UP);
+            current_stack_index += sim->padded_direction_stride[UP];
         }
         current_coords = getNextCoords(current_coords, oppositeDirection(direction));
+        current_index -= stride;
     }
 }
 
@@ -2066,6 +2506,7 @@ void pushVertical(Int3 coords, Direction direction)
 
         e->moving_direction = direction;
         e->move_type = MOVE_TYPE_FOLLOW_VERTICAL;
+        wakeEntity(e);
 
         current_coords = getNextCoords(current_coords, oppositeDirection(direction));
     }
@@ -2073,33 +2514,33 @@ void pushVertical(Int3 coords, Direction direction)
 
 void updatePackAttached()
 {
-    TileType tile_behind_player = getTileType(getNextCoords(world_state.player.coords, oppositeDirection(world_state.player.direction)));
-    bool direction_agree = pack->direction == player->direction;
+    TileType tile_behind_player = getTileType(getNextCoords(sim->world_state.player.coords, oppositeDirection(sim->world_state.player.direction)));
+    bool direction_agree = sim->pack->direction == sim->player->direction;
 
     if (tile_behind_player == TILE_TYPE_PACK && direction_agree)
     {
-        if (!temp_state.pack_attached && (player->moving_direction == UP || player->falling))
+        if (!sim->temp_state.pack_attached && (sim->player->moving_direction == UP || sim->player->falling))
         {
             // vertical movement of player causing pack attach. in this case, will never have hit correct coords yet;
             // instead, this is handled in the climbing case, where there is a clear "transition to next tile" block.
-            temp_state.pack_attached = false;
+            sim->temp_state.pack_attached = false;
         }
-        else if (pack->falling)
+        else if (sim->pack->falling)
         {
             // if pack still falling, pack is still in air, so should not attach. 
             // player is not moving vertically, so will be no problem with opposite movement causing miss.
-            temp_state.pack_attached = false;
+            sim->temp_state.pack_attached = false;
         }
         else
         {
             // no vertical movement, so player turned such that pack is behind, or pack has fallen behind player and settled. 
             // set attached to true and let later code handle correct pack movement
-            temp_state.pack_attached = true;
+            sim->temp_state.pack_attached = true;
         }
     }
-    else if (temp_state.pack_turn_state.pack_intermediate_states_timer == 0)
+    else if (sim->temp_state.pack_turn_state.pack_intermediate_states_timer == 0)
     {
-        temp_state.pack_attached = false;
+        sim->temp_state.pack_attached = false;
     }
 }
 
@@ -2114,15 +2555,15 @@ Vec3 getNormCoordsWithEntityCoordAlongAxis(Direction direction, Vec3 current_nor
 
 void updateLaserBuffer()
 {
-    FOR(laser_index, MAX_SOURCE_COUNT * MAX_LASER_TURNS_ALLOWED) temp_state.laser_buffer[laser_index].color = COLOR_NONE;
-    temp_state.player_hit_by_red = false;
+    FOR(laser_index, MAX_SOURCE_COUNT * MAX_LASER_TURNS_ALLOWED) sim->temp_state.laser_buffer[laser_index].color = COLOR_NONE;
+    sim->temp_state.player_hit_by_red = false;
 
     // if a source is magenta, create entry in sources as primary of it as both red and blue
     Entity sources_as_primary[256] = {0};
     int32 primary_index = 0;
     FOR(source_index, MAX_ENTITY_INSTANCE_COUNT)
     {
-        Entity* s = &world_state.sources[source_index];
+        Entity* s = &sim->world_state.sources[source_index];
         if (s->removed || s->locked) continue;
         if (s->color < COLOR_MAGENTA)
         {
@@ -2143,6 +2584,7 @@ void updateLaserBuffer()
 
     FOR(source_index, MAX_SOURCE_COUNT) // iterate over laser (primary) sources
     {
+        if (source_index >= primary_index) break; // rest are empty, and would start marching from wherever (0, 0, 0) is
         Entity* source = &sources_as_primary[source_index];
 
         Direction current_direction = source->direction;
@@ -2158,7 +2600,7 @@ void updateLaserBuffer()
         {
             bool no_more_turns = true;
 
-            LaserBuffer* lb = &temp_state.laser_buffer[source_index * MAX_LASER_TURNS_ALLOWED + laser_turn_index];
+            LaserBuffer* lb = &sim->temp_state.laser_buffer[source_index * MAX_LASER_TURNS_ALLOWED + laser_turn_index];
 
             // start of some segment: always move one tile forward from where we are before we start checking for anything
             float laser_source_start_offset = 0.4f;
@@ -2166,12 +2608,14 @@ void updateLaserBuffer()
             else lb->start_coords = current_norm_coords;
             lb->direction = current_direction;
             lb->color = source->color;
-            if (laser_turn_index > 0) lb->start_clip_plane = temp_state.laser_buffer[source_index * MAX_LASER_TURNS_ALLOWED + laser_turn_index - 1].end_clip_plane;
+            if (laser_turn_index > 0) lb->start_clip_plane = sim->temp_state.laser_buffer[source_index * MAX_LASER_TURNS_ALLOWED + laser_turn_index - 1].end_clip_plane;
             else lb->start_clip_plane = (Vec4){ 0, 0, 0, 1 };
             lb->end_clip_plane = (Vec4){ 0, 0, 0, 1 };
 
             current_norm_coords = vec3Add(directionToVector(current_direction), current_norm_coords);
             current_tile_coords = int3FromVec3(current_norm_coords);
+            int32 current_tile_index = coordsToPaddedIndex(current_tile_coords); // segments start one tile from something inside the level, so at worst on the border
+            int32 stride = sim->padded_direction_stride[current_direction];
 
             FOR(laser_tile_index, MAX_LASER_TRAVEL_DISTANCE) // iterate over individual tiles
             {
@@ -2188,14 +2632,15 @@ void updateLaserBuffer()
                 if (id_to_skip_timer > 0) id_to_skip_timer--;
                 else id_to_skip = 0;
 
-                // stop if oob, and extend the laser for a bit
-                if (!intCoordsWithinLevelBounds(current_tile_coords))
+                // stop if oob, and extend the laser for a bit. the border reads as wall, so only walls need the real bounds check
+                TileType tile_type = sim->padded_tiles[current_tile_index];
+                if (tile_type == TILE_TYPE_WALL && !intCoordsWithinLevelBounds(current_tile_coords))
                 {
                     lb->end_coords = vec3Add(vec3ScalarMultiply(directionToVector(current_direction), 40.0f), current_norm_coords);
                     break;
                 }
 
-                TileType types_to_check[2] = { TILE_TYPE_NONE, getTileType(current_tile_coords) }; // trailing hitbox, followed by real type; trailing hitbox intersection takes priority
+                TileType types_to_check[2] = { TILE_TYPE_NONE, tile_type }; // trailing hitbox, followed by real type; trailing hitbox intersection takes priority
                 TrailingHitbox th = {0};                                                 // but normal collision will still be checked if the trailing hitbox exists but doesn't hit
                 if (trailingHitboxAtCoords(current_tile_coords, &th) && th.frames > 0)
                 {
@@ -2210,20 +2655,20 @@ void updateLaserBuffer()
 
                     if (hit_type == TILE_TYPE_PLAYER)
                     {
-                        float distance_from_player = getDistanceAlongAxis(current_direction, current_norm_coords, player->position);
+                        float distance_from_player = getDistanceAlongAxis(current_direction, current_norm_coords, sim->player->position);
                         if (distance_from_player > 0.5f)
                         {
                             // passthrough
                             continue;
                         }
 
-                        Vec3 coords_without_offset = getNormCoordsWithEntityCoordAlongAxis(current_direction, current_norm_coords, player->position);
+                        Vec3 coords_without_offset = getNormCoordsWithEntityCoordAlongAxis(current_direction, current_norm_coords, sim->player->position);
                         lb->end_coords = vec3Add(coords_without_offset, vec3ScalarMultiply(directionToVector(current_direction), -0.375f));
-                        current_norm_coords = player->position;
+                        current_norm_coords = sim->player->position;
 
                         // set player color
-                        if (source->color == COLOR_RED)  temp_state.player_hit_by_red = true;
-                        if (source->color == COLOR_BLUE) temp_state.blue_gameplay_timer = MAX_BLUE_GAMEPLAY_TIME;
+                        if (source->color == COLOR_RED)  sim->temp_state.player_hit_by_red = true;
+                        if (source->color == COLOR_BLUE) sim->temp_state.blue_gameplay_timer = MAX_BLUE_GAMEPLAY_TIME;
 
                         advance_tile = false;
                         break;
@@ -2413,7 +2858,8 @@ void updateLaserBuffer()
                 if (advance_tile)
                 {
                     current_norm_coords = vec3Add(directionToVector(current_direction), current_norm_coords);
-                    current_tile_coords = int3FromVec3(current_norm_coords);
+                    current_tile_coords = getNextCoords(current_tile_coords, current_direction);
+                    current_tile_index += stride;
                 }
                 else break;
             }
@@ -2425,8 +2871,8 @@ void updateLaserBuffer()
 
     if (cheating)
     {
-        temp_state.blue_gameplay_timer = MAX_BLUE_GAMEPLAY_TIME;
-        temp_state.player_hit_by_red = true;
+        sim->temp_state.blue_gameplay_timer = MAX_BLUE_GAMEPLAY_TIME;
+        sim->temp_state.player_hit_by_red = true;
     }
 }
 
@@ -2438,16 +2884,16 @@ void updateLockedTiles(bool do_unlocks)
     {
         FOR(entity_index, MAX_ENTITY_INSTANCE_COUNT)
         {
-            Entity* e = &lockable_entity_groups[group_index][entity_index];
-            if (findInSolvedLevels(e->unlocked_by) == -1) e->locked = true; 
+            Entity* e = &sim->lockable_entity_groups[group_index][entity_index];
+            if (findInSolvedLevels(getEntityMetadata(e)->unlocked_by) == -1) e->locked = true; 
             else e->locked = false;
         }
     }
     FOR(locked_block_index, MAX_ENTITY_INSTANCE_COUNT)
     {
-        Entity* lb = &world_state.locked_blocks[locked_block_index];
+        Entity* lb = &sim->world_state.locked_blocks[locked_block_index];
         if (!lb->in_use) continue;
-        int32 find_result = findInSolvedLevels(lb->unlocked_by);
+        int32 find_result = findInSolvedLevels(getEntityMetadata(lb)->unlocked_by);
         if (find_result == INT32_MAX) continue;
         if (find_result != -1 && !lb->removed)
         {
@@ -2457,6 +2903,7 @@ void updateLockedTiles(bool do_unlocks)
             {
                 setTileType(TILE_TYPE_NONE, lb->coords);
                 setTileDirection(NORTH, lb->coords, 0);
+                wakeEntitiesAroundTile(lb->coords);
             }
             if (!do_unlocks) createDebugPopup("something was unlocked!", POPUP_TYPE_NONE);
         }
@@ -2476,15 +2923,17 @@ void clearMovementState(Entity* e)
     e->position = vec3FromInt3(e->coords);
     e->displacement = (Vec3){0};
     e->yaw_offset = 0.0f;
-    e->tilt_angle = 0.0f;
-    e->visual_tilt = IDENTITY_QUATERNION;
     e->rotation = composeRotation(e->direction, e->mirror_orientation, 0.0f, IDENTITY_QUATERNION);
     e->velocity = (Vec3){0};
-    e->settle_timer = 0;
-    e->settle_velocity = (Vec3){0};
-    e->settle_do_extra_push = false;
+
+    EntityVisuals* visuals = getEntityVisuals(e);
+    visuals->tilt_angle = 0.0f;
+    visuals->visual_tilt = IDENTITY_QUATERNION;
+    visuals->settle_timer = 0;
+    visuals->settle_velocity = (Vec3){0};
+    visuals->settle_do_extra_push = false;
     e->moving_direction = NO_DIRECTION;
-    e->falling = false;
+    setEntityFalling(e, false);
     e->move_type = MOVE_TYPE_NONE;
 }
 
@@ -2494,12 +2943,12 @@ void clearAllMovementState()
     {
         FOR(entity_index, MAX_ENTITY_INSTANCE_COUNT)
         {
-            Entity* e = &interactible_entity_groups[group_index][entity_index];
+            Entity* e = &sim->interactible_entity_groups[group_index][entity_index];
             clearMovementState(e);
         }
     }
-    clearMovementState(player);
-    clearMovementState(pack);
+    clearMovementState(sim->player);
+    clearMovementState(sim->pack);
 }
 
 // TEXT INPUT
@@ -2524,8 +2973,8 @@ void updateTextInput(Input *input)
 
 void initUndoBuffer()
 {
-    memset(&undo_buffer, 0, sizeof(UndoBuffer));
-    memset(undo_buffer.level_change_indices, 0xFF, sizeof(undo_buffer.level_change_indices));
+    memset(&sim->undo_buffer, 0, sizeof(UndoBuffer));
+    memset(sim->undo_buffer.level_change_indices, 0xFF, sizeof(sim->undo_buffer.level_change_indices));
 }
 
 // TODO:
@@ -2563,29 +3012,34 @@ void loadUndoBufferFromFile()
 
 void initializeLevel(char* level_name)
 {
-    if (level_name == 0) strcpy(world_state.level_name, DEBUG_LEVEL_NAME);
-    else strcpy(world_state.level_name, level_name);
+    continuity_generation++;
+    turbo_resolve_pending = false;
 
-    memset(world_state.boxes, 0, sizeof(world_state.boxes) * ENTITY_TYPES + sizeof(world_state.buffer)); 
-    memset(&temp_state, 0, sizeof(TemporaryState));
+    if (level_name == 0) strcpy(sim->world_state.level_name, DEBUG_LEVEL_NAME);
+    else strcpy(sim->world_state.level_name, level_name);
+
+    memset(sim->world_state.boxes, 0, sizeof(sim->world_state.boxes) * ENTITY_TYPES + sizeof(sim->world_state.buffer)); 
+    memset(sim->entity_visuals, 0, sizeof(sim->entity_visuals));
+    memset(sim->entity_metadata, 0, sizeof(sim->entity_metadata));
+    memset(&sim->temp_state, 0, sizeof(TemporaryState));
     memset(&visual_effects, 0, sizeof(VisualEffects));
-    clearMovementState(player);
-    clearMovementState(pack);
+    clearMovementState(sim->player);
+    clearMovementState(sim->pack);
 
-    if (strcmp(world_state.level_name, "overworld") == 0) in_overworld = true;
+    if (strcmp(sim->world_state.level_name, "overworld") == 0) in_overworld = true;
     else in_overworld = false;
 
     // level_name to folder_path to level_path, use to build buffer
     char folder_path[64];
     char level_path[64];
-    buildLevelFolderPath(&folder_path, world_state.level_name, false);
+    buildLevelFolderPath(&folder_path, sim->world_state.level_name, false);
     snprintf(level_path, sizeof(level_path), "%s/%s", folder_path, LEVEL_BASE_FILE_NAME);
     FILE* file = fopen(level_path, "rb+");
 
     if (file == NULL)
     {
         // write empty file to main folder
-        buildLevelFolderPath(&folder_path, world_state.level_name, true);
+        buildLevelFolderPath(&folder_path, sim->world_state.level_name, true);
         snprintf(level_path, sizeof(level_path), "%s/%s", folder_path, LEVEL_BASE_FILE_NAME);
         _mkdir(folder_path); // NOTE: windows only (hence the _...)
 
@@ -2593,7 +3047,7 @@ void initializeLevel(char* level_name)
         fclose(file);
 
         // write copied file to build folder
-        buildLevelFolderPath(&folder_path, world_state.level_name, false);
+        buildLevelFolderPath(&folder_path, sim->world_state.level_name, false);
         snprintf(level_path, sizeof(level_path), "%s/%s", folder_path, LEVEL_BASE_FILE_NAME);
         _mkdir(folder_path);
 
@@ -2617,14 +3071,14 @@ void initializeLevel(char* level_name)
 
     // rebuild entity array
     Entity* entity_group = 0;
-    for (int buffer_index = 0; buffer_index < 2 * level_dim.x*level_dim.y*level_dim.z; buffer_index += 2)
+    for (int buffer_index = 0; buffer_index < 2 * sim->level_dim.x*sim->level_dim.y*sim->level_dim.z; buffer_index += 2)
     {
-        TileType buffer_contents = world_state.buffer[buffer_index];
-        if      (buffer_contents == TILE_TYPE_BOX)          entity_group = world_state.boxes;
-        else if (buffer_contents == TILE_TYPE_MIRROR)       entity_group = world_state.mirrors;
-        else if (buffer_contents == TILE_TYPE_WIN_BLOCK)    entity_group = world_state.win_blocks;
-        else if (buffer_contents == TILE_TYPE_LOCKED_BLOCK) entity_group = world_state.locked_blocks;
-        else if (isSource(buffer_contents))                 entity_group = world_state.sources;
+        TileType buffer_contents = sim->world_state.buffer[buffer_index];
+        if      (buffer_contents == TILE_TYPE_BOX)          entity_group = sim->world_state.boxes;
+        else if (buffer_contents == TILE_TYPE_MIRROR)       entity_group = sim->world_state.mirrors;
+        else if (buffer_contents == TILE_TYPE_WIN_BLOCK)    entity_group = sim->world_state.win_blocks;
+        else if (buffer_contents == TILE_TYPE_LOCKED_BLOCK) entity_group = sim->world_state.locked_blocks;
+        else if (isSource(buffer_contents))                 entity_group = sim->world_state.sources;
 
         if (entity_group != 0)
         {
@@ -2635,16 +3089,16 @@ void initializeLevel(char* level_name)
             e->coords = bufferIndexToCoords(buffer_index);
             e->position = vec3FromInt3(e->coords);
             e->yaw_offset = 0.0f;
-            e->visual_tilt = IDENTITY_QUATERNION;
-            if (entity_group == world_state.mirrors)
+            getEntityVisuals(e)->visual_tilt = IDENTITY_QUATERNION;
+            if (entity_group == sim->world_state.mirrors)
             {
-                e->direction = world_state.buffer[buffer_index + 1] % 8;
-                e->mirror_orientation = world_state.buffer[buffer_index + 1] / 8;
+                e->direction = sim->world_state.buffer[buffer_index + 1] % 8;
+                e->mirror_orientation = sim->world_state.buffer[buffer_index + 1] / 8;
                 e->rotation = composeRotation(e->direction, e->mirror_orientation, 0.0f, IDENTITY_QUATERNION);
             }
             else
             {
-                e->direction = world_state.buffer[buffer_index + 1];
+                e->direction = sim->world_state.buffer[buffer_index + 1];
                 e->mirror_orientation = 0;
                 e->rotation = composeRotation(e->direction, e->mirror_orientation, 0.0f, IDENTITY_QUATERNION);
             }
@@ -2655,29 +3109,29 @@ void initializeLevel(char* level_name)
             e->in_use = true;
             entity_group = 0;
         }
-        else if (world_state.buffer[buffer_index] == TILE_TYPE_PLAYER)
+        else if (sim->world_state.buffer[buffer_index] == TILE_TYPE_PLAYER)
         {
-            player->coords = bufferIndexToCoords(buffer_index);
-            player->position = vec3FromInt3(player->coords);
-            player->direction = world_state.buffer[buffer_index + 1];
-            player->yaw_offset = 0.0f;
-            player->visual_tilt = IDENTITY_QUATERNION;
-            player->rotation = composeRotation(player->direction, MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION);
-            player->moving_direction = NO_DIRECTION;
-            player->id = PLAYER_ID;
-            player->in_use = true;
+            sim->player->coords = bufferIndexToCoords(buffer_index);
+            sim->player->position = vec3FromInt3(sim->player->coords);
+            sim->player->direction = sim->world_state.buffer[buffer_index + 1];
+            sim->player->yaw_offset = 0.0f;
+            getEntityVisuals(sim->player)->visual_tilt = IDENTITY_QUATERNION;
+            sim->player->rotation = composeRotation(sim->player->direction, MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION);
+            sim->player->moving_direction = NO_DIRECTION;
+            sim->player->id = PLAYER_ID;
+            sim->player->in_use = true;
         }
-        else if (world_state.buffer[buffer_index] == TILE_TYPE_PACK)
+        else if (sim->world_state.buffer[buffer_index] == TILE_TYPE_PACK)
         {
-            pack->coords = bufferIndexToCoords(buffer_index);
-            pack->position = vec3FromInt3(pack->coords);
-            pack->direction = world_state.buffer[buffer_index + 1];
-            pack->yaw_offset = 0.0f;
-            pack->visual_tilt = IDENTITY_QUATERNION;
-            pack->rotation = composeRotation(pack->direction, MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION);
-            pack->moving_direction = NO_DIRECTION;
-            pack->id = PACK_ID;
-            pack->in_use = true;
+            sim->pack->coords = bufferIndexToCoords(buffer_index);
+            sim->pack->position = vec3FromInt3(sim->pack->coords);
+            sim->pack->direction = sim->world_state.buffer[buffer_index + 1];
+            sim->pack->yaw_offset = 0.0f;
+            getEntityVisuals(sim->pack)->visual_tilt = IDENTITY_QUATERNION;
+            sim->pack->rotation = composeRotation(sim->pack->direction, MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION);
+            sim->pack->moving_direction = NO_DIRECTION;
+            sim->pack->id = PACK_ID;
+            sim->pack->in_use = true;
         }
     }
 
@@ -2714,9 +3168,10 @@ void initializeLevel(char* level_name)
     camera_screen_offset.x = (int32)(camera.coords.x / OVERWORLD_SCREEN_SIZE_X);
     camera_screen_offset.z = (int32)(camera.coords.z / OVERWORLD_SCREEN_SIZE_Z);
     camera.rotation = buildCameraQuaternion(camera);
-    camera_target_plane = player->coords.y;
-    if (in_overworld) ow_player_coords_for_offset = player->coords;
+    camera_target_plane = sim->player->coords.y;
+    if (in_overworld) ow_player_coords_for_offset = sim->player->coords;
 
+    wakeAllEntities();
     updateLaserBuffer();
     updateLockedTiles(true);
     updatePackAttached();
@@ -2732,12 +3187,14 @@ void gameInitialize(char* level_name, DisplayInfo display_from_platform)
 {   
     game_display = display_from_platform;
     recalculateTextStartCoords();
+    initializeSimContext(&default_sim_context);
 
     initUndoBuffer();
 
     // read overworld zero's world state from file on startup, so it's kept in memory. this is used on restart in the overworld.
     initializeLevel(OVERWORLD_ZERO_NAME);
-    memcpy(&overworld_zero_state, &world_state, sizeof(WorldState));
+    memcpy(&overworld_zero_state, &sim->world_state, sizeof(WorldState));
+    memcpy(overworld_zero_metadata, sim->entity_metadata, sizeof(sim->entity_metadata));
 
     initializeLevel(level_name);
 
@@ -2748,23 +3205,105 @@ RendererInfo getRendererInfo()
 {
     RendererInfo info = {0};
     info.camera = camera_with_ow_offset;
-    info.level_aabb_min = (Vec3){ level_origin.x - 0.5f, level_origin.y - 0.5f, level_origin.z - 0.5f };
-    info.level_aabb_max = (Vec3){ level_origin.x + level_dim.x - 0.5f, level_origin.y + level_dim.y - 0.5f, level_origin.z + level_dim.z - 0.5f };
+    info.level_aabb_min = (Vec3){ sim->level_origin.x - 0.5f, sim->level_origin.y - 0.5f, sim->level_origin.z - 0.5f };
+    info.level_aabb_max = (Vec3){ sim->level_origin.x + sim->level_dim.x - 0.5f, sim->level_origin.y + sim->level_dim.y - 0.5f, sim->level_origin.z + sim->level_dim.z - 0.5f };
     info.time = (float)global_time;
     info.water_plane_y = water_plane_y;
     info.shader_mode = game_shader_mode;
+    info.water_mode = game_water_mode;
     info.water_paint_texture = &water_paint_texture;
     info.sun_direction = sun_direction;
+    info.static_draw_command_count = static_draw_command_count;
+    info.static_draw_version = static_draw_version;
+    info.continuity_generation = continuity_generation;
     return info;
 }
 
+// the render thread keeps presenting the last snapshot while the window is being resized, so this only needs to update layout for the next frame
 void gameRedraw(DisplayInfo display_from_platform)
 {
-    if (draw_command_count == 0) return;
     game_display = display_from_platform;
     recalculateTextStartCoords();
-    vulkanSubmitFrame(draw_commands, draw_command_count, getRendererInfo());
-    vulkanDraw(false);
+}
+
+Vec4 vec4Lerp(Vec4 a, Vec4 b, float t)
+{
+    return (Vec4){ a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t };
+}
+
+// builds the draw list for a point t (0..1) between two published snapshots. the scene's entity and laser draws are matched to the
+// snapshots' transforms by interpolation id and blended, so lasers stay attached to the entities emitting and reflecting them;
+// everything else (static tiles, text) is drawn from the scene as is. across an undo, restart or level load nothing is blended.
+// reads only the snapshots and the scene, never sim state.
+int32 gameInterpolateSnapshots(RenderSnapshot* previous, RenderSnapshot* latest, RenderScene* scene, float t, DrawCommand* out_draw_commands, RendererInfo* out_renderer_info)
+{
+    // the scene can be a tick ahead of the snapshots. one from after an undo or level load is drawn as published
+    if (scene->renderer_info.continuity_generation != latest->continuity_generation) latest = 0;
+    if (previous && (!latest || previous->continuity_generation != latest->continuity_generation)) previous = 0;
+
+    static int32 latest_transform_index[INTERPOLATION_ID_COUNT]; // by interpolation id. only touched by the render thread
+    static int32 previous_transform_index[INTERPOLATION_ID_COUNT];
+    FOR(id, INTERPOLATION_ID_COUNT)
+    {
+        latest_transform_index[id] = -1;
+        previous_transform_index[id] = -1;
+    }
+    if (latest) FOR(transform_index, latest->transform_count)
+    {
+        int32 id = latest->transforms[transform_index].interpolation_id;
+        if (id > 0 && id < INTERPOLATION_ID_COUNT) latest_transform_index[id] = transform_index;
+    }
+    if (previous) FOR(transform_index, previous->transform_count)
+    {
+        int32 id = previous->transforms[transform_index].interpolation_id;
+        if (id > 0 && id < INTERPOLATION_ID_COUNT) previous_transform_index[id] = transform_index;
+    }
+
+    memcpy(out_draw_commands, scene->draw_commands, scene->draw_command_count * sizeof(DrawCommand));
+    FOR(command_index, scene->draw_command_count)
+    {
+        DrawCommand* command = &out_draw_commands[command_index];
+        int32 id = command->interpolation_id;
+        if (id <= 0 || id >= INTERPOLATION_ID_COUNT || latest_transform_index[id] < 0) continue;
+
+        InterpolatedTransform* to = &latest->transforms[latest_transform_index[id]];
+        command->coords = to->coords;
+        command->scale = to->scale;
+        command->rotation = to->rotation;
+        command->start_clip_plane = to->start_clip_plane;
+        command->end_clip_plane = to->end_clip_plane;
+        if (previous_transform_index[id] < 0) continue;
+
+        InterpolatedTransform* from = &previous->transforms[previous_transform_index[id]];
+        if (id >= LASER_INTERPOLATION_ID_BASE)
+        {
+            // a laser segment stretches and slides along its own axis. one that changed direction is drawn where it ends up
+            if (!vec4IsEqual(from->rotation, to->rotation)) continue;
+            command->coords = vec3Add(from->coords, vec3ScalarMultiply(vec3Subtract(to->coords, from->coords), t));
+            command->scale = vec3Add(from->scale, vec3ScalarMultiply(vec3Subtract(to->scale, from->scale), t));
+            command->start_clip_plane = vec4Lerp(from->start_clip_plane, to->start_clip_plane, t);
+            command->end_clip_plane = vec4Lerp(from->end_clip_plane, to->end_clip_plane, t);
+            continue;
+        }
+
+        command->coords = vec3Add(from->coords, vec3ScalarMultiply(vec3Subtract(to->coords, from->coords), t));
+        command->rotation = quaternionNlerp(from->rotation, to->rotation, t);
+    }
+
+    *out_renderer_info = scene->renderer_info;
+    if (latest)
+    {
+        out_renderer_info->camera = latest->camera;
+        out_renderer_info->time = latest->time;
+    }
+    if (previous)
+    {
+        Camera* camera_out = &out_renderer_info->camera;
+        camera_out->coords = vec3Add(previous->camera.coords, vec3ScalarMultiply(vec3Subtract(camera_out->coords, previous->camera.coords), t));
+        camera_out->rotation = quaternionNlerp(previous->camera.rotation, camera_out->rotation, t);
+        out_renderer_info->time = previous->time + (out_renderer_info->time - previous->time) * t;
+    }
+    return scene->draw_command_count;
 }
 
 // UNDO / RESTART
@@ -2781,43 +3320,43 @@ void gameRedraw(DisplayInfo display_from_platform)
 // writes one delta into the circular buffer
 void recordEntityDelta(Entity* e)
 {
-    uint32 pos = undo_buffer.delta_write_pos;
-    undo_buffer.deltas[pos].id = e->id;
-    undo_buffer.deltas[pos].old_coords = e->coords;
-    undo_buffer.deltas[pos].old_direction = e->direction;
-    undo_buffer.deltas[pos].old_mirror_orientation = e->mirror_orientation;
-    undo_buffer.deltas[pos].was_removed = e->removed;
-    undo_buffer.delta_write_pos = (pos + 1) % MAX_UNDO_DELTAS;
-    undo_buffer.delta_count++;
+    uint32 pos = sim->undo_buffer.delta_write_pos;
+    sim->undo_buffer.deltas[pos].id = e->id;
+    sim->undo_buffer.deltas[pos].old_coords = e->coords;
+    sim->undo_buffer.deltas[pos].old_direction = e->direction;
+    sim->undo_buffer.deltas[pos].old_mirror_orientation = e->mirror_orientation;
+    sim->undo_buffer.deltas[pos].was_removed = e->removed;
+    sim->undo_buffer.delta_write_pos = (pos + 1) % MAX_UNDO_DELTAS;
+    sim->undo_buffer.delta_count++;
 }
 
 void evictOldestUndoAction()
 {
-    UndoActionHeader* oldest = &undo_buffer.headers[undo_buffer.oldest_action_index];
-    undo_buffer.delta_count -= oldest->entity_count;
+    UndoActionHeader* oldest = &sim->undo_buffer.headers[sim->undo_buffer.oldest_action_index];
+    sim->undo_buffer.delta_count -= oldest->entity_count;
     if (oldest->level_changed)
     {
-        uint8 level_change_index = undo_buffer.level_change_indices[undo_buffer.oldest_action_index];
+        uint8 level_change_index = sim->undo_buffer.level_change_indices[sim->undo_buffer.oldest_action_index];
         if (level_change_index != 0xFF)
         {
-            undo_buffer.level_change_count--;
+            sim->undo_buffer.level_change_count--;
         }
     }
-    undo_buffer.level_change_indices[undo_buffer.oldest_action_index] = 0xFF;
-    undo_buffer.oldest_action_index = (undo_buffer.oldest_action_index + 1) % MAX_UNDO_ACTIONS;
-    undo_buffer.header_count--;
+    sim->undo_buffer.level_change_indices[sim->undo_buffer.oldest_action_index] = 0xFF;
+    sim->undo_buffer.oldest_action_index = (sim->undo_buffer.oldest_action_index + 1) % MAX_UNDO_ACTIONS;
+    sim->undo_buffer.header_count--;
 }
 
 void popLastUndoAction()
 {
-    if (undo_buffer.header_count == 0) return;
+    if (sim->undo_buffer.header_count == 0) return;
 
-    uint32 header_index = (undo_buffer.header_write_pos + MAX_UNDO_ACTIONS - 1) % MAX_UNDO_ACTIONS;
-    UndoActionHeader* header = &undo_buffer.headers[header_index];
-    undo_buffer.delta_write_pos = header->delta_start_pos;
-    undo_buffer.delta_count -= header->entity_count;
-    undo_buffer.header_write_pos = header_index;
-    undo_buffer.header_count--;
+    uint32 header_index = (sim->undo_buffer.header_write_pos + MAX_UNDO_ACTIONS - 1) % MAX_UNDO_ACTIONS;
+    UndoActionHeader* header = &sim->undo_buffer.headers[header_index];
+    sim->undo_buffer.delta_write_pos = header->delta_start_pos;
+    sim->undo_buffer.delta_count -= header->entity_count;
+    sim->undo_buffer.header_write_pos = header_index;
+    sim->undo_buffer.header_count--;
 }
 
 // NOTE: this function used to take in action_was_reset and action_was_climb as bools. add back reset if want
@@ -2825,10 +3364,10 @@ void popLastUndoAction()
 //       see if still need later, if i decide to add back interpolations on undo.
 void recordActionForUndo(WorldState* old_state)
 {
-    if (undo_buffer.header_count >= MAX_UNDO_ACTIONS) evictOldestUndoAction();
+    if (sim->undo_buffer.header_count >= MAX_UNDO_ACTIONS) evictOldestUndoAction();
 
-    uint32 header_index = undo_buffer.header_write_pos;
-    uint32 delta_start = undo_buffer.delta_write_pos;
+    uint32 header_index = sim->undo_buffer.header_write_pos;
+    uint32 delta_start = sim->undo_buffer.delta_write_pos;
     uint32 entity_count = 0;
 
     recordEntityDelta(&old_state->player);
@@ -2848,12 +3387,12 @@ void recordActionForUndo(WorldState* old_state)
         }
     }
 
-    undo_buffer.headers[header_index].entity_count = (uint8)entity_count;
-    undo_buffer.headers[header_index].delta_start_pos = delta_start;
-    undo_buffer.headers[header_index].level_changed = false;
-    undo_buffer.level_change_indices[header_index] = 0xFF;
-    undo_buffer.header_write_pos = (header_index + 1) % MAX_UNDO_ACTIONS;
-    undo_buffer.header_count++;
+    sim->undo_buffer.headers[header_index].entity_count = (uint8)entity_count;
+    sim->undo_buffer.headers[header_index].delta_start_pos = delta_start;
+    sim->undo_buffer.headers[header_index].level_changed = false;
+    sim->undo_buffer.level_change_indices[header_index] = 0xFF;
+    sim->undo_buffer.header_write_pos = (header_index + 1) % MAX_UNDO_ACTIONS;
+    sim->undo_buffer.header_count++;
 
     restart_last_turn = false;
 
@@ -2863,48 +3402,48 @@ void recordActionForUndo(WorldState* old_state)
 // call before transitioning to a new level. stores a delta for every entity in the current level, plus the level change metadata
 void recordLevelChangeForUndo(char* current_level_name)
 {
-    if (undo_buffer.header_count >= MAX_UNDO_ACTIONS) evictOldestUndoAction();
+    if (sim->undo_buffer.header_count >= MAX_UNDO_ACTIONS) evictOldestUndoAction();
 
     // evict oldest level change if level_changes array is full
-    if (undo_buffer.level_change_count >= MAX_LEVEL_CHANGES)
+    if (sim->undo_buffer.level_change_count >= MAX_LEVEL_CHANGES)
     {
-        uint32 scan = undo_buffer.oldest_action_index;
-        for (uint32 header_index = 0; header_index < undo_buffer.header_count; header_index++)
+        uint32 scan = sim->undo_buffer.oldest_action_index;
+        for (uint32 header_index = 0; header_index < sim->undo_buffer.header_count; header_index++)
         {
             uint32 index = (scan + header_index) % MAX_UNDO_ACTIONS;
-            if (undo_buffer.headers[index].level_changed)
+            if (sim->undo_buffer.headers[index].level_changed)
             {
                 for(uint32 up_to_header = 0; up_to_header < header_index; up_to_header++)
                 {
                     uint32 evict_index = (scan + up_to_header) % MAX_UNDO_ACTIONS;
-                    undo_buffer.delta_count -= undo_buffer.headers[evict_index].entity_count;
-                    if (undo_buffer.headers[evict_index].level_changed)
+                    sim->undo_buffer.delta_count -= sim->undo_buffer.headers[evict_index].entity_count;
+                    if (sim->undo_buffer.headers[evict_index].level_changed)
                     {
-                        undo_buffer.level_change_count--;
+                        sim->undo_buffer.level_change_count--;
                     }
-                    undo_buffer.level_change_indices[evict_index] = 0xFF;
-                    undo_buffer.header_count--;
+                    sim->undo_buffer.level_change_indices[evict_index] = 0xFF;
+                    sim->undo_buffer.header_count--;
                 }
-                undo_buffer.oldest_action_index = (scan + header_index + 1) % MAX_UNDO_ACTIONS;
+                sim->undo_buffer.oldest_action_index = (scan + header_index + 1) % MAX_UNDO_ACTIONS;
                 break;
             }
         }
     }
 
-    uint32 header_index = undo_buffer.header_write_pos;
-    uint32 delta_start = undo_buffer.delta_write_pos;
+    uint32 header_index = sim->undo_buffer.header_write_pos;
+    uint32 delta_start = sim->undo_buffer.delta_write_pos;
     uint32 entity_count = 0;
 
     // store all entities
-    recordEntityDelta(&world_state.player);
-    recordEntityDelta(&world_state.pack);
+    recordEntityDelta(&sim->world_state.player);
+    recordEntityDelta(&sim->world_state.pack);
     entity_count += 2;
 
     FOR(group_index, 5)
     {
         FOR(entity_index, MAX_ENTITY_INSTANCE_COUNT)
         {
-            Entity* e = &all_entity_groups[group_index][entity_index];
+            Entity* e = &sim->all_entity_groups[group_index][entity_index];
             if (!e->in_use) continue;
             recordEntityDelta(e);
             entity_count++;
@@ -2912,19 +3451,19 @@ void recordLevelChangeForUndo(char* current_level_name)
     }
 
     // write level change info
-    uint32 level_change_index = undo_buffer.level_change_write_pos;
-    memset(undo_buffer.level_changes[level_change_index].from_level, 0, 64);
-    strcpy(undo_buffer.level_changes[level_change_index].from_level, current_level_name);
-    undo_buffer.level_change_write_pos = (level_change_index + 1) % MAX_LEVEL_CHANGES;
-    undo_buffer.level_change_count++;
+    uint32 level_change_index = sim->undo_buffer.level_change_write_pos;
+    memset(sim->undo_buffer.level_changes[level_change_index].from_level, 0, 64);
+    strcpy(sim->undo_buffer.level_changes[level_change_index].from_level, current_level_name);
+    sim->undo_buffer.level_change_write_pos = (level_change_index + 1) % MAX_LEVEL_CHANGES;
+    sim->undo_buffer.level_change_count++;
 
     // write header
-    undo_buffer.headers[header_index].entity_count = (uint8)entity_count;
-    undo_buffer.headers[header_index].delta_start_pos = delta_start;
-    undo_buffer.headers[header_index].level_changed = true;
-    undo_buffer.level_change_indices[header_index] = (uint8)level_change_index;
-    undo_buffer.header_write_pos = (header_index + 1) % MAX_UNDO_ACTIONS;
-    undo_buffer.header_count++;
+    sim->undo_buffer.headers[header_index].entity_count = (uint8)entity_count;
+    sim->undo_buffer.headers[header_index].delta_start_pos = delta_start;
+    sim->undo_buffer.headers[header_index].level_changed = true;
+    sim->undo_buffer.level_change_indices[header_index] = (uint8)level_change_index;
+    sim->undo_buffer.header_write_pos = (header_index + 1) % MAX_UNDO_ACTIONS;
+    sim->undo_buffer.header_count++;
 
     restart_last_turn = false;
 
@@ -2934,19 +3473,20 @@ void recordLevelChangeForUndo(char* current_level_name)
 // returns false only if already at oldest action
 bool performUndo()
 {
-    if (undo_buffer.header_count == 0) return false;
+    if (sim->undo_buffer.header_count == 0) return false;
 
+    continuity_generation++;
     clearAllMovementState();
-    memset(&temp_state, 0, sizeof(TemporaryState));
+    memset(&sim->temp_state, 0, sizeof(TemporaryState));
 
     // get most recent action header
-    uint32 header_index = (undo_buffer.header_write_pos + MAX_UNDO_ACTIONS - 1) % MAX_UNDO_ACTIONS;
-    UndoActionHeader* header = &undo_buffer.headers[header_index];
+    uint32 header_index = (sim->undo_buffer.header_write_pos + MAX_UNDO_ACTIONS - 1) % MAX_UNDO_ACTIONS;
+    UndoActionHeader* header = &sim->undo_buffer.headers[header_index];
 
     if (header->level_changed)
     {
-        uint8 level_change_index = undo_buffer.level_change_indices[header_index];
-        UndoLevelChange* level_change = &undo_buffer.level_changes[level_change_index];
+        uint8 level_change_index = sim->undo_buffer.level_change_indices[header_index];
+        UndoLevelChange* level_change = &sim->undo_buffer.level_changes[level_change_index];
 
         // reinitialize previous
         initializeLevel(level_change->from_level);
@@ -2956,7 +3496,7 @@ bool performUndo()
     uint32 delta_pos = header->delta_start_pos;
     FOR(entity_index, header->entity_count)
     {
-        UndoEntityDelta* delta = &undo_buffer.deltas[delta_pos];
+        UndoEntityDelta* delta = &sim->undo_buffer.deltas[delta_pos];
         Entity* e = getEntityFromId(delta->id);
         if (e && !e->removed)
         {
@@ -2970,7 +3510,7 @@ bool performUndo()
     delta_pos = header->delta_start_pos;
     FOR(entity_index, header->entity_count)
     {
-        UndoEntityDelta* delta = &undo_buffer.deltas[delta_pos];
+        UndoEntityDelta* delta = &sim->undo_buffer.deltas[delta_pos];
 
         Entity* e = getEntityFromId(delta->id);
         if (e)
@@ -2993,13 +3533,14 @@ bool performUndo()
     }
 
     // rewind buffer positions
-    undo_buffer.delta_write_pos = header->delta_start_pos;
-    undo_buffer.delta_count -= header->entity_count;
-    undo_buffer.level_change_indices[header_index] = 0xFF;
-    undo_buffer.header_write_pos = header_index;
-    undo_buffer.header_count--;
+    sim->undo_buffer.delta_write_pos = header->delta_start_pos;
+    sim->undo_buffer.delta_count -= header->entity_count;
+    sim->undo_buffer.level_change_indices[header_index] = 0xFF;
+    sim->undo_buffer.header_write_pos = header_index;
+    sim->undo_buffer.header_count--;
 
     restart_last_turn = false;
+    wakeAllEntities();
 
     //writeUndoBufferToFile();
 
@@ -3008,14 +3549,14 @@ bool performUndo()
 
 void levelChangePrep(char next_level[64], bool write_solved_levels)
 {
-    if (!in_overworld && findInSolvedLevels(world_state.level_name) == -1 && write_solved_levels)
+    if (!in_overworld && findInSolvedLevels(sim->world_state.level_name) == -1 && write_solved_levels)
     {
-        addToSolvedLevels(world_state.level_name);
+        addToSolvedLevels(sim->world_state.level_name);
         writeSolvedLevelsToFile();
         updateLockedTiles(true);
     }
     
-    recordLevelChangeForUndo(world_state.level_name);
+    recordLevelChangeForUndo(sim->world_state.level_name);
 
     if (strcmp(next_level, "overworld") == 0) in_overworld = true;
     else in_overworld = false;
@@ -3026,16 +3567,16 @@ void placePlayerOnWinBlock(char from_level[64])
     FOR(wb_index, MAX_ENTITY_INSTANCE_COUNT)
     {
         Entity* zero_wb = &overworld_zero_state.win_blocks[wb_index];
-        if (strcmp(from_level, zero_wb->next_level) == 0)
+        if (strcmp(from_level, overworld_zero_metadata[entitySlot(&overworld_zero_state, zero_wb)].next_level) == 0)
         {
             Int3 new_player_coords = getNextCoords(zero_wb->coords, UP);
-            Int3 new_pack_coords = getNextCoords(new_player_coords, oppositeDirection(player->direction));
+            Int3 new_pack_coords = getNextCoords(new_player_coords, oppositeDirection(sim->player->direction));
 
-            moveEntityInBufferAndState(player, new_player_coords, player->direction);
-            moveEntityInBufferAndState(pack, new_pack_coords, pack->direction);
+            moveEntityInBufferAndState(sim->player, new_player_coords, sim->player->direction);
+            moveEntityInBufferAndState(sim->pack, new_pack_coords, sim->pack->direction);
 
-            player->position = vec3FromInt3(new_player_coords);
-            pack->position = vec3FromInt3(new_pack_coords);
+            sim->player->position = vec3FromInt3(new_player_coords);
+            sim->pack->position = vec3FromInt3(new_pack_coords);
             break;
         }
     }
@@ -3046,30 +3587,30 @@ void placePlayerOnWinBlock(char from_level[64])
 void doStandardMovement(Direction direction, Int3 next_player_coords)
 {
     // maybe move stack above the player's head
-    Int3 coords_above_player = getNextCoords(player->coords, UP);
+    Int3 coords_above_player = getNextCoords(sim->player->coords, UP);
     bool do_on_head_movement = false;
     if (isPushable(getTileType(coords_above_player)) && canPush(coords_above_player, direction)) do_on_head_movement = true;
-    if (temp_state.blue_gameplay_timer > 0) do_on_head_movement = false;
+    if (sim->temp_state.blue_gameplay_timer > 0) do_on_head_movement = false;
     if (do_on_head_movement) pushAll(coords_above_player, direction, MOVE_TYPE_PUSH_ON_HEAD, true);
 
-    createTrailingHitbox(PLAYER_ID, player->coords, TRAILING_HITBOX_TIME);
-    moveEntityInBufferAndState(player, next_player_coords, player->direction);
+    createTrailingHitbox(PLAYER_ID, sim->player->coords, TRAILING_HITBOX_TIME);
+    moveEntityInBufferAndState(sim->player, next_player_coords, sim->player->direction);
 
     // move pack also if pack is attached
-    if (temp_state.pack_attached)
+    if (sim->temp_state.pack_attached)
     {
-        createTrailingHitbox(PACK_ID, pack->coords, TRAILING_HITBOX_TIME);
-        Int3 next_pack_coords = getNextCoords(pack->coords, direction);
-        moveEntityInBufferAndState(pack, next_pack_coords, pack->direction);
+        createTrailingHitbox(PACK_ID, sim->pack->coords, TRAILING_HITBOX_TIME);
+        Int3 next_pack_coords = getNextCoords(sim->pack->coords, direction);
+        moveEntityInBufferAndState(sim->pack, next_pack_coords, sim->pack->direction);
     }
 }
 
 bool canFall(Entity* e)
 {
-    Int3 coords_below = getNextCoords(e->coords, DOWN);
-    TileType type_below = getTileType(coords_below);
+    TileType type_below = sim->padded_tiles[coordsToPaddedIndex(e->coords) + sim->padded_direction_stride[DOWN]];
     if (type_below != TILE_TYPE_NONE && type_below != TILE_TYPE_VOID) return false;
 
+    Int3 coords_below = getNextCoords(e->coords, DOWN);
     TrailingHitbox th;
     if (trailingHitboxAtCoords(coords_below, &th) && !getEntityFromId(th.id)->falling) return false;
 
@@ -3094,7 +3635,7 @@ float calculateSpeculativeVelocityAlongDirection(Direction direction, float sign
 {
     // get velocity of case where we fully accelerate on this frame. clamp velocity to max speed
     Vec3 velocity_to_add = vec3ScalarMultiply(directionToVector(direction), PLAYER_ACCELERATION); // may be negative, if direction is N or W
-    Vec3 unclamped_speculative_velocity = vec3Add(player->velocity, velocity_to_add);             // in that case, velocity is also negative, so add works correctly.
+    Vec3 unclamped_speculative_velocity = vec3Add(sim->player->velocity, velocity_to_add);             // in that case, velocity is also negative, so add works correctly.
     float unclamped_speculative_velocity_along_direction = getFloatAlongDirection(direction, unclamped_speculative_velocity); // may be negative
     float speculative_velocity_along_direction = unclamped_speculative_velocity_along_direction;
     if (sign == -1.0f) speculative_velocity_along_direction = speculative_velocity_along_direction < -PLAYER_MAX_SPEED ? -PLAYER_MAX_SPEED : speculative_velocity_along_direction;
@@ -3137,8 +3678,8 @@ void interpolateDecoupledTowardsCoords(Entity* e)
 // called on failed or half-failed turn to handle on head entities
 void revertHeadStackRotation()
 {
-    int32 reverse_add = (4 + temp_state.pack_turn_state.initial_player_direction - player->direction) % 4;
-    Int3 current_coords = getNextCoords(player->coords, UP);
+    int32 reverse_add = (4 + sim->temp_state.pack_turn_state.initial_player_direction - sim->player->direction) % 4;
+    Int3 current_coords = getNextCoords(sim->player->coords, UP);
     int32 stack_size = getPushableStackSize(current_coords, UP);
 
     FOR(_, stack_size)
@@ -3151,8 +3692,8 @@ void revertHeadStackRotation()
 
 Vec3 getPositionBehindPlayer()
 {
-    Vec3 rotated_offset = vec3RotateByQuaternion(vec3FromInt3(AXIS_Z), player->rotation); // AXIS_Z because pack is 0, 0, 1 relative to player 0, 0, 0, when player has no rotation.
-    return vec3Add(player->position, rotated_offset);
+    Vec3 rotated_offset = vec3RotateByQuaternion(vec3FromInt3(AXIS_Z), sim->player->rotation); // AXIS_Z because pack is 0, 0, 1 relative to player 0, 0, 0, when player has no rotation.
+    return vec3Add(sim->player->position, rotated_offset);
 }
 
 Vec4 getBlueTilt(Entity* e)
@@ -3170,60 +3711,236 @@ void applyTiltFromVector(Entity* e, Vec3 tilt_vector)
 {
     float angle = vec3Length(tilt_vector);
     Vec3 tilt_axis = vec3OuterProduct(vec3FromInt3(AXIS_Y), tilt_vector); // up x lean
-    e->visual_tilt = quaternionFromAxis(vec3Normalize(tilt_axis), angle);
+    Vec4 visual_tilt = quaternionFromAxis(vec3Normalize(tilt_axis), angle);
+    getEntityVisuals(e)->visual_tilt = visual_tilt;
     Vec3 pivot = vec3Add(vec3ScalarMultiply(vec3Normalize(tilt_vector), 0.5f), vec3ScalarMultiply(vec3FromInt3(AXIS_Y), -0.5f));
-    Vec3 rotated_pivot = vec3RotateByQuaternion(pivot, e->visual_tilt);
+    Vec3 rotated_pivot = vec3RotateByQuaternion(pivot, visual_tilt);
     e->displacement = vec3Subtract(pivot, rotated_pivot);
 }
 
 // returns 0 when not settling
 Vec3 advanceSettleTilt(Entity* e)
 {
-    if (e->settle_timer <= 0) return (Vec3){0};
+    EntityVisuals* visuals = getEntityVisuals(e);
+    if (visuals->settle_timer <= 0) return (Vec3){0};
 
-    int32 settle_time = e->settle_do_extra_push ? SETTLE_TIME_FOR_EXTRA_PUSH : SETTLE_TIME_NO_EXTRA_PUSH;
+    int32 settle_time = visuals->settle_do_extra_push ? SETTLE_TIME_FOR_EXTRA_PUSH : SETTLE_TIME_NO_EXTRA_PUSH;
     float settle_start = sqrtf(1.0f - VELOCITY_TO_TILT_RADIANS / SETTLE_EXTRA_PUSH_TILT_MULTIPLIER);
-    if (e->settle_do_extra_push) settle_start = -settle_start;
+    if (visuals->settle_do_extra_push) settle_start = -settle_start;
 
-    float settle_progress = (float)(settle_time - e->settle_timer) / (float)(settle_time - 1);
+    float settle_progress = (float)(settle_time - visuals->settle_timer) / (float)(settle_time - 1);
     float settle_curve_position = settle_start + settle_progress * (1.0f - settle_start);
     float settle_fraction = 1.0f - settle_curve_position * settle_curve_position;
 
-    e->settle_timer--;
-    return vec3ScalarMultiply(e->settle_velocity, SETTLE_EXTRA_PUSH_TILT_MULTIPLIER * settle_fraction);
+    visuals->settle_timer--;
+    return vec3ScalarMultiply(visuals->settle_velocity, SETTLE_EXTRA_PUSH_TILT_MULTIPLIER * settle_fraction);
 }
 
-// NOTE: some of this is purely animations. we could pass in a parameter for if this should be done (should not be done in any forward prediction loop)
-void doPhysicsTick()
+// SIMD MOVEMENT INTEGRATION
+
+// pushed entities all follow the same rule: target = coords + (root position - root coords) along the moving axis, so every lane is the same handful of adds and compares.
+void gatherMovementLane(MovementLanes* lanes, Entity* e, Entity* root_e)
 {
-    // pack turn sequence
-    if (temp_state.pack_turn_state.pack_intermediate_states_timer > 0)
-    {
-        int32 total = temp_state.pack_turn_state.turn_total_frames;
-        int32 diagonal_trigger = total < TURN_TIME ? total : TURN_TIME;
-        int32 orthogonal_trigger = diagonal_trigger - 3;
-        if (orthogonal_trigger < 1) orthogonal_trigger = 1;
+    int32 lane = lanes->count++;
+    lanes->entities[lane] = e;
+    lanes->move_type[lane] = e->move_type;
+    lanes->moving_direction[lane] = e->moving_direction;
 
-        bool this_is_diagonal = false;
-        bool this_is_orthogonal = false;
-        if (temp_state.pack_turn_state.pack_intermediate_states_timer == diagonal_trigger) this_is_diagonal = true;
-        if (temp_state.pack_turn_state.pack_intermediate_states_timer == orthogonal_trigger) this_is_orthogonal = true;
+    lanes->position_x[lane] = e->position.x;
+    lanes->position_y[lane] = e->position.y;
+    lanes->position_z[lane] = e->position.z;
+    lanes->coords_x[lane] = (float)e->coords.x;
+    lanes->coords_y[lane] = (float)e->coords.y;
+    lanes->coords_z[lane] = (float)e->coords.z;
 
-        if (this_is_diagonal || this_is_orthogonal)
-        {
-            Int3 coords_at_turn;
-            Direction push_direction;
-            if (this_is_diagonal)
-            {
-                push_direction = oppositeDirection(player->direction);
-                coords_at_turn = temp_state.pack_turn_state.pack_intermediate_coords;
-            }
-            else
-            {
-                push_direction = temp_state.pack_turn_state.initial_player_direction;
-                coords_at_turn = getNextCoords(pack->coords, push_direction);
-            }
-            TileType type_at_push = getTileType(coords_at_turn);
+    Vec3 axis = vec3SetFloatAlongDirection(e->moving_direction, 1.0f, (Vec3){0});
+    lanes->axis_x[lane] = axis.x;
+    lanes->axis_y[lane] = axis.y;
+    lanes->axis_z[lane] = axis.z;
+    lanes->sign[lane] = e->moving_direction == NORTH || e->moving_direction == WEST ? -1.0f : 1.0f;
+    lanes->root_offset[lane] = getFloatAlongDirection(e->moving_direction, vec3Subtract(root_e->position, vec3FromInt3(root_e->coords)));
+}
+
+void integrateMovementLanes(MovementLanes* lanes)
+{
+    // zero the padding lanes so the last batch reads defined values
+    int32 padded_count = (lanes->count + 7) & ~7;
+    for (int32 lane = lanes->count; lane < padded_count; lane++)
+    {
+        lanes->position_x[lane] = 0; lanes->position_y[lane] = 0; lanes->position_z[lane] = 0;
+        lanes->coords_x[lane] = 0;   lanes->coords_y[lane] = 0;   lanes->coords_z[lane] = 0;
+        lanes->axis_x[lane] = 0;     lanes->axis_y[lane] = 0;     lanes->axis_z[lane] = 0;
+        lanes->sign[lane] = 0;       lanes->root_offset[lane] = 0;
+    }
+
+#if defined(__AVX__)
+    for (int32 lane = 0; lane < padded_count; lane += 8)
+    {
+        __m256 offset = _mm256_loadu_ps(&lanes->root_offset[lane]);
+        __m256 axis_x = _mm256_loadu_ps(&lanes->axis_x[lane]);
+        __m256 axis_y = _mm256_loadu_ps(&lanes->axis_y[lane]);
+        __m256 axis_z = _mm256_loadu_ps(&lanes->axis_z[lane]);
+        __m256 coords_x = _mm256_loadu_ps(&lanes->coords_x[lane]);
+        __m256 coords_y = _mm256_loadu_ps(&lanes->coords_y[lane]);
+        __m256 coords_z = _mm256_loadu_ps(&lanes->coords_z[lane]);
+
+        __m256 new_x = _mm256_add_ps(coords_x, _mm256_mul_ps(axis_x, offset));
+        __m256 new_y = _mm256_add_ps(coords_y, _mm256_mul_ps(axis_y, offset));
+        __m256 new_z = _mm256_add_ps(coords_z, _mm256_mul_ps(axis_z, offset));
+        __m256 velocity_x = _mm256_sub_ps(new_x, _mm256_loadu_ps(&lanes->position_x[lane]));
+        __m256 velocity_y = _mm256_sub_ps(new_y, _mm256_loadu_ps(&lanes->position_y[lane]));
+        __m256 velocity_z = _mm256_sub_ps(new_z, _mm256_loadu_ps(&lanes->position_z[lane]));
+
+        // signed step along the moving axis decides backwards / too far
+        __m256 step = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(velocity_x, axis_x), _mm256_mul_ps(velocity_y, axis_y)), _mm256_mul_ps(velocity_z, axis_z));
+        step = _mm256_mul_ps(step, _mm256_loadu_ps(&lanes->sign[lane]));
+        __m256 reversed = _mm256_or_ps(_mm256_cmp_ps(step, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_cmp_ps(step, _mm256_set1_ps(0.5f), _CMP_GT_OQ));
+        __m256 arrived = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(new_x, coords_x, _CMP_EQ_OQ), _mm256_cmp_ps(new_y, coords_y, _CMP_EQ_OQ)), _mm256_cmp_ps(new_z, coords_z, _CMP_EQ_OQ));
+
+        _mm256_storeu_ps(&lanes->position_x[lane], new_x);
+        _mm256_storeu_ps(&lanes->position_y[lane], new_y);
+        _mm256_storeu_ps(&lanes->position_z[lane], new_z);
+        _mm256_storeu_ps(&lanes->velocity_x[lane], velocity_x);
+        _mm256_storeu_ps(&lanes->velocity_y[lane], velocity_y);
+        _mm256_storeu_ps(&lanes->velocity_z[lane], velocity_z);
+
+        int32 reversed_mask = _mm256_movemask_ps(reversed);
+        int32 arrived_mask = _mm256_movemask_ps(arrived);
+        FOR(bit, 8) lanes->result[lane + bit] = ((reversed_mask >> bit) & 1) * MOVEMENT_RESULT_REVERSED | ((arrived_mask >> bit) & 1) * MOVEMENT_RESULT_ARRIVED;
+    }
+#elif defined(MOVEMENT_SIMD)
+    for (int32 lane = 0; lane < padded_count; lane += 4)
+    {
+        __m128 offset = _mm_loadu_ps(&lanes->root_offset[lane]);
+        __m128 axis_x = _mm_loadu_ps(&lanes->axis_x[lane]);
+        __m128 axis_y = _mm_loadu_ps(&lanes->axis_y[lane]);
+        __m128 axis_z = _mm_loadu_ps(&lanes->axis_z[lane]);
+        __m128 coords_x = _mm_loadu_ps(&lanes->coords_x[lane]);
+        __m128 coords_y = _mm_loadu_ps(&lanes->coords_y[lane]);
+        __m128 coords_z = _mm_loadu_ps(&lanes->coords_z[lane]);
+
+        __m128 new_x = _mm_add_ps(coords_x, _mm_mul_ps(axis_x, offset));
+        __m128 new_y = _mm_add_ps(coords_y, _mm_mul_ps(axis_y, offset));
+        __m128 new_z = _mm_add_ps(coords_z, _mm_mul_ps(axis_z, offset));
+        __m128 velocity_x = _mm_sub_ps(new_x, _mm_loadu_ps(&lanes->position_x[lane]));
+        __m128 velocity_y = _mm_sub_ps(new_y, _mm_loadu_ps(&lanes->position_y[lane]));
+        __m128 velocity_z = _mm_sub_ps(new_z, _mm_loadu_ps(&lanes->position_z[lane]));
+
+        // signed step along the moving axis decides backwards / too far
+        __m128 step = _mm_add_ps(_mm_add_ps(_mm_mul_ps(velocity_x, axis_x), _mm_mul_ps(velocity_y, axis_y)), _mm_mul_ps(velocity_z, axis_z));
+        step = _mm_mul_ps(step, _mm_loadu_ps(&lanes->sign[lane]));
+        __m128 reversed = _mm_or_ps(_mm_cmplt_ps(step, _mm_setzero_ps()), _mm_cmpgt_ps(step, _mm_set1_ps(0.5f)));
+        __m128 arrived = _mm_and_ps(_mm_and_ps(_mm_cmpeq_ps(new_x, coords_x), _mm_cmpeq_ps(new_y, coords_y)), _mm_cmpeq_ps(new_z, coords_z));
+
+        _mm_storeu_ps(&lanes->position_x[lane], new_x);
+        _mm_storeu_ps(&lanes->position_y[lane], new_y);
+        _mm_storeu_ps(&lanes->position_z[lane], new_z);
+        _mm_storeu_ps(&lanes->velocity_x[lane], velocity_x);
+        _mm_storeu_ps(&lanes->velocity_y[lane], velocity_y);
+        _mm_storeu_ps(&lanes->velocity_z[lane], velocity_z);
+
+        int32 reversed_mask = _mm_movemask_ps(reversed);
+        int32 arrived_mask = _mm_movemask_ps(arrived);
+        FOR(bit, 4) lanes->result[lane + bit] = ((reversed_mask >> bit) & 1) * MOVEMENT_RESULT_REVERSED | ((arrived_mask >> bit) & 1) * MOVEMENT_RESULT_ARRIVED;
+    }
+#else
+    FOR(lane, lanes->count)
+    {
+        float offset = lanes->root_offset[lane];
+        float new_x = lanes->coords_x[lane] + lanes->axis_x[lane] * offset;
+        float new_y = lanes->coords_y[lane] + lanes->axis_y[lane] * offset;
+        float new_z = lanes->coords_z[lane] + lanes->axis_z[lane] * offset;
+        lanes->velocity_x[lane] = new_x - lanes->position_x[lane];
+        lanes->velocity_y[lane] = new_y - lanes->position_y[lane];
+        lanes->velocity_z[lane] = new_z - lanes->position_z[lane];
+
+        float step = lanes->sign[lane] * (lanes->velocity_x[lane] * lanes->axis_x[lane] + lanes->velocity_y[lane] * lanes->axis_y[lane] + lanes->velocity_z[lane] * lanes->axis_z[lane]);
+        bool arrived = new_x == lanes->coords_x[lane] && new_y == lanes->coords_y[lane] && new_z == lanes->coords_z[lane];
+        lanes->result[lane] = (step < 0.0f || step > 0.5f) * MOVEMENT_RESULT_REVERSED | arrived * MOVEMENT_RESULT_ARRIVED;
+
+        lanes->position_x[lane] = new_x;
+        lanes->position_y[lane] = new_y;
+        lanes->position_z[lane] = new_z;
+    }
+#endif
+}
+
+// writes integrated lanes back. the per-entity bits that aren't plain arithmetic (clearing, head rotation, settle / tilt visuals) stay scalar.
+// the settle / tilt visuals are skipped without do_animations
+void scatterMovementLanes(MovementLanes* lanes, bool do_animations)
+{
+    FOR(lane, lanes->count)
+    {
+        Entity* e = lanes->entities[lane];
+        if (lanes->result[lane] & MOVEMENT_RESULT_REVERSED)
+        {
+            // attempting to travel backwards. could be smarter here, but because of player deceleration being relatively high, clearing just works
+            clearMovementState(e);
+            continue;
+        }
+
+        if (lanes->move_type[lane] == MOVE_TYPE_PUSH_ON_HEAD)
+        {
+            // copy rotation of player if on head
+            e->yaw_offset = sim->player->yaw_offset;
+            e->rotation = composeRotation(e->direction, e->mirror_orientation, e->yaw_offset, getEntityVisuals(e)->visual_tilt);
+        }
+
+        e->position = (Vec3){ lanes->position_x[lane], lanes->position_y[lane], lanes->position_z[lane] };
+        e->velocity = (Vec3){ lanes->velocity_x[lane], lanes->velocity_y[lane], lanes->velocity_z[lane] };
+        EntityVisuals* visuals = getEntityVisuals(e);
+        if (do_animations && vec3Length(e->velocity) > vec3Length(visuals->settle_velocity)) visuals->settle_velocity = e->velocity;
+
+        // handle visual tilt
+        bool do_visual_tilt = do_animations;
+        if (lanes->move_type[lane] != MOVE_TYPE_PUSH_BY_PLAYER && lanes->move_type[lane] != MOVE_TYPE_PUSH_BY_PACK) do_visual_tilt = false;
+        if (visual_effects.blue_visual_timer <= 0) do_visual_tilt = false;
+        if (do_visual_tilt)
+        {
+            float target_angle = vec3Length(visuals->settle_velocity) * VELOCITY_TO_TILT_RADIANS;
+            float tilt_difference = target_angle - visuals->tilt_angle;
+            visuals->tilt_angle += tilt_difference;
+        }
+
+        if (lanes->result[lane] & MOVEMENT_RESULT_ARRIVED)
+        {
+            // TODO: settle handling
+            clearMovementState(e);
+        }
+    }
+}
+
+// NOTE: some of this is purely animations, which only run with do_animations. turbo mode ticks without them, since nothing is drawn in between
+void doPhysicsTick(bool do_animations)
+{
+    // pack turn sequence
+    if (sim->temp_state.pack_turn_state.pack_intermediate_states_timer > 0)
+    {
+        int32 total = sim->temp_state.pack_turn_state.turn_total_frames;
+        int32 diagonal_trigger = total < TURN_TIME ? total : TURN_TIME;
+        int32 orthogonal_trigger = diagonal_trigger - 3;
+        if (orthogonal_trigger < 1) orthogonal_trigger = 1;
+
+        bool this_is_diagonal = false;
+        bool this_is_orthogonal = false;
+        if (sim->temp_state.pack_turn_state.pack_intermediate_states_timer == diagonal_trigger) this_is_diagonal = true;
+        if (sim->temp_state.pack_turn_state.pack_intermediate_states_timer == orthogonal_trigger) this_is_orthogonal = true;
+
+        if (this_is_diagonal || this_is_orthogonal)
+        {
+            Int3 coords_at_turn;
+            Direction push_direction;
+            if (this_is_diagonal)
+            {
+                push_direction = oppositeDirection(sim->player->direction);
+                coords_at_turn = sim->temp_state.pack_turn_state.pack_intermediate_coords;
+            }
+            else
+            {
+                push_direction = sim->temp_state.pack_turn_state.initial_player_direction;
+                coords_at_turn = getNextCoords(sim->pack->coords, push_direction);
+            }
+            TileType type_at_push = getTileType(coords_at_turn);
 
             bool allow_turn = false;
             bool do_push = false;
@@ -3247,35 +3964,35 @@ void doPhysicsTick()
             {
                 if (do_push)
                 {
-                    pushAll(coords_at_turn, push_direction, MOVE_TYPE_PUSH_BY_PACK, temp_state.blue_gameplay_timer == 0);
-                    temp_state.pack_turn_state.half_failed_turn_timer = 0;
-                    if (this_is_diagonal) temp_state.pack_turn_state.diagonal_push_happened_this_turn = true;
+                    pushAll(coords_at_turn, push_direction, MOVE_TYPE_PUSH_BY_PACK, sim->temp_state.blue_gameplay_timer == 0);
+                    sim->temp_state.pack_turn_state.half_failed_turn_timer = 0;
+                    if (this_is_diagonal) sim->temp_state.pack_turn_state.diagonal_push_happened_this_turn = true;
                 }
-                createTrailingHitbox(PACK_ID, pack->coords, TRAILING_HITBOX_TIME);
-                moveEntityInBufferAndState(pack, coords_at_turn, player->direction);
+                createTrailingHitbox(PACK_ID, sim->pack->coords, TRAILING_HITBOX_TIME);
+                moveEntityInBufferAndState(sim->pack, coords_at_turn, sim->player->direction);
             }
             else
             {
-                if (isPushable(getTileType(getNextCoords(player->coords, UP)))) revertHeadStackRotation();
+                if (isPushable(getTileType(getNextCoords(sim->player->coords, UP)))) revertHeadStackRotation();
                 if (this_is_orthogonal)
                 {
-                    Int3 start_pack_coords = getNextCoords(player->coords, oppositeDirection(temp_state.pack_turn_state.initial_player_direction));
-                    moveEntityInBufferAndState(pack, start_pack_coords, player->direction);
+                    Int3 start_pack_coords = getNextCoords(sim->player->coords, oppositeDirection(sim->temp_state.pack_turn_state.initial_player_direction));
+                    moveEntityInBufferAndState(sim->pack, start_pack_coords, sim->player->direction);
                 }
-                if (this_is_diagonal || !temp_state.pack_turn_state.diagonal_push_happened_this_turn) popLastUndoAction();
-
-                Direction reverting_from = player->direction;
-                Direction reverting_to = temp_state.pack_turn_state.initial_player_direction;
-                player->yaw_offset += directionAngleY(reverting_from) - directionAngleY(reverting_to);
-                if (player->yaw_offset >  0.5f * TAU) player->yaw_offset -= TAU;
-                if (player->yaw_offset < -0.5f * TAU) player->yaw_offset += TAU;
-                player->direction = reverting_to;
-                pack->direction = player->direction;
-
-                temp_state.pack_turn_state.half_failed_turn_timer = HALF_FAILED_PACK_TURN_COOLDOWN;
-                temp_state.pack_turn_state.pack_intermediate_states_timer = 0;
+                if (this_is_diagonal || !sim->temp_state.pack_turn_state.diagonal_push_happened_this_turn) popLastUndoAction();
+
+                Direction reverting_from = sim->player->direction;
+                Direction reverting_to = sim->temp_state.pack_turn_state.initial_player_direction;
+                sim->player->yaw_offset += directionAngleY(reverting_from) - directionAngleY(reverting_to);
+                if (sim->player->yaw_offset >  0.5f * TAU) sim->player->yaw_offset -= TAU;
+                if (sim->player->yaw_offset < -0.5f * TAU) sim->player->yaw_offset += TAU;
+                sim->player->direction = reverting_to;
+                sim->pack->direction = sim->player->direction;
+
+                sim->temp_state.pack_turn_state.half_failed_turn_timer = HALF_FAILED_PACK_TURN_COOLDOWN;
+                sim->temp_state.pack_turn_state.pack_intermediate_states_timer = 0;
             }
-            if (this_is_orthogonal) temp_state.pack_turn_state.diagonal_push_happened_this_turn = false;
+            if (this_is_orthogonal) sim->temp_state.pack_turn_state.diagonal_push_happened_this_turn = false;
         }
     }
 
@@ -3283,30 +4000,30 @@ void doPhysicsTick()
 
     // climb logic
     // NOTE: no down climb anymore
-    if (player->moving_direction == UP)
+    if (sim->player->moving_direction == UP)
     {
-        float y_coord_difference = getSignedFloatAlongDirection(player->moving_direction, vec3Subtract(vec3FromInt3(player->coords), player->position));
+        float y_coord_difference = getSignedFloatAlongDirection(sim->player->moving_direction, vec3Subtract(vec3FromInt3(sim->player->coords), sim->player->position));
         if (y_coord_difference > CLIMBING_SPEED)
         {
             // keep climbing, already commited to this movement.
-            float sign = player->moving_direction == UP ? 1.0f : -1.0f;
-            player->position.y += sign * CLIMBING_SPEED;
-            player->velocity.y = sign * CLIMBING_SPEED;
-            if (temp_state.pack_attached)
+            float sign = sim->player->moving_direction == UP ? 1.0f : -1.0f;
+            sim->player->position.y += sign * CLIMBING_SPEED;
+            sim->player->velocity.y = sign * CLIMBING_SPEED;
+            if (sim->temp_state.pack_attached)
             {
-                pack->position.y += sign * CLIMBING_SPEED;
-                pack->velocity.y = sign * CLIMBING_SPEED;
+                sim->pack->position.y += sign * CLIMBING_SPEED;
+                sim->pack->velocity.y = sign * CLIMBING_SPEED;
             }
         }
         else
         {
-            Int3 coords_ahead = getNextCoords(player->coords, player->direction);
+            Int3 coords_ahead = getNextCoords(sim->player->coords, sim->player->direction);
             TileType type_ahead = getTileType(coords_ahead);
 
             if (type_ahead == TILE_TYPE_LADDER)
             {
                 // try climb more
-                Int3 coords_above_player = getNextCoords(player->coords, UP);
+                Int3 coords_above_player = getNextCoords(sim->player->coords, UP);
                 TileType type_above_player = getTileType(coords_above_player);
 
                 bool climb_up = false;
@@ -3323,26 +4040,26 @@ void doPhysicsTick()
 
                 if (climb_up)
                 {
-                    if (!temp_state.pack_attached)
+                    if (!sim->temp_state.pack_attached)
                     {
                         // check behind player position for pack: if exists, pack should attach, but only if won't instantly detach.
-                        Int3 coords_behind = getNextCoords(player->coords, oppositeDirection(player->direction));
+                        Int3 coords_behind = getNextCoords(sim->player->coords, oppositeDirection(sim->player->direction));
                         if (getTileType(coords_behind) == TILE_TYPE_PACK)
                         {
                             // want to attach
                             Int3 next_coords_for_pack_if_attach = getNextCoords(coords_behind, UP);
                             TileType type_of_next_coords = getTileType(next_coords_for_pack_if_attach);
-                            if (type_of_next_coords == TILE_TYPE_NONE) temp_state.pack_attached = true;
-                            else if (isPushable(type_of_next_coords) && canPushVertical(coords_above_player, UP)) temp_state.pack_attached = true;
+                            if (type_of_next_coords == TILE_TYPE_NONE) sim->temp_state.pack_attached = true;
+                            else if (isPushable(type_of_next_coords) && canPushVertical(coords_above_player, UP)) sim->temp_state.pack_attached = true;
                         }
                     }
 
-                    if (temp_state.pack_attached)
+                    if (sim->temp_state.pack_attached)
                     {
                         bool pack_stays_with_player = false;
                         bool pack_push_up = false;
 
-                        Int3 coords_above_pack = getNextCoords(pack->coords, UP);
+                        Int3 coords_above_pack = getNextCoords(sim->pack->coords, UP);
                         TileType type_above_pack = getTileType(coords_above_pack);
 
                         if (type_above_pack == TILE_TYPE_NONE)
@@ -3357,29 +4074,29 @@ void doPhysicsTick()
 
                         if (pack_stays_with_player)
                         {
-                            createTrailingHitbox(PACK_ID, pack->coords, TRAILING_HITBOX_TIME);
+                            createTrailingHitbox(PACK_ID, sim->pack->coords, TRAILING_HITBOX_TIME);
                             if (pack_push_up) pushVertical(coords_above_pack, UP);
-                            moveEntityInBufferAndState(pack, coords_above_pack, player->direction);
-                            pack->position.y += CLIMBING_SPEED;
-                            pack->velocity.y = CLIMBING_SPEED;
+                            moveEntityInBufferAndState(sim->pack, coords_above_pack, sim->player->direction);
+                            sim->pack->position.y += CLIMBING_SPEED;
+                            sim->pack->velocity.y = CLIMBING_SPEED;
                         }
                         else
                         {
-                            temp_state.pack_attached = false;
-                            pack->position = vec3FromInt3(pack->coords);
-                            pack->velocity = (Vec3){0};
+                            sim->temp_state.pack_attached = false;
+                            sim->pack->position = vec3FromInt3(sim->pack->coords);
+                            sim->pack->velocity = (Vec3){0};
                         }
                     }
 
-                    createTrailingHitbox(PLAYER_ID, player->coords, TRAILING_HITBOX_TIME);
+                    createTrailingHitbox(PLAYER_ID, sim->player->coords, TRAILING_HITBOX_TIME);
                     if (player_push_up) pushVertical(coords_above_player, UP);
-                    moveEntityInBufferAndState(player, coords_above_player, player->direction);
-                    player->position.y += CLIMBING_SPEED;
-                    player->velocity.y = CLIMBING_SPEED;
+                    moveEntityInBufferAndState(sim->player, coords_above_player, sim->player->direction);
+                    sim->player->position.y += CLIMBING_SPEED;
+                    sim->player->velocity.y = CLIMBING_SPEED;
                 }
                 else // something unpushable above player
                 {
-                    player->moving_direction = NO_DIRECTION;
+                    sim->player->moving_direction = NO_DIRECTION;
                 }
             }
             else // some other type ahead
@@ -3390,7 +4107,7 @@ void doPhysicsTick()
                 {
                     move_forwards = true;
                 }
-                else if (isPushable(type_ahead) && canPush(coords_ahead, player->direction)) 
+                else if (isPushable(type_ahead) && canPush(coords_ahead, sim->player->direction)) 
                 {
                     move_forwards = true;
                     push_forwards = true;
@@ -3398,21 +4115,21 @@ void doPhysicsTick()
 
                 if (move_forwards)
                 {
-                    if (!temp_state.pack_attached)
+                    if (!sim->temp_state.pack_attached)
                     {
-                        Int3 coords_behind_player = getNextCoords(player->coords, oppositeDirection(player->direction));
-                        if (getTileType(coords_behind_player) == TILE_TYPE_PACK) temp_state.pack_attached = true;
+                        Int3 coords_behind_player = getNextCoords(sim->player->coords, oppositeDirection(sim->player->direction));
+                        if (getTileType(coords_behind_player) == TILE_TYPE_PACK) sim->temp_state.pack_attached = true;
                     }
 
-                    player->position = vec3FromInt3(player->coords); // normalize y coord
-                    player->velocity = (Vec3){0};
-                    player->moving_direction = NO_DIRECTION;
-                    if (push_forwards) pushAll(coords_ahead, player->direction, MOVE_TYPE_PUSH_BY_PLAYER, temp_state.blue_gameplay_timer == 0);
-                    doStandardMovement(player->direction, coords_ahead);
+                    sim->player->position = vec3FromInt3(sim->player->coords); // normalize y coord
+                    sim->player->velocity = (Vec3){0};
+                    sim->player->moving_direction = NO_DIRECTION;
+                    if (push_forwards) pushAll(coords_ahead, sim->player->direction, MOVE_TYPE_PUSH_BY_PLAYER, sim->temp_state.blue_gameplay_timer == 0);
+                    doStandardMovement(sim->player->direction, coords_ahead);
                 }
                 else // something unpushable ahead
                 {
-                    player->moving_direction = NO_DIRECTION;
+                    sim->player->moving_direction = NO_DIRECTION;
                 }
             }
         }
@@ -3420,183 +4137,188 @@ void doPhysicsTick()
 
     updateLaserBuffer();
 
-    // reset fall_handled for all falling_entities 
-    FOR(group_index, 3) FOR(entity_index, MAX_ENTITY_INSTANCE_COUNT) interactible_entity_groups[group_index][entity_index].fall_handled = false;
-    player->fall_handled = false;
-    pack->fall_handled = false;
+    // new tick number, so every fall_handled_tick from earlier ticks reads as not handled
+    sim->physics_tick_count++;
 
-    // falling logic
-    FOR(group_index, 5)
+    // falling logic. sleeping entities can't start falling, so only active entities (then player and pack) are checked
+    int32 fall_cursor = -1;
+    for (Entity* e = nextActiveEntity(&fall_cursor); e != 0; e = nextActiveEntity(&fall_cursor))
     {
-        bool is_player = (group_index == 3);
-        bool is_pack   = (group_index == 4);
-        if (is_pack && temp_state.pack_attached) break;
+        if (e == sim->pack && sim->temp_state.pack_attached) break;
 
-        FOR(entity_index, MAX_ENTITY_INSTANCE_COUNT)
+        if (!e->in_use) continue;
+        if (e->removed) continue;
+        if (e->fall_handled_tick == sim->physics_tick_count) continue; // happens when entity below is removed due to void, so this would look like bottom, even though already handled
+        bool horizontally_stationary = vec3IsZero(vec3SetFloatAlongDirection(DOWN, 0, vec3Subtract(e->position, vec3FromInt3(e->coords))));
+        if (!e->falling && !columnSupportMayHaveChanged(e)) // nothing in this column changed since the entity was last found resting
         {
-            if (entity_index > 0 && group_index > 2) break; // allow continue in player or pack case
-
-            Entity* e;
-            if (is_player) e = player;
-            else if (is_pack) e = pack;
-            else e = &interactible_entity_groups[group_index][entity_index];
-
-            if (!e->in_use) continue;
-            if (e->removed) continue;
-            if (e->fall_handled) continue; // happens when entity below is removed due to void, so this would look like bottom, even though already handled
+            if (verify_fall_gating && canFall(e) && horizontally_stationary) fall_gating_mismatches++; // the full scan would have let it fall
+            continue;
+        }
 
-            bool want_to_fall = true;
-            if (!canFall(e)) want_to_fall = false;
-            if (!vec3IsZero(vec3SetFloatAlongDirection(DOWN, 0, vec3Subtract(e->position, vec3FromInt3(e->coords))))) want_to_fall = false; // not horizontally stationary
-            if (!want_to_fall && !e->falling) continue;
+        bool want_to_fall = true;
+        bool supported = !canFall(e);
+        if (supported) want_to_fall = false;
+        if (!horizontally_stationary) want_to_fall = false;
+        if (supported && horizontally_stationary) e->support_checked_tick = sim->physics_tick_count; // only trust the result once the entity has stopped moving
+        if (!want_to_fall && !e->falling) continue;
 
-            // find the real bottom of the stack (to then interate up from)
-            Int3 bottom_coords = e->coords;
-            while (true)
-            {
-                Int3 below_coords = getNextCoords(bottom_coords, DOWN);
-                if (!isPushable(getTileType(below_coords))) break;
-                Entity* below_e = getEntityAtCoords(below_coords);
-                if (below_e == 0 || below_e->fall_handled) break;
-                bottom_coords = below_coords;
-            }
+        // find the real bottom of the stack (to then interate up from)
+        Int3 bottom_coords = e->coords;
+        int32 bottom_index = coordsToPaddedIndex(bottom_coords);
+        while (true)
+        {
+            int32 below_index = bottom_index + sim->padded_direction_stride[DOWN];
+            if (!isPushable(sim->padded_tiles[below_index])) break;
+            Int3 below_coords = getNextCoords(bottom_coords, DOWN);
+            Entity* below_e = getEntityAtCoords(below_coords);
+            if (below_e == 0 || below_e->fall_handled_tick == sim->physics_tick_count) break;
+            bottom_coords = below_coords;
+            bottom_index = below_index;
+        }
 
-            int32 stack_size_upper_bound = getPushableStackSize(bottom_coords, UP); // is upper bound - could be less than this, if stack wants to be split, or if separate stacks have seemingly merged
-            Int3 current_coords = bottom_coords;
-            FOR(stack_index, stack_size_upper_bound)
-            {
-                Entity* e_in_stack = getEntityAtCoords(current_coords);
+        int32 stack_size_upper_bound = getPushableStackSize(bottom_coords, UP); // is upper bound - could be less than this, if stack wants to be split, or if separate stacks have seemingly merged
+        Int3 current_coords = bottom_coords;
+        FOR(stack_index, stack_size_upper_bound)
+        {
+            Entity* e_in_stack = getEntityAtCoords(current_coords);
 
-                if (!e_in_stack) break; // this shouldn't strictly be needed, but upper bound sometimes overshoots on downclimb.
-                if (e_in_stack->fall_handled) break; // another fall_handled check: entity above may have fallen such that they now form one stack (from getNextCoords pov), so guard on already fallen this frame
-                if (e_in_stack->id == PACK_ID && temp_state.pack_attached && stack_index != 0) break; // stack split because pack should not fall if attached
-                if (e_in_stack->moving_direction != NO_DIRECTION) break;
+            if (!e_in_stack) break; // this shouldn't strictly be needed, but upper bound sometimes overshoots on downclimb.
+            if (e_in_stack->fall_handled_tick == sim->physics_tick_count) break; // another fall_handled check: entity above may have fallen such that they now form one stack (from getNextCoords pov), so guard on already fallen this frame
+            if (e_in_stack->id == PACK_ID && sim->temp_state.pack_attached && stack_index != 0) break; // stack split because pack should not fall if attached
+            if (e_in_stack->moving_direction != NO_DIRECTION) break;
 
-                e_in_stack->fall_handled = true;
-                current_coords = getNextCoords(current_coords, UP);
+            e_in_stack->fall_handled_tick = sim->physics_tick_count;
+            current_coords = getNextCoords(current_coords, UP);
 
-                // calculate test velocity and position if were to fall this frame
-                float test_y_velocity = e_in_stack->velocity.y + GRAVITY;
-                test_y_velocity = floatMax(test_y_velocity, MIN_FALL_VELOCITY);
-                float test_y_position = e_in_stack->position.y + test_y_velocity;
+            // calculate test velocity and position if were to fall this frame
+            float test_y_velocity = e_in_stack->velocity.y + GRAVITY;
+            test_y_velocity = floatMax(test_y_velocity, MIN_FALL_VELOCITY);
+            float test_y_position = e_in_stack->position.y + test_y_velocity;
 
-                // if falling and will only fall within current block, just apply that fall and continue
-                if (test_y_position > getFloatAlongDirection(DOWN, vec3FromInt3(e_in_stack->coords)))
+            // if falling and will only fall within current block, just apply that fall and continue
+            if (test_y_position > getFloatAlongDirection(DOWN, vec3FromInt3(e_in_stack->coords)))
+            {
+                // will only be here if e.falling, because otherwise would immediately be crossing a boundary
+                if (e_in_stack->id == PLAYER_ID)
                 {
-                    // will only be here if e.falling, because otherwise would immediately be crossing a boundary
-                    if (e_in_stack->id == PLAYER_ID)
+                    sim->player->velocity.y = test_y_velocity;
+                    sim->player->position.y = test_y_position;
+                    if (sim->temp_state.pack_attached)
                     {
-                        player->velocity.y = test_y_velocity;
-                        player->position.y = test_y_position;
-                        if (temp_state.pack_attached)
-                        {
-                            pack->velocity.y = test_y_velocity;
-                            pack->position.y = test_y_position;
-                        }
+                        sim->pack->velocity.y = test_y_velocity;
+                        sim->pack->position.y = test_y_position;
                     }
-                    else
-                    {
-                        e_in_stack->velocity.y = test_y_velocity;
-                        e_in_stack->position.y = test_y_position;
-                    }
-                    continue;
                 }
+                else
+                {
+                    e_in_stack->velocity.y = test_y_velocity;
+                    e_in_stack->position.y = test_y_position;
+                }
+                continue;
+            }
 
-                // anything here wants to fall across a tile boundary NOTE: red / blue stopping fall relies on calculating landing to true every frame, ard resetting position/velocity/falling to 0.
-                bool landing = false;
-                if (!canFall(e_in_stack)) landing = true;
-                if (temp_state.undo_press_timer > 0) landing = true;
+            // anything here wants to fall across a tile boundary NOTE: red / blue stopping fall relies on calculating landing to true every frame, ard resetting position/velocity/falling to 0.
+            bool landing = false;
+            if (!canFall(e_in_stack))
+            {
+                landing = true;
+                e_in_stack->support_checked_tick = sim->physics_tick_count;
+            }
+            if (sim->temp_state.undo_press_timer > 0) landing = true;
 
-                if (e_in_stack->id == PLAYER_ID && temp_state.player_hit_by_red) landing = true;
-                else if (e_in_stack->id != PLAYER_ID && temp_state.blue_gameplay_timer != 0) landing = true;
+            if (e_in_stack->id == PLAYER_ID && sim->temp_state.player_hit_by_red) landing = true;
+            else if (e_in_stack->id != PLAYER_ID && sim->temp_state.blue_gameplay_timer != 0) landing = true;
 
-                if (landing)
-                {
-                    e_in_stack->position.y = (float)e_in_stack->coords.y;
-                    e_in_stack->velocity.y = 0.0f;
-                    e_in_stack->falling = false;
+            if (landing)
+            {
+                e_in_stack->position.y = (float)e_in_stack->coords.y;
+                e_in_stack->velocity.y = 0.0f;
+                setEntityFalling(e_in_stack, false);
 
-                    if (e_in_stack == player && temp_state.pack_attached)
-                    {
-                        pack->position.y = (float)pack->coords.y;
-                        pack->velocity.y = 0.0f;
-                        pack->falling = false;
-                    }
-                    continue;
+                if (e_in_stack == sim->player && sim->temp_state.pack_attached)
+                {
+                    sim->pack->position.y = (float)sim->pack->coords.y;
+                    sim->pack->velocity.y = 0.0f;
+                    setEntityFalling(sim->pack, false);
                 }
+                continue;
+            }
 
-                // anything here will complete the fall
-                if (e_in_stack->id == PLAYER_ID)
+            // anything here will complete the fall
+            if (e_in_stack->id == PLAYER_ID)
+            {
+                if (!sim->temp_state.player_hit_by_red && sim->player->moving_direction == NO_DIRECTION)
                 {
-                    if (!temp_state.player_hit_by_red && player->moving_direction == NO_DIRECTION)
-                    {
-                        createTrailingHitbox(PLAYER_ID, player->coords, FALL_TRAILING_HITBOX_TIME);
-                        player->position.y = test_y_position;
-                        player->velocity.y = test_y_velocity;
-                        Int3 coords_below = getNextCoords(player->coords, DOWN);
-                        //Int3 coords_above = getNextCoords(player->coords, UP);
+                    createTrailingHitbox(PLAYER_ID, sim->player->coords, FALL_TRAILING_HITBOX_TIME);
+                    sim->player->position.y = test_y_position;
+                    sim->player->velocity.y = test_y_velocity;
+                    Int3 coords_below = getNextCoords(sim->player->coords, DOWN);
+                    //Int3 coords_above = getNextCoords(player->coords, UP);
 
-                        if (getTileType(coords_below) == TILE_TYPE_VOID)
+                    if (getTileType(coords_below) == TILE_TYPE_VOID)
+                    {
+                        setTileType(TILE_TYPE_NONE, sim->player->coords);
+                        setTileDirection(NO_DIRECTION, sim->player->coords, 0);
+                        sim->player->removed = true;
+                        wakeEntitiesAroundTile(sim->player->coords);
+                        if (sim->temp_state.pack_attached)
                         {
-                            setTileType(TILE_TYPE_NONE, player->coords);
-                            setTileDirection(NO_DIRECTION, player->coords, 0);
-                            player->removed = true;
-                            if (temp_state.pack_attached)
-                            {
-                                setTileType(TILE_TYPE_NONE, pack->coords);
-                                setTileDirection(NO_DIRECTION, pack->coords, 0);
-                                pack->removed = true;
-                            }
-                            continue;
+                            setTileType(TILE_TYPE_NONE, sim->pack->coords);
+                            setTileDirection(NO_DIRECTION, sim->pack->coords, 0);
+                            sim->pack->removed = true;
+                            wakeEntitiesAroundTile(sim->pack->coords);
                         }
+                        continue;
+                    }
 
-                        moveEntityInBufferAndState(player, coords_below, player->direction);
+                    moveEntityInBufferAndState(sim->player, coords_below, sim->player->direction);
 
-                        player->falling = true;
+                    setEntityFalling(sim->player, true);
 
-                        if (temp_state.pack_attached)
-                        {
-                            if (canFall(pack))
-                            {
-                                createTrailingHitbox(PACK_ID, pack->coords, FALL_TRAILING_HITBOX_TIME);
-                                pack->position.y = test_y_position;
-                                pack->velocity.y = test_y_velocity;
-                                Int3 pack_next_coords = getNextCoords(pack->coords, DOWN);
-                                moveEntityInBufferAndState(pack, pack_next_coords, pack->direction);
-                            }
-                            else
-                            {
-                                // pack will detach
-                                pack->position.y = (float)pack->coords.y;
-                                pack->velocity.y = 0;
-                                temp_state.pack_attached = false;
-                            }
-                        }
-                    }
-                }
-                else
-                {
-                    if (temp_state.blue_gameplay_timer == 0)
+                    if (sim->temp_state.pack_attached)
                     {
-                        createTrailingHitbox(e_in_stack->id, e_in_stack->coords, FALL_TRAILING_HITBOX_TIME);
-                        Int3 coords_below = getNextCoords(e_in_stack->coords, DOWN);
-                        if (getTileType(coords_below) == TILE_TYPE_VOID)
+                        if (canFall(sim->pack))
                         {
-                            // fell onto void: remove
-                            setTileType(TILE_TYPE_NONE, e_in_stack->coords);
-                            setTileDirection(NO_DIRECTION, e_in_stack->coords, 0);
-                            e_in_stack->removed = true;
+                            createTrailingHitbox(PACK_ID, sim->pack->coords, FALL_TRAILING_HITBOX_TIME);
+                            sim->pack->position.y = test_y_position;
+                            sim->pack->velocity.y = test_y_velocity;
+                            Int3 pack_next_coords = getNextCoords(sim->pack->coords, DOWN);
+                            moveEntityInBufferAndState(sim->pack, pack_next_coords, sim->pack->direction);
                         }
                         else
                         {
-                            e_in_stack->position.y = test_y_position;
-                            e_in_stack->velocity.y = test_y_velocity;
-                            e_in_stack->falling = true;
-                            moveEntityInBufferAndState(e_in_stack, coords_below, e_in_stack->direction);
+                            // pack will detach
+                            sim->pack->position.y = (float)sim->pack->coords.y;
+                            sim->pack->velocity.y = 0;
+                            sim->temp_state.pack_attached = false;
                         }
                     }
                 }
             }
+            else
+            {
+                if (sim->temp_state.blue_gameplay_timer == 0)
+                {
+                    createTrailingHitbox(e_in_stack->id, e_in_stack->coords, FALL_TRAILING_HITBOX_TIME);
+                    Int3 coords_below = getNextCoords(e_in_stack->coords, DOWN);
+                    if (getTileType(coords_below) == TILE_TYPE_VOID)
+                    {
+                        // fell onto void: remove
+                        setTileType(TILE_TYPE_NONE, e_in_stack->coords);
+                        setTileDirection(NO_DIRECTION, e_in_stack->coords, 0);
+                        e_in_stack->removed = true;
+                        wakeEntitiesAroundTile(e_in_stack->coords);
+                    }
+                    else
+                    {
+                        e_in_stack->position.y = test_y_position;
+                        e_in_stack->velocity.y = test_y_velocity;
+                        setEntityFalling(e_in_stack, true);
+                        moveEntityInBufferAndState(e_in_stack, coords_below, e_in_stack->direction);
+                    }
+                }
+            }
         }
     }
 
@@ -3608,24 +4330,24 @@ void doPhysicsTick()
     for (Direction direction_index = NORTH; direction_index < UP; direction_index++) 
     {
         // only handle velocity / position if offset from the coords
-        Vec3 difference_in_player_position = vec3Subtract(vec3FromInt3(player->coords), player->position);
+        Vec3 difference_in_player_position = vec3Subtract(vec3FromInt3(sim->player->coords), sim->player->position);
         float difference_in_position_along_direction = getFloatAlongDirection(direction_index, difference_in_player_position);
         float sign = direction_index == NORTH || direction_index == WEST ? -1.0f : 1.0f;
         if (difference_in_position_along_direction * sign <= 0) continue; // will continue if west picks up a difference in the east direction (and north in south direction)
 
-        float position_along_direction = getFloatAlongDirection(direction_index, player->position);
-        float coords_along_direction = getFloatAlongDirection(direction_index, vec3FromInt3(player->coords));
+        float position_along_direction = getFloatAlongDirection(direction_index, sim->player->position);
+        float coords_along_direction = getFloatAlongDirection(direction_index, vec3FromInt3(sim->player->coords));
         float speculative_velocity_along_direction = calculateSpeculativeVelocityAlongDirection(direction_index, sign);
         if (!wouldOvershoot(speculative_velocity_along_direction, position_along_direction, coords_along_direction, sign))
         {
             // no overshooting: accelerate fully
-            if (direction_index == NORTH || direction_index == SOUTH) player->velocity.z = speculative_velocity_along_direction;
-            else player->velocity.x = speculative_velocity_along_direction;
-            player->position = vec3Add(player->position, player->velocity);
+            if (direction_index == NORTH || direction_index == SOUTH) sim->player->velocity.z = speculative_velocity_along_direction;
+            else sim->player->velocity.x = speculative_velocity_along_direction;
+            sim->player->position = vec3Add(sim->player->position, sim->player->velocity);
         }
         else
         {
-            float current_speed = sign * getFloatAlongDirection(direction_index, player->velocity);
+            float current_speed = sign * getFloatAlongDirection(direction_index, sim->player->velocity);
             float remaining_distance = sign * difference_in_position_along_direction;
             float stopping_distance = oneDimensionalDecelerationSimulation(current_speed, PLAYER_MAX_DECELERATION);
             float distance_error = remaining_distance - stopping_distance;
@@ -3639,23 +4361,23 @@ void doPhysicsTick()
             // move position by velocity + adjustment, then set velocity to decelerated value
             float actual_movement = current_speed + movement_adjustment;
 
-            player->position = vec3AddFloatAlongDirection(direction_index, sign * actual_movement, player->position);
-            if (direction_index == NORTH || direction_index == SOUTH) player->velocity.z = sign * decelerated_speed;
-            else player->velocity.x = sign * decelerated_speed;
+            sim->player->position = vec3AddFloatAlongDirection(direction_index, sign * actual_movement, sim->player->position);
+            if (direction_index == NORTH || direction_index == SOUTH) sim->player->velocity.z = sign * decelerated_speed;
+            else sim->player->velocity.x = sign * decelerated_speed;
         }
-        player->moving_direction = direction_index;
+        sim->player->moving_direction = direction_index;
     }
-    if (vec3IsZero(player->velocity)) player->moving_direction = NO_DIRECTION;
+    if (vec3IsZero(sim->player->velocity)) sim->player->moving_direction = NO_DIRECTION;
 
     // handle rotation
     {
         // player rotation
-        Vec4 previous_player_rotation = player->rotation;
+        Vec4 previous_player_rotation = sim->player->rotation;
 
-        float frame_count = ceilf(floatAbs(player->yaw_offset) / MAX_ANGULAR_VELOCITY - 1e-3f);
-        if (frame_count <= 1) player->yaw_offset = 0.0f;
-        else                  player->yaw_offset -= player->yaw_offset / frame_count;
-        player->rotation = composeRotation(player->direction, MIRROR_SIDE, player->yaw_offset, player->visual_tilt);
+        float frame_count = ceilf(floatAbs(sim->player->yaw_offset) / MAX_ANGULAR_VELOCITY - 1e-3f);
+        if (frame_count <= 1) sim->player->yaw_offset = 0.0f;
+        else                  sim->player->yaw_offset -= sim->player->yaw_offset / frame_count;
+        sim->player->rotation = composeRotation(sim->player->direction, MIRROR_SIDE, sim->player->yaw_offset, getEntityVisuals(sim->player)->visual_tilt);
 
         // pack rotation and movement
 
@@ -3669,24 +4391,24 @@ void doPhysicsTick()
         bool pack_mimic_position_in_travel_direction = false;
         bool pack_mimic_rotation = false;
 
-        if (temp_state.pack_attached)
+        if (sim->temp_state.pack_attached)
         {
-            if (vec4IsEqual(previous_player_rotation, pack->rotation) || temp_state.pack_turn_state.pack_intermediate_states_timer > 0)
+            if (vec4IsEqual(previous_player_rotation, sim->pack->rotation) || sim->temp_state.pack_turn_state.pack_intermediate_states_timer > 0)
             {
                 // if pack was right behind player on last rotation, mimic fully
                 // if pack is currently in a turn, also mimic fully; this handles cases with not-quite-full turns
                 pack_mimic_rotation = true;
                 pack_mimic_position = true;
             }
-            else if (player->moving_direction != NO_DIRECTION)
+            else if (sim->player->moving_direction != NO_DIRECTION)
             {
                 // if player moving away but above didn't trigger (i.e. 'shouldn't really attach yet'), then just take pack with right behind, but keep rotation decoupled 
                 // will only happen if player is somewhat far away from target; without that gate, will cause trigger on move-into-turn, not just turn-into-move.
-                float difference_in_player_position_along_direction = getFloatAlongDirection(player->direction, vec3Subtract(player->position, vec3FromInt3(player->coords)));
+                float difference_in_player_position_along_direction = getFloatAlongDirection(sim->player->direction, vec3Subtract(sim->player->position, vec3FromInt3(sim->player->coords)));
                 if (difference_in_player_position_along_direction > 0.5f) pack_mimic_position_in_travel_direction = true;
             }
         }
-        else if (temp_state.pack_turn_state.pack_intermediate_states_timer > 0)
+        else if (sim->temp_state.pack_turn_state.pack_intermediate_states_timer > 0)
         {
             // pack has detached, but should still be rotating: player is falling, and that has caused pack detach. keep rotation and movement, but stay at same y level
             pack_mimic_position_without_y = true;
@@ -3694,190 +4416,437 @@ void doPhysicsTick()
         }
 
         Vec3 maybe_new_pack_position = getPositionBehindPlayer();
-        if (pack_mimic_position) pack->position = maybe_new_pack_position;
-        else if (pack_mimic_position_without_y) pack->position = vec3SetFloatAlongDirection(UP, pack->position.y, maybe_new_pack_position);
-        else if (pack_mimic_position_in_travel_direction) pack->position = vec3SetFloatAlongDirection(player->moving_direction, getFloatAlongDirection(player->moving_direction, maybe_new_pack_position), vec3FromInt3(pack->coords));
+        if (pack_mimic_position) sim->pack->position = maybe_new_pack_position;
+        else if (pack_mimic_position_without_y) sim->pack->position = vec3SetFloatAlongDirection(UP, sim->pack->position.y, maybe_new_pack_position);
+        else if (pack_mimic_position_in_travel_direction) sim->pack->position = vec3SetFloatAlongDirection(sim->player->moving_direction, getFloatAlongDirection(sim->player->moving_direction, maybe_new_pack_position), vec3FromInt3(sim->pack->coords));
 
-        if (pack_mimic_rotation) pack->rotation = player->rotation;
+        if (pack_mimic_rotation) sim->pack->rotation = sim->player->rotation;
 
         // decrement pack turn state timer here (used for edge cases above)
-        if (temp_state.pack_turn_state.pack_intermediate_states_timer > 0) temp_state.pack_turn_state.pack_intermediate_states_timer--;
+        if (sim->temp_state.pack_turn_state.pack_intermediate_states_timer > 0) sim->temp_state.pack_turn_state.pack_intermediate_states_timer--;
     }
 
-    // handle moving entities and some visual effects
-    FOR(group_index, 4)
+    // handle moving entities and some visual effects. pushes are gathered into movement_lanes and integrated together after this loop
+    sim->movement_lanes.count = 0;
+    int32 move_cursor = -1;
+    for (Entity* e = nextActiveEntity(&move_cursor); e != 0; e = nextActiveEntity(&move_cursor))
     {
-        FOR(entity_index, MAX_ENTITY_INSTANCE_COUNT)
+        if (e == sim->player) continue;
+        if (e == sim->pack && sim->temp_state.pack_attached) break;
+
+        // NOTE: there is some jankiness in new (and old) system, in that one move_type isn't enough info to get actual state 
+        //       of entity, because an entity can be moving on head and rotating on head at the same time, for example. 
+        //       so i then need some code in those cases to check for if the other thing is happening and deal with it.
+        //       similarly, in follow_vertical, need to check if climbing up, and in that case mimic rotation.
+        //
+        //       a better system could be to have tags for each of the possible moves, because then can encode that info.
+        //       then go through them all, and what they handle is decoupled: move would only ever handle translation, 
+        //       and rotation would only ever handle rotations. downside is needing to manage individual tags for 
+        //       each case, but this is probably fine?
+
+        // TODO: velocity doesn't seem to be updated consistently. will probably just find out about this as i do visual effects.
+
+        switch (e->move_type)
         {
-            if (group_index == 3 && (entity_index > 0 || temp_state.pack_attached)) break;
+            case MOVE_TYPE_PUSH_BY_PLAYER:
+            case MOVE_TYPE_PUSH_BY_PACK:
+            case MOVE_TYPE_PUSH_ON_HEAD:
+            {
+                if (e->move_type == MOVE_TYPE_PUSH_BY_PACK && sim->temp_state.pack_turn_state.half_failed_turn_timer != 0)
+                {
+                    // half turn caused decoupling from pack
+                    interpolateDecoupledTowardsCoords(e);
+                    continue;
+                }
 
-            Entity* e;
-            if (group_index == 3) e = pack;
-            else e = &interactible_entity_groups[group_index][entity_index];
+                Entity* root_e;
+                if (e->move_type == MOVE_TYPE_PUSH_BY_PACK) root_e = sim->pack;
+                else root_e = sim->player;
+                gatherMovementLane(&sim->movement_lanes, e, root_e);
+            }
+            break;
+            case MOVE_TYPE_ROTATE_ON_HEAD:
+            {
+                if (sim->player->yaw_offset == 0.0f)
+                {
+                    clearMovementState(e);
+                    continue;
+                }
+                e->yaw_offset = sim->player->yaw_offset;
+                e->rotation = composeRotation(e->direction, e->mirror_orientation, e->yaw_offset, getEntityVisuals(e)->visual_tilt);
+
+                // below is to see if should copy player coords. check coords behind player at same y as entity. if entity is there, then they weren't allow to come with, so dont mimic player coords.
+                Int3 previous_player_coords = getNextCoords(sim->player->coords, oppositeDirection(sim->player->direction));
+                Int3 previous_player_coords_with_moving_entity_y = int3FromVec3(vec3SetFloatAlongDirection(UP, (float)e->coords.y, vec3FromInt3(previous_player_coords)));
+                Entity* e_exists_if_no_push = getEntityAtCoords(previous_player_coords_with_moving_entity_y);
+                if (!(e_exists_if_no_push && e_exists_if_no_push->id == e->id))
+                {
+                    e->position.x = sim->player->position.x;
+                    e->position.z = sim->player->position.z;
+                }
+            }
+            break;
+            case MOVE_TYPE_FOLLOW_VERTICAL: // always follows players movement, even if it happens to be caused by the pack.
+            {
+                float root_coords_along_y = getFloatAlongDirection(e->moving_direction, vec3FromInt3(sim->player->coords));
+                float root_position_along_y = getFloatAlongDirection(e->moving_direction, sim->player->position);
+                float entity_coords_along_y = getFloatAlongDirection(e->moving_direction, vec3FromInt3(e->coords));
+                float difference_in_coords = entity_coords_along_y - root_coords_along_y;
+                float entity_target = root_position_along_y + difference_in_coords;
+                e->position = vec3SetFloatAlongDirection(UP, entity_target, e->position);
+
+                if (vec3IsEqual(e->position, vec3FromInt3(e->coords))) clearMovementState(e);
+            }
+            break;
+        }
+    }
+    integrateMovementLanes(&sim->movement_lanes);
+    scatterMovementLanes(&sim->movement_lanes, do_animations);
 
-            // NOTE: there is some jankiness in new (and old) system, in that one move_type isn't enough info to get actual state 
-            //       of entity, because an entity can be moving on head and rotating on head at the same time, for example. 
-            //       so i then need some code in those cases to check for if the other thing is happening and deal with it.
-            //       similarly, in follow_vertical, need to check if climbing up, and in that case mimic rotation.
-            //
-            //       a better system could be to have tags for each of the possible moves, because then can encode that info.
-            //       then go through them all, and what they handle is decoupled: move would only ever handle translation, 
-            //       and rotation would only ever handle rotations. downside is needing to manage individual tags for 
-            //       each case, but this is probably fine?
+    // decrement and clear trailing hitboxes 
+    // TODO: a bit unclear why the forward prediction fails to snap if trailing hitbox is ahead. not really a problem, but feels unexpected
+    FOR(th_index, MAX_TRAILING_HITBOX_COUNT) 
+    {
+        TrailingHitbox* th = &sim->temp_state.trailing_hitboxes[th_index];
+        if (th->frames > 0)
+        {
+            th->frames--;
+            if (th->frames == 0) markColumnChanged(th->coords); // anything held up only by this hitbox may now fall
+        }
+        if (th->frames == 0) memset(&sim->temp_state.trailing_hitboxes[th_index], 0, sizeof(TrailingHitbox));
+    }
 
-            // TODO: velocity doesn't seem to be updated consistently. will probably just find out about this as i do visual effects.
+    // decrement various timers
+    if (sim->temp_state.undo_press_timer > 0) sim->temp_state.undo_press_timer--;
+    if (sim->temp_state.allow_movement_timer > 0) sim->temp_state.allow_movement_timer--;
+    if (sim->temp_state.pack_turn_state.half_failed_turn_timer > 0) sim->temp_state.pack_turn_state.half_failed_turn_timer--;
+    if (sim->temp_state.blue_gameplay_timer > 0) sim->temp_state.blue_gameplay_timer--;
 
-            switch (e->move_type)
-            {
-                case MOVE_TYPE_PUSH_BY_PLAYER:
-                case MOVE_TYPE_PUSH_BY_PACK:
-                case MOVE_TYPE_PUSH_ON_HEAD:
-                {
-                    Entity* root_e;
-                    if (e->move_type == MOVE_TYPE_PUSH_BY_PACK) root_e = pack;
-                    else root_e = player;
+    // disallow input if player at bottom of world
+    Int3 coords_below_player = getNextCoords(sim->player->coords, DOWN);
+    if (!intCoordsWithinLevelBounds(coords_below_player)) sim->temp_state.allow_movement_timer = -1;
 
-                    float sign = e->moving_direction == NORTH || e->moving_direction == WEST ? -1.0f : 1.0f;
+    // update lasers based on physics
+    updateLaserBuffer();
 
-                    float root_coords_along_direction     = getFloatAlongDirection(e->moving_direction, vec3FromInt3(root_e->coords));
-                    float root_position_along_direction   = getFloatAlongDirection(e->moving_direction, root_e->position);
-                    float entity_coords_along_direction   = getFloatAlongDirection(e->moving_direction, vec3FromInt3(e->coords));
-                    float entity_position_along_direction = getFloatAlongDirection(e->moving_direction, e->position);
-                    float difference_in_coords = entity_coords_along_direction - root_coords_along_direction;
+    sleepSettledEntities();
+}
 
-                    if (e->move_type == MOVE_TYPE_PUSH_BY_PACK && temp_state.pack_turn_state.half_failed_turn_timer != 0)
-                    {
-                        // half turn caused decoupling from pack
-                        interpolateDecoupledTowardsCoords(e);
-                        continue;
-                    }
+// TURBO RESOLVE
 
-                    float entity_target = root_position_along_direction + difference_in_coords;
+bool entityIsSettled(Entity* e)
+{
+    if (!e->in_use || e->removed) return true;
+    if (e->move_type != MOVE_TYPE_NONE || e->moving_direction != NO_DIRECTION || e->falling) return false;
+    return vec3IsZero(e->velocity) && vec3IsEqual(e->position, vec3FromInt3(e->coords));
+}
 
-                    bool moving_backwards = sign * entity_target < sign * entity_position_along_direction;
-                    bool moving_too_far   = sign * entity_target > sign * entity_position_along_direction + 0.5f;
-                    if (moving_backwards || moving_too_far)
-                    {
-                        // attempting to travel backwards. could be smarter here, but because of player deceleration being relatively high, clearing just works
-                        clearMovementState(e);
-                        continue;
-                    }
+// true once nothing more can happen without new input. only looks at state that feeds back into gameplay, so settle tilts etc. can still be running
+bool simulationSettled()
+{
+    if (!entityIsSettled(sim->player) || !entityIsSettled(sim->pack)) return false;
+    if (sim->player->yaw_offset != 0.0f) return false;
+    FOR(active_index, sim->active_entities.count) if (!entityIsSettled(getEntityFromSlot(sim->active_entities.slots[active_index]))) return false;
 
-                    if (e->move_type == MOVE_TYPE_PUSH_ON_HEAD)
-                    {
-                        // copy rotation of player if on head
-                        e->yaw_offset = player->yaw_offset;
-                        e->rotation = composeRotation(e->direction, e->mirror_orientation, e->yaw_offset, e->visual_tilt);
-                    }
+    if (sim->temp_state.pack_turn_state.pack_intermediate_states_timer > 0) return false;
+    if (sim->temp_state.pack_turn_state.half_failed_turn_timer > 0) return false;
+    if (sim->temp_state.undo_press_timer > 0 || sim->temp_state.allow_movement_timer > 0) return false;
+    if (sim->temp_state.blue_gameplay_timer != 0 && sim->temp_state.blue_gameplay_timer != MAX_BLUE_GAMEPLAY_TIME) return false; // still wearing off
+    FOR(th_index, MAX_TRAILING_HITBOX_COUNT) if (sim->temp_state.trailing_hitboxes[th_index].frames > 0) return false;
+    return true;
+}
 
-                    Vec3 old_position = e->position;
-                    e->position = vec3SetFloatAlongDirection(e->moving_direction, entity_target, vec3FromInt3(e->coords));
-                    e->velocity = vec3Subtract(e->position, old_position);
-                    if (vec3Length(e->velocity) > vec3Length(e->settle_velocity)) e->settle_velocity = e->velocity;
+// runs the same physics ticks the animated path would, back to back with nothing drawn in between, until the move has fully played out.
+// the discrete result (buffer, coords, directions, lasers) is identical by construction, since it is the same code; only the wall clock time
+// and the per tick animations are skipped. afterwards, any remaining purely visual state is dropped so entities are drawn at rest.
+// takes at most turbo_resolve_frame_budget ticks per frame; returns false if the resolve has to carry on next frame
+bool continueDiscreteResolve()
+{
+    while (!simulationSettled() && turbo_resolve_ticks < MAX_TURBO_RESOLVE_TICKS)
+    {
+        if (turbo_resolve_frame_budget == 0) return false;
+        doPhysicsTick(false);
+        turbo_resolve_ticks++;
+        turbo_resolve_frame_budget--;
+    }
+    turbo_resolve_pending = false;
+    if (turbo_resolve_ticks == MAX_TURBO_RESOLVE_TICKS) return true; // still going, so leave it to the normal ticks
 
-                    // handle visual tilt
-                    bool do_visual_tilt = true;
-                    if (e->move_type != MOVE_TYPE_PUSH_BY_PLAYER && e->move_type != MOVE_TYPE_PUSH_BY_PACK) do_visual_tilt = false;
-                    if (visual_effects.blue_visual_timer <= 0) do_visual_tilt = false;
-                    if (do_visual_tilt)
-                    {
-                        float target_angle = vec3Length(e->settle_velocity) * VELOCITY_TO_TILT_RADIANS;
-                        float tilt_difference = target_angle - e->tilt_angle;
-                        /*
-                        if (tilt_difference < 0.0f) tilt_difference = 0.0f; // tilt wants to decrease; don't allow
-                        if (tilt_difference > MAX_TILT_PER_FRAME) tilt_difference = MAX_TILT_PER_FRAME;
-                        */
-                        e->tilt_angle += tilt_difference;
-                    }
+    clearMovementState(sim->player);
+    clearMovementState(sim->pack);
+    FOR(active_index, sim->active_entities.count) clearMovementState(getEntityFromSlot(sim->active_entities.slots[active_index]));
+    sleepSettledEntities();
+    return true;
+}
 
-                    if (vec3IsEqual(e->position, vec3FromInt3(e->coords)))
-                    {
-                        // TODO: settle handling
-                        clearMovementState(e);
-                    }
+void resolveDiscreteOutcome()
+{
+    turbo_resolve_pending = true;
+    turbo_resolve_ticks = 0;
+    continueDiscreteResolve();
+}
+
+void overworldPositionState(GameProgress progress, Int3 coords, float y_offset)
+{
+    if (game_progress < progress) game_progress = progress;
+    overworld_restart_coords = coords;
+    camera_overworld_y_offset = y_offset;
+}
+
+// INPUT QUEUE
+
+void queueMovementInput(Direction direction)
+{
+    if (input_queue.count == MAX_QUEUED_INPUTS) return; // more already queued than could be played out before expiring
+    input_queue.inputs[input_queue.count].direction = direction;
+    input_queue.inputs[input_queue.count].press_tick = sim->physics_tick_count;
+    input_queue.count++;
+}
+
+void popQueuedInput()
+{
+    if (input_queue.count == 0) return;
+    memmove(&input_queue.inputs[0], &input_queue.inputs[1], (input_queue.count - 1) * sizeof(QueuedInput));
+    input_queue.count--;
+}
+
+void expireQueuedInputs()
+{
+    while (input_queue.count > 0 && sim->physics_tick_count - input_queue.inputs[0].press_tick >= INPUT_QUEUE_EXPIRY_TICKS) popQueuedInput();
+}
+
+void clearInputQueue()
+{
+    memset(&input_queue, 0, sizeof(InputQueue));
+}
+
+// tries to apply a movement input to the current state. returns false if the player isn't in a state to accept this input yet.
+// a move that is accepted but goes nowhere (e.g. walking into a wall) still counts as allowed, so that the input is used up.
+bool tryMovementInput(Direction input_direction)
+{
+    bool input_allowed = true;
+
+    if (sim->temp_state.allow_movement_timer != 0) input_allowed = false;
+    if (sim->player->removed) input_allowed = false;
+
+    // gate on how close player is to completing rotation
+    if (floatAbs(sim->player->yaw_offset) > TAU * 0.25 * MAX_QUARTER_TURN_ANGLE_ALLOWED_FOR_MOVEMENT) input_allowed = false;
+
+    // if able to fall then don't allow movement
+    bool player_immune_to_fall = false;
+    if (sim->temp_state.player_hit_by_red) player_immune_to_fall = true;
+    if (sim->player->moving_direction == UP) player_immune_to_fall = true;
+    if (canFall(sim->player) && !player_immune_to_fall) input_allowed = false;
+
+    if (input_direction == sim->player->direction)
+    {
+        // FORWARD MOVEMENT
+        // allow movement if, given acceleration this frame along input direction, we would overshoot.
+        float sign = input_direction == NORTH || input_direction == WEST ? -1.0f : 1.0f;
+        float speculative_velocity_along_direction = calculateSpeculativeVelocityAlongDirection(input_direction, sign);
+        float position_along_direction = getFloatAlongDirection(input_direction, sim->player->position);
+        float coords_along_direction = getFloatAlongDirection(input_direction, vec3FromInt3(sim->player->coords));
+        if (!wouldOvershoot(speculative_velocity_along_direction, position_along_direction, coords_along_direction, sign)) input_allowed = false;
+
+        // disallow movement if also moving in some other direction currently - probably just guards against moving while falling
+        if (!vec3IsZero(vec3SetFloatAlongDirection(input_direction, 0, sim->player->velocity))) input_allowed = false;
+
+        // disallow movement forward if climbing UP. likely doesn't actually matter, would just be walking into a ladder
+        if (sim->player->moving_direction == UP) input_allowed = false;
+
+        if (input_allowed)
+        {
+            bool do_walk = false;
+            bool do_push = false;
+            bool try_climb = false;
+
+            Int3 next_player_coords = getNextCoords(sim->player->coords, input_direction);
+            TileType next_tile = getTileType(next_player_coords);
+
+            switch (next_tile)
+            {
+                case TILE_TYPE_NONE:
+                {
+                    // NOTE: currently not allowing input if trailing hitbox occupies next tile. this check might be too strict sometimes
+                    TrailingHitbox th = {0};
+                    if (trailingHitboxAtCoords(next_player_coords, &th)) do_walk = false;
+                    else do_walk = true;
                 }
                 break;
-                case MOVE_TYPE_ROTATE_ON_HEAD:
+                case TILE_TYPE_BOX:
+                case TILE_TYPE_PACK:
+                case TILE_TYPE_MIRROR:
+                case TILE_TYPE_SOURCE_RED:
+                case TILE_TYPE_SOURCE_BLUE:
+                case TILE_TYPE_SOURCE_MAGENTA:
                 {
-                    if (player->yaw_offset == 0.0f)
+                    if (canPush(next_player_coords, input_direction))
                     {
-                        clearMovementState(e);
-                        continue;
-                    }
-                    e->yaw_offset = player->yaw_offset;
-                    e->rotation = composeRotation(e->direction, e->mirror_orientation, e->yaw_offset, e->visual_tilt);
-
-                    // below is to see if should copy player coords. check coords behind player at same y as entity. if entity is there, then they weren't allow to come with, so dont mimic player coords.
-                    Int3 previous_player_coords = getNextCoords(player->coords, oppositeDirection(player->direction));
-                    Int3 previous_player_coords_with_moving_entity_y = int3FromVec3(vec3SetFloatAlongDirection(UP, (float)e->coords.y, vec3FromInt3(previous_player_coords)));
-                    Entity* e_exists_if_no_push = getEntityAtCoords(previous_player_coords_with_moving_entity_y);
-                    if (!(e_exists_if_no_push && e_exists_if_no_push->id == e->id))
-                    {
-                        e->position.x = player->position.x;
-                        e->position.z = player->position.z;
+                        do_push = true;
+                        do_walk = true;
                     }
                 }
                 break;
-                case MOVE_TYPE_FOLLOW_VERTICAL: // always follows players movement, even if it happens to be caused by the pack.
+                case TILE_TYPE_LADDER:
+                {
+                    bool ladder_facing_player = getTileDirection(next_player_coords) == oppositeDirection(sim->player->direction);
+                    bool player_at_correct_location = vec3IsEqual(sim->player->position, vec3FromInt3(sim->player->coords));
+                    if (ladder_facing_player && player_at_correct_location) try_climb = true;
+                    break;
+                }
+                default:
                 {
-                    float root_coords_along_y = getFloatAlongDirection(e->moving_direction, vec3FromInt3(player->coords));
-                    float root_position_along_y = getFloatAlongDirection(e->moving_direction, player->position);
-                    float entity_coords_along_y = getFloatAlongDirection(e->moving_direction, vec3FromInt3(e->coords));
-                    float difference_in_coords = entity_coords_along_y - root_coords_along_y;
-                    float entity_target = root_position_along_y + difference_in_coords;
-                    e->position = vec3SetFloatAlongDirection(UP, entity_target, e->position);
-
-                    if (vec3IsEqual(e->position, vec3FromInt3(e->coords))) clearMovementState(e);
                 }
                 break;
             }
+
+            if (do_walk)
+            {
+                // NOTE: trying out allowing walking off edge
+                recordActionForUndo(&sim->world_state);
+                if (do_push) pushAll(next_player_coords, input_direction, MOVE_TYPE_PUSH_BY_PLAYER, sim->temp_state.blue_gameplay_timer == 0);
+                doStandardMovement(input_direction, next_player_coords);
+            }
+            else if (try_climb)
+            {
+                // TODO: move try_climb logic inside ladder case, and have this just be do_climb
+                // only handles setting climbing direction to UP if player wants to climb up. everything else is handled later, 
+                // because i want to keep climbing sometimes, even if there's been no input for it.
+                Int3 coords_above_player = getNextCoords(sim->player->coords, UP);
+                TileType type_above_player = getTileType(coords_above_player);
+
+                bool do_climb = false; 
+                if (type_above_player == TILE_TYPE_NONE) do_climb = true;
+                else if (isPushable(type_above_player) && canPushVertical(coords_above_player, UP)) do_climb = true;
+                if (do_climb)
+                {
+                    recordActionForUndo(&sim->world_state);
+                    sim->player->moving_direction = UP;
+                }
+            }
+
+            return true;
         }
     }
-
-    // decrement and clear trailing hitboxes 
-    // TODO: a bit unclear why the forward prediction fails to snap if trailing hitbox is ahead. not really a problem, but feels unexpected
-    FOR(th_index, MAX_TRAILING_HITBOX_COUNT) 
+    else if (input_direction != oppositeDirection(sim->player->direction))
     {
-        TrailingHitbox* th = &temp_state.trailing_hitboxes[th_index];
-        if (th->frames > 0) th->frames--;
-        if (th->frames == 0) memset(&temp_state.trailing_hitboxes[th_index], 0, sizeof(TrailingHitbox));
-    }
+        // TURN MOVEMENT
+        if (sim->player->falling) input_allowed = false; // TODO: check if required
+        if (sim->player->moving_direction == UP) input_allowed = false;
+        
+        // get difference in position along axis of travel, and gate on some threshold to target
+        float difference_in_player_position_along_direction = getFloatAlongDirection(sim->player->direction, vec3Subtract(sim->player->position, vec3FromInt3(sim->player->coords)));
+        if (fabs(difference_in_player_position_along_direction) > MAX_POSITION_DIFFERENCE_ALLOWED_FOR_MOVEMENT) input_allowed = false;
+
+        if (sim->temp_state.pack_attached)
+        {
+            // check if would cause half-failed case, and if so check if we already had one of those, and if so disallow turn
+            // this defeats half the point of how i handle failed case later... but need to know now!
+            Int3 orthogonal_coords = getNextCoords(sim->player->coords, oppositeDirection(input_direction));
+            TileType orthogonal_type = getTileType(orthogonal_coords);
+            bool pack_would_cause_failed_case_orthogonal = orthogonal_type != TILE_TYPE_NONE && (!isEntity(orthogonal_type) || canPush(orthogonal_coords, sim->player->direction));
+            if (pack_would_cause_failed_case_orthogonal && sim->temp_state.pack_turn_state.half_failed_turn_timer != 0) input_allowed = false;
+        }
 
-    // decrement various timers
-    if (temp_state.undo_press_timer > 0) temp_state.undo_press_timer--;
-    if (temp_state.allow_movement_timer > 0) temp_state.allow_movement_timer--;
-    if (temp_state.pack_turn_state.half_failed_turn_timer > 0) temp_state.pack_turn_state.half_failed_turn_timer--;
-    if (temp_state.blue_gameplay_timer > 0) temp_state.blue_gameplay_timer--;
+        if (input_allowed)
+        {
+            recordActionForUndo(&sim->world_state);
 
-    // disallow input if player at bottom of world
-    Int3 coords_below_player = getNextCoords(player->coords, DOWN);
-    if (!intCoordsWithinLevelBounds(coords_below_player)) temp_state.allow_movement_timer = -1;
+            Direction initial_player_direction = sim->player->direction;
+            sim->player->direction = input_direction;
+            setTileDirection(sim->player->direction, sim->player->coords, 0);
 
-    // update lasers based on physics
-    updateLaserBuffer();
+            sim->player->yaw_offset += directionAngleY(initial_player_direction) - directionAngleY(input_direction);
+            if (sim->player->yaw_offset >  0.5 * TAU) sim->player->yaw_offset -= TAU;
+            if (sim->player->yaw_offset < -0.5 * TAU) sim->player->yaw_offset += TAU;
+
+            if (sim->temp_state.pack_attached)
+            {
+                int32 rotation_frames = (int32)ceilf(floatAbs(sim->player->yaw_offset) / MAX_ANGULAR_VELOCITY - 1e-3f);
+                sim->temp_state.pack_turn_state.pack_intermediate_states_timer = rotation_frames;
+                sim->temp_state.pack_turn_state.turn_total_frames = rotation_frames;
+                sim->temp_state.pack_turn_state.pack_intermediate_coords = getNextCoords(sim->pack->coords, oppositeDirection(input_direction));
+                sim->temp_state.pack_turn_state.initial_player_direction = initial_player_direction;
+            }
+
+            // if not blue, rotate objects stacked above the player
+            if (sim->temp_state.blue_gameplay_timer == 0)
+            {
+                Int3 coords_above = getNextCoords(sim->player->coords, UP);
+                TileType type_above = getTileType(coords_above);
+
+                int32 stack_size = 0;
+                if (isPushable(type_above)) stack_size = getPushableStackSize(coords_above, UP);
+
+                // need to add either 1 or -1 to direction of entity being rotated
+                if (stack_size > 0)
+                {
+                    int32 direction_add = (4 + sim->player->direction - initial_player_direction) % 4;
+                    Int3 current_coords = coords_above;
+
+                    FOR(stack_index, stack_size)
+                    {
+                        Entity* e = getEntityAtCoords(current_coords);
+                        e->direction = (e->direction + direction_add - NORTH) % 4 + NORTH;
+                        e->moving_direction = NO_DIRECTION;
+                        e->move_type = MOVE_TYPE_ROTATE_ON_HEAD;
+                        wakeEntity(e);
+
+                        current_coords = getNextCoords(current_coords, UP);
+                    }
+                }
+            }
+            return true;
+        }
+    }
+
+    return input_allowed;
 }
 
-void overworldPositionState(GameProgress progress, Int3 coords, float y_offset)
+// replays a level with seeded movement (and the odd undo), with the falling pass checking every entity the column gate skips against the
+// full scan, and returns how many times the two disagreed. the input is a fixed xorshift sequence, so a level always replays the same way
+int32 gameFallGatingCheck(char* level_name, int32 tick_count, uint32 seed)
 {
-    if (game_progress < progress) game_progress = progress;
-    overworld_restart_coords = coords;
-    camera_overworld_y_offset = y_offset;
+    initUndoBuffer(); // so undos stay within this level
+    initializeLevel(level_name);
+    verify_fall_gating = true;
+    fall_gating_mismatches = 0;
+
+    uint32 random_state = seed;
+    FOR(tick_index, tick_count)
+    {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+
+        if (random_state % 64 == 0)
+        {
+            if (performUndo())
+            {
+                sim->temp_state.undo_press_timer = 6;
+                sim->temp_state.allow_movement_timer = 6;
+            }
+        }
+        else tryMovementInput(NORTH + (random_state >> 8) % 4);
+
+        doPhysicsTick(false);
+    }
+
+    verify_fall_gating = false;
+    return fall_gating_mismatches;
 }
 
 GameResult gameFrame(double delta_time, Input* input)
 {   
     // TEMP: for profiling
     long long frequency;
-    long long t_start, t_after_reload, t_after_input, t_after_physics, t_after_saving, t_after_game, t_after_submit, t_after_draw;
+    long long t_start, t_after_input, t_after_physics, t_after_saving, t_after_game;
     QueryPerformanceFrequency(&frequency);
     QueryPerformanceCounter(&t_start);
 
-    // reload all models changed on disk
-    vulkanReloadChangedModels();
-    QueryPerformanceCounter(&t_after_reload);
-
     if (delta_time > 0.1) delta_time = 0.1;
     physics_accumulator += delta_time;
+    turbo_resolve_frame_budget = MAX_TURBO_RESOLVE_TICKS_PER_FRAME;
 
     draw_command_count = 0;
 
@@ -3947,8 +4916,8 @@ GameResult gameFrame(double delta_time, Input* input)
     {
         char (*writing_to_field)[64] = 0;
         Entity* e = getEntityFromId(editor_state.selected_id);
-        if      (editor_state.writing_field == WRITING_FIELD_NEXT_LEVEL)  writing_to_field = &e->next_level;
-        else if (editor_state.writing_field == WRITING_FIELD_UNLOCKED_BY) writing_to_field = &e->unlocked_by;
+        if      (editor_state.writing_field == WRITING_FIELD_NEXT_LEVEL)  writing_to_field = &getEntityMetadata(e)->next_level;
+        else if (editor_state.writing_field == WRITING_FIELD_UNLOCKED_BY) writing_to_field = &getEntityMetadata(e)->unlocked_by;
 
         if (input->keys_pressed & KEY_ENTER)
         {
@@ -3994,6 +4963,7 @@ GameResult gameFrame(double delta_time, Input* input)
                 }
                 setTileType(TILE_TYPE_NONE, raycast_output.hit_coords);
                 setTileDirection(NORTH, raycast_output.hit_coords, 0);
+                wakeEntitiesAroundTile(raycast_output.hit_coords);
 
                 time_until_allow_meta_input = PLACE_BREAK_TIME_UNTIL_ALLOW_INPUT;
             }
@@ -4003,18 +4973,19 @@ GameResult gameFrame(double delta_time, Input* input)
                 if (!intCoordsWithinLevelBounds(raycast_output.place_coords))
                 {
                     // tile doesn't fit: grow level sizes to include, if possible
-                    Int3 new_origin = level_origin;
+                    Int3 new_origin = sim->level_origin;
                     if (raycast_output.place_coords.x < new_origin.x) new_origin.x = raycast_output.place_coords.x;
                     if (raycast_output.place_coords.y < new_origin.y) new_origin.y = raycast_output.place_coords.y;
                     if (raycast_output.place_coords.z < new_origin.z) new_origin.z = raycast_output.place_coords.z;
 
-                    Int3 new_max = int3Subtract(int3Add(level_origin, level_dim), (Int3){ 1,1,1 }); // set new_max to previous old max coord
+                    Int3 new_max = int3Subtract(int3Add(sim->level_origin, sim->level_dim), (Int3){ 1,1,1 }); // set new_max to previous old max coord
                     if (raycast_output.place_coords.x > new_max.x) new_max.x = raycast_output.place_coords.x;
                     if (raycast_output.place_coords.y > new_max.y) new_max.y = raycast_output.place_coords.y;
                     if (raycast_output.place_coords.z > new_max.z) new_max.z = raycast_output.place_coords.z;
 
                     Int3 new_dim = int3Add(int3Subtract(new_max, new_origin), (Int3){ 1,1,1 });
                     place_allowed = reindexBuffer(new_origin, new_dim);
+                    wakeAllEntities();
                 }
                 else
                 {
@@ -4023,13 +4994,13 @@ GameResult gameFrame(double delta_time, Input* input)
 
                 if (place_allowed)
                 {
-                    if (editor_state.picked_tile == TILE_TYPE_PLAYER) editorPlaceOnlyInstanceOfTile(player, raycast_output.place_coords, TILE_TYPE_PLAYER, PLAYER_ID);
-                    else if (editor_state.picked_tile == TILE_TYPE_PACK) editorPlaceOnlyInstanceOfTile(pack, raycast_output.place_coords, TILE_TYPE_PACK, PACK_ID);
+                    if (editor_state.picked_tile == TILE_TYPE_PLAYER) editorPlaceOnlyInstanceOfTile(sim->player, raycast_output.place_coords, TILE_TYPE_PLAYER, PLAYER_ID);
+                    else if (editor_state.picked_tile == TILE_TYPE_PACK) editorPlaceOnlyInstanceOfTile(sim->pack, raycast_output.place_coords, TILE_TYPE_PACK, PACK_ID);
                     if (isSource(editor_state.picked_tile)) 
                     {
                         setTileType(editor_state.picked_tile, raycast_output.place_coords); 
                         setTileDirection(NORTH, raycast_output.place_coords, 0);
-                        setEntityInstanceInGroup(world_state.sources, raycast_output.place_coords, NORTH, MIRROR_SIDE, getEntityColor(raycast_output.place_coords)); 
+                        setEntityInstanceInGroup(sim->world_state.sources, raycast_output.place_coords, NORTH, MIRROR_SIDE, getEntityColor(raycast_output.place_coords)); 
                     }
                     else
                     {
@@ -4038,10 +5009,10 @@ GameResult gameFrame(double delta_time, Input* input)
                         Entity* entity_group = 0;
                         switch (editor_state.picked_tile)
                         {
-                            case TILE_TYPE_BOX:          entity_group = world_state.boxes;         break;
-                            case TILE_TYPE_MIRROR:       entity_group = world_state.mirrors;       break;
-                            case TILE_TYPE_WIN_BLOCK:    entity_group = world_state.win_blocks;    break;
-                            case TILE_TYPE_LOCKED_BLOCK: entity_group = world_state.locked_blocks; break;
+                            case TILE_TYPE_BOX:          entity_group = sim->world_state.boxes;         break;
+                            case TILE_TYPE_MIRROR:       entity_group = sim->world_state.mirrors;       break;
+                            case TILE_TYPE_WIN_BLOCK:    entity_group = sim->world_state.win_blocks;    break;
+                            case TILE_TYPE_LOCKED_BLOCK: entity_group = sim->world_state.locked_blocks; break;
                             default: entity_group = 0;
                         }
                         if (entity_group != 0) 
@@ -4148,10 +5119,11 @@ GameResult gameFrame(double delta_time, Input* input)
                 else if (input->keys_held & KEY_Q && editor_state.selected_id / ID_OFFSET_WIN_BLOCK * ID_OFFSET_WIN_BLOCK == ID_OFFSET_WIN_BLOCK)
                 {
                     Entity* wb = getEntityFromId(editor_state.selected_id);
-                    if (wb->next_level[0] != 0)
+                    char* next_level = getEntityMetadata(wb)->next_level;
+                    if (next_level[0] != 0)
                     {
-                        levelChangePrep(wb->next_level, false);
-                        initializeLevel(wb->next_level);
+                        levelChangePrep(next_level, false);
+                        initializeLevel(next_level);
                         writeSolvedLevelsToFile();
                         updateLockedTiles(false);
                         time_until_allow_meta_input = STANDARD_TIME_UNTIL_ALLOW_INPUT;
@@ -4188,11 +5160,11 @@ GameResult gameFrame(double delta_time, Input* input)
 
                 Vec3 point_on_plane = cameraLookingAtPointOnPlane(camera_with_ow_offset, water_plane_y);
                 Int2 center = {0};
-                center.x = (int32)((point_on_plane.x - level_origin.x + (0.5 / WATER_PAINT_RESOLUTION) + 0.5f) * WATER_PAINT_RESOLUTION);
-                center.y = (int32)((point_on_plane.z - level_origin.z + (0.5 / WATER_PAINT_RESOLUTION) + 0.5f) * WATER_PAINT_RESOLUTION);
+                center.x = (int32)((point_on_plane.x - sim->level_origin.x + (0.5 / WATER_PAINT_RESOLUTION) + 0.5f) * WATER_PAINT_RESOLUTION);
+                center.y = (int32)((point_on_plane.z - sim->level_origin.z + (0.5 / WATER_PAINT_RESOLUTION) + 0.5f) * WATER_PAINT_RESOLUTION);
                 Int2 top_left = { center.x - brush_radius, center.y - brush_radius };
-                int32 texture_width  = level_dim.x * WATER_PAINT_RESOLUTION;
-                int32 texture_height = level_dim.z * WATER_PAINT_RESOLUTION;
+                int32 texture_width  = sim->level_dim.x * WATER_PAINT_RESOLUTION;
+                int32 texture_height = sim->level_dim.z * WATER_PAINT_RESOLUTION;
                 if (texture_width  > WATER_PAINT_MAX_SIDE) texture_width  = WATER_PAINT_MAX_SIDE;
                 if (texture_height > WATER_PAINT_MAX_SIDE) texture_height = WATER_PAINT_MAX_SIDE;
 
@@ -4214,14 +5186,14 @@ GameResult gameFrame(double delta_time, Input* input)
                         water_paint_texture.values[in_array].r = (uint8)(speculative_value * 255.0f + 0.5f);
                     }
                 }
-                water_paint_texture.dirty = true;
+                water_paint_texture.generation++;
             }
             if (input->keys_held & KEY_R)
             {
                 // reset
                 FOR(i, WATER_PAINT_MAX_SIDE * WATER_PAINT_MAX_SIDE) water_paint_texture.values[i] = (Rgba8){ 0, 0, 0, 0 };
 
-                water_paint_texture.dirty = true;
+                water_paint_texture.generation++;
                 createDebugPopup("reset water texture", POPUP_TYPE_NONE);
                 time_until_allow_meta_input = STANDARD_TIME_UNTIL_ALLOW_INPUT;
             }
@@ -4265,11 +5237,29 @@ GameResult gameFrame(double delta_time, Input* input)
             time_until_allow_meta_input = STANDARD_TIME_UNTIL_ALLOW_INPUT;
             createDebugPopup("shader mode: testing outlines", POPUP_TYPE_SHADER_MODE_CHANGE);
         }
-        if (input->keys_held & KEY_8)
+        if ((input->keys_held & KEY_8) && (input->keys_held & KEY_SHIFT))
+        {
+            // with shift, cycles how the water is simulated, to compare them under the renderer's "fft" timestamp
+            game_water_mode = (game_water_mode + 1) % WATER_MODE_COUNT;
+            if (game_water_mode == WATER_MODE_BAKED_LOOP) createDebugPopup("water: baked loop", POPUP_TYPE_WATER_MODE_CHANGE);
+            else if (game_water_mode == WATER_MODE_REDUCED_RATE) createDebugPopup("water: live, reduced rate", POPUP_TYPE_WATER_MODE_CHANGE);
+            else createDebugPopup("water: live, every frame", POPUP_TYPE_WATER_MODE_CHANGE);
+            time_until_allow_meta_input = STANDARD_TIME_UNTIL_ALLOW_INPUT;
+        }
+        else if (input->keys_held & KEY_8)
         {
-            game_shader_mode = SHADER_MODE_DEFAULT;
+            // pressed again, switches laser transparency, to compare the two under the renderer's "overlay" timestamp
+            if (game_shader_mode == SHADER_MODE_DEFAULT)
+            {
+                game_shader_mode = SHADER_MODE_WEIGHTED_BLENDED_OIT;
+                createDebugPopup("shader mode: outlines, weighted blended oit lasers", POPUP_TYPE_SHADER_MODE_CHANGE);
+            }
+            else
+            {
+                game_shader_mode = SHADER_MODE_DEFAULT;
+                createDebugPopup("shader mode: outlines", POPUP_TYPE_SHADER_MODE_CHANGE);
+            }
             time_until_allow_meta_input = STANDARD_TIME_UNTIL_ALLOW_INPUT;
-            createDebugPopup("shader mode: outlines", POPUP_TYPE_SHADER_MODE_CHANGE);
         }
 
         // toggle cheating
@@ -4320,6 +5310,14 @@ GameResult gameFrame(double delta_time, Input* input)
                 else           createDebugPopup("step through physics off", POPUP_TYPE_STEP_THROUGH_TOGGLE);
                 time_until_allow_meta_input = STANDARD_TIME_UNTIL_ALLOW_INPUT;
             }
+            if (input->keys_held & KEY_U)
+            {
+                turbo_mode = !turbo_mode;
+                turbo_resolve_pending = false;
+                if (turbo_mode) createDebugPopup("turbo mode on", POPUP_TYPE_TURBO_MODE_TOGGLE);
+                else            createDebugPopup("turbo mode off", POPUP_TYPE_TURBO_MODE_TOGGLE);
+                time_until_allow_meta_input = STANDARD_TIME_UNTIL_ALLOW_INPUT;
+            }
             if (input->keys_held & KEY_K)
             {
                 step_to_next_tick = true;
@@ -4433,8 +5431,8 @@ GameResult gameFrame(double delta_time, Input* input)
                 memset(solved_levels, 0, sizeof(solved_levels));
                 FOR(wb_index, MAX_ENTITY_INSTANCE_COUNT)
                 {
-                    Entity wb = overworld_zero_state.win_blocks[wb_index];
-                    if (wb.next_level[0] != 0) addToSolvedLevels(wb.next_level);
+                    EntityMetadata* wb_metadata = &overworld_zero_metadata[entitySlot(&overworld_zero_state, &overworld_zero_state.win_blocks[wb_index])];
+                    if (wb_metadata->next_level[0] != 0) addToSolvedLevels(wb_metadata->next_level);
                 }
                 updateLockedTiles(false);
                 createDebugPopup("all ow levels solved", POPUP_TYPE_NONE);
@@ -4458,19 +5456,21 @@ GameResult gameFrame(double delta_time, Input* input)
                 getLevelMinAndMax(&level_min, &level_max);
                 Int3 new_level_dim = int3Add(int3Subtract(level_max, level_min), (Int3){ 1,1,1 });
                 reindexBuffer(level_min, new_level_dim);
+                wakeAllEntities();
                 time_until_allow_meta_input = STANDARD_TIME_UNTIL_ALLOW_INPUT;
             }
 
             // TEMP: get rid of all water tiles
             if (input->keys_held & KEY_5)
             {
-                for (int tile_index = 0; tile_index < 2 * level_dim.x*level_dim.y*level_dim.z; tile_index += 2)
+                for (int tile_index = 0; tile_index < 2 * sim->level_dim.x*sim->level_dim.y*sim->level_dim.z; tile_index += 2)
                 {
                     Int3 coords = bufferIndexToCoords(tile_index);
                     TileType type = getTileType(coords);
                     if (type != TILE_TYPE_WATER) continue;
                     setTileType(TILE_TYPE_NONE, coords);
                     setTileDirection(NO_DIRECTION, coords, 0);
+                    wakeEntitiesAroundTile(coords);
                 }
                 DEBUG_POPUP(POPUP_TYPE_NONE, "cleared water tiles");
                 time_until_allow_meta_input = STANDARD_TIME_UNTIL_ALLOW_INPUT;
@@ -4491,13 +5491,13 @@ GameResult gameFrame(double delta_time, Input* input)
         {
             // NOTE: used to persist solved levels over level change and game init, but appears unnecessary
             char from_level[64];
-            strcpy(from_level, world_state.level_name);
+            strcpy(from_level, sim->world_state.level_name);
             levelChangePrep("overworld", false);
             initializeLevel("overworld");
 
             placePlayerOnWinBlock(from_level);
 
-            temp_state.allow_movement_timer = 0;
+            sim->temp_state.allow_movement_timer = 0;
             time_until_allow_meta_input = STANDARD_TIME_UNTIL_ALLOW_INPUT;
         }
     }
@@ -4544,11 +5544,14 @@ GameResult gameFrame(double delta_time, Input* input)
                     else time_until_allow_undo_or_restart_input = 6;
 
                     undos_performed++;
-                    temp_state.undo_press_timer = time_until_allow_undo_or_restart_input;
-                    temp_state.allow_movement_timer = time_until_allow_undo_or_restart_input;
+                    sim->temp_state.undo_press_timer = time_until_allow_undo_or_restart_input;
+                    sim->temp_state.allow_movement_timer = time_until_allow_undo_or_restart_input;
 
                     updateLockedTiles(false);
                     updatePackAttached();
+                    clearInputQueue(); // presses queued before the undo were meant for the state it just left
+
+                    if (turbo_mode) resolveDiscreteOutcome();
                 }
                 else
                 {
@@ -4561,291 +5564,94 @@ GameResult gameFrame(double delta_time, Input* input)
                 // RESTART 
                 if (!restart_last_turn) 
                 {
-                    recordActionForUndo(&world_state);
+                    recordActionForUndo(&sim->world_state);
                 }
                 createDebugPopup("level restarted", POPUP_TYPE_NONE);
                 Camera save_camera = camera;
 
                 // init level, persist visual effects
                 VisualEffects persist_visual_effects = visual_effects;
-                initializeLevel(world_state.level_name);
+                initializeLevel(sim->world_state.level_name);
                 visual_effects = persist_visual_effects;
 
                 if (in_overworld)
                 {
                     // TODO: reset only part of the overworld
-                    memcpy(&world_state, &overworld_zero_state, sizeof(WorldState));
-                    memcpy(&world_state.level_name, "overworld", sizeof(char) * 64);
-
-                    moveEntityInBufferAndState(player, overworld_restart_coords, NORTH);
-                    player->rotation = composeRotation(player->direction, MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION);
-                    player->position = vec3FromInt3(player->coords);
-                    moveEntityInBufferAndState(pack, getNextCoords(player->coords, SOUTH), NORTH);
-                    pack->rotation = composeRotation(pack->direction, MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION);
-                    pack->position = vec3FromInt3(pack->coords);
+                    memcpy(&sim->world_state, &overworld_zero_state, sizeof(WorldState));
+                    memcpy(sim->entity_metadata, overworld_zero_metadata, sizeof(sim->entity_metadata));
+                    memcpy(&sim->world_state.level_name, "overworld", sizeof(char) * 64);
+                    wakeAllEntities();
+
+                    moveEntityInBufferAndState(sim->player, overworld_restart_coords, NORTH);
+                    sim->player->rotation = composeRotation(sim->player->direction, MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION);
+                    sim->player->position = vec3FromInt3(sim->player->coords);
+                    moveEntityInBufferAndState(sim->pack, getNextCoords(sim->player->coords, SOUTH), NORTH);
+                    sim->pack->rotation = composeRotation(sim->pack->direction, MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION);
+                    sim->pack->position = vec3FromInt3(sim->pack->coords);
 
                     updateLockedTiles(false);
                 }
                 camera = save_camera; 
                 restart_last_turn = true;
                 time_until_allow_undo_or_restart_input = STANDARD_TIME_UNTIL_ALLOW_INPUT;
-                temp_state.allow_movement_timer = 0;
+                sim->temp_state.allow_movement_timer = 0;
+                clearInputQueue();
 
                 updateLaserBuffer();
             }
 
-            // HANDLE WASD INPUT
+            if (turbo_resolve_pending) continueDiscreteResolve();
 
-            bool wasd_held    = input->keys_held    & KEY_W || input->keys_held    & KEY_A || input->keys_held    & KEY_S || input->keys_held    & KEY_D;
-            bool wasd_pressed = input->keys_pressed & KEY_W || input->keys_pressed & KEY_A || input->keys_pressed & KEY_S || input->keys_pressed & KEY_D;
+            // HANDLE WASD INPUT
 
-            if (wasd_held)
+            // fresh presses are queued and applied on the first tick the player can take them, so an early press isn't lost.
+            // a held key only moves the player on ticks where it is allowed right away.
+            Direction pressed_direction = NO_DIRECTION;
+            if      (input->keys_pressed & KEY_W) pressed_direction = NORTH; 
+            else if (input->keys_pressed & KEY_A) pressed_direction = WEST; 
+            else if (input->keys_pressed & KEY_S) pressed_direction = SOUTH; 
+            else if (input->keys_pressed & KEY_D) pressed_direction = EAST; 
+            if (pressed_direction != NO_DIRECTION) queueMovementInput(pressed_direction);
+            expireQueuedInputs();
+
+            Direction input_direction = NO_DIRECTION;
+            bool input_from_queue = false;
+            if (input_queue.count > 0)
             {
-                Direction input_direction = NO_DIRECTION;
-                int32 maybe_max_lookahead_frames = 0;
-
-                if (wasd_pressed)
-                {
-                    if      (input->keys_pressed & KEY_W) input_direction = NORTH; 
-                    else if (input->keys_pressed & KEY_A) input_direction = WEST; 
-                    else if (input->keys_pressed & KEY_S) input_direction = SOUTH; 
-                    else if (input->keys_pressed & KEY_D) input_direction = EAST; 
-                    maybe_max_lookahead_frames = MAX_LOOKAHEAD_MOVEMENT_FRAMES;
-                }
-                else
-                {
-                    if      (input->keys_held & KEY_W) input_direction = NORTH; 
-                    else if (input->keys_held & KEY_A) input_direction = WEST; 
-                    else if (input->keys_held & KEY_S) input_direction = SOUTH; 
-                    else if (input->keys_held & KEY_D) input_direction = EAST; 
-                    maybe_max_lookahead_frames = 1;
-                }
-
-                bool input_allowed = false;
-                bool move_failed = false; // used to not skip ahead if move that is done is a fail. all turns are allowed for look-ahead even if fail.
-
-                if (maybe_max_lookahead_frames > 1)
-                {
-                    memcpy(&lookahead_world_state_snapshot, &world_state, sizeof(WorldState));
-                    memcpy(&lookahead_temp_state_snapshot,  &temp_state,  sizeof(TemporaryState));
-                }
-
-                FOR(tick_index, maybe_max_lookahead_frames)
-                {
-                    input_allowed = true; // set as true for this frame
-
-                    if (temp_state.allow_movement_timer != 0) input_allowed = false;
-                    if (player->removed) input_allowed = false;
-
-                    // gate on how close player is to completing rotation
-                    if (floatAbs(player->yaw_offset) > TAU * 0.25 * MAX_QUARTER_TURN_ANGLE_ALLOWED_FOR_MOVEMENT) input_allowed = false;
-
-                    // if able to fall then don't allow movement
-                    bool player_immune_to_fall = false;
-                    if (temp_state.player_hit_by_red) player_immune_to_fall = true;
-                    if (player->moving_direction == UP) player_immune_to_fall = true;
-                    if (canFall(player) && !player_immune_to_fall) input_allowed = false;
-
-                    if (input_direction == player->direction)
-                    {
-                        // FORWARD MOVEMENT
-                        // allow movement if, given acceleration this frame along input direction, we would overshoot.
-                        float sign = input_direction == NORTH || input_direction == WEST ? -1.0f : 1.0f;
-                        float speculative_velocity_along_direction = calculateSpeculativeVelocityAlongDirection(input_direction, sign);
-                        float position_along_direction = getFloatAlongDirection(input_direction, player->position);
-                        float coords_along_direction = getFloatAlongDirection(input_direction, vec3FromInt3(player->coords));
-                        if (!wouldOvershoot(speculative_velocity_along_direction, position_along_direction, coords_along_direction, sign)) input_allowed = false;
-
-                        // disallow movement if also moving in some other direction currently - probably just guards against moving while falling
-                        if (!vec3IsZero(vec3SetFloatAlongDirection(input_direction, 0, player->velocity))) input_allowed = false;
-
-                        // disallow movement forward if climbing UP. likely doesn't actually matter, would just be walking into a ladder
-                        if (player->moving_direction == UP) input_allowed = false;
-
-                        if (input_allowed)
-                        {
-                            bool do_walk = false;
-                            bool do_push = false;
-                            bool try_climb = false;
-
-                            Int3 next_player_coords = getNextCoords(player->coords, input_direction);
-                            TileType next_tile = getTileType(next_player_coords);
-
-                            switch (next_tile)
-                            {
-                                case TILE_TYPE_NONE:
-                                {
-                                    // NOTE: currently not allowing input if trailing hitbox occupies next tile. this check might be too strict sometimes
-                                    TrailingHitbox th = {0};
-                                    if (trailingHitboxAtCoords(next_player_coords, &th)) do_walk = false;
-                                    else do_walk = true;
-                                }
-                                break;
-                                case TILE_TYPE_BOX:
-                                case TILE_TYPE_PACK:
-                                case TILE_TYPE_MIRROR:
-                                case TILE_TYPE_SOURCE_RED:
-                                case TILE_TYPE_SOURCE_BLUE:
-                                case TILE_TYPE_SOURCE_MAGENTA:
-                                {
-                                    if (canPush(next_player_coords, input_direction))
-                                    {
-                                        do_push = true;
-                                        do_walk = true;
-                                    }
-                                }
-                                break;
-                                case TILE_TYPE_LADDER:
-                                {
-                                    bool ladder_facing_player = getTileDirection(next_player_coords) == oppositeDirection(player->direction);
-                                    bool player_at_correct_location = vec3IsEqual(player->position, vec3FromInt3(player->coords));
-                                    if (ladder_facing_player && player_at_correct_location) try_climb = true;
-                                    break;
-                                }
-                                default:
-                                {
-                                }
-                                break;
-                            }
-
-                            if (do_walk)
-                            {
-                                // NOTE: trying out allowing walking off edge
-                                recordActionForUndo(&world_state);
-                                if (do_push) pushAll(next_player_coords, input_direction, MOVE_TYPE_PUSH_BY_PLAYER, temp_state.blue_gameplay_timer == 0);
-                                doStandardMovement(input_direction, next_player_coords);
-                            }
-                            else if (try_climb)
-                            {
-                                // TODO: move try_climb logic inside ladder case, and have this just be do_climb
-                                // only handles setting climbing direction to UP if player wants to climb up. everything else is handled later, 
-                                // because i want to keep climbing sometimes, even if there's been no input for it.
-                                Int3 coords_above_player = getNextCoords(player->coords, UP);
-                                TileType type_above_player = getTileType(coords_above_player);
-
-                                bool do_climb = false; 
-                                if (type_above_player == TILE_TYPE_NONE) do_climb = true;
-                                else if (isPushable(type_above_player) && canPushVertical(coords_above_player, UP)) do_climb = true;
-                                if (do_climb)
-                                {
-                                    recordActionForUndo(&world_state);
-                                    player->moving_direction = UP;
-                                }
-                                else
-                                {
-                                    move_failed = true;
-                                }
-                            }
-                            else
-                            {
-                                move_failed = true;
-                            }
-
-                            break;
-                        }
-                    }
-                    else if (input_direction != oppositeDirection(player->direction))
-                    {
-                        // TURN MOVEMENT
-                        if (player->falling) input_allowed = false; // TODO: check if required
-                        if (player->moving_direction == UP) input_allowed = false;
-                        
-                        // get difference in position along axis of travel, and gate on some threshold to target
-                        float difference_in_player_position_along_direction = getFloatAlongDirection(player->direction, vec3Subtract(player->position, vec3FromInt3(player->coords)));
-                        if (fabs(difference_in_player_position_along_direction) > MAX_POSITION_DIFFERENCE_ALLOWED_FOR_MOVEMENT) input_allowed = false;
-
-                        if (temp_state.pack_attached)
-                        {
-                            // check if would cause half-failed case, and if so check if we already had one of those, and if so disallow turn
-                            // this defeats half the point of how i handle failed case later... but need to know now!
-                            Int3 orthogonal_coords = getNextCoords(player->coords, oppositeDirection(input_direction));
-                            TileType orthogonal_type = getTileType(orthogonal_coords);
-                            bool pack_would_cause_failed_case_orthogonal = orthogonal_type != TILE_TYPE_NONE && (!isEntity(orthogonal_type) || canPush(orthogonal_coords, player->direction));
-                            if (pack_would_cause_failed_case_orthogonal && temp_state.pack_turn_state.half_failed_turn_timer != 0) input_allowed = false;
-                        }
-
-                        if (input_allowed)
-                        {
-                            recordActionForUndo(&world_state);
-
-                            Direction initial_player_direction = player->direction;
-                            player->direction = input_direction;
-                            setTileDirection(player->direction, player->coords, 0);
-
-                            player->yaw_offset += directionAngleY(initial_player_direction) - directionAngleY(input_direction);
-                            if (player->yaw_offset >  0.5 * TAU) player->yaw_offset -= TAU;
-                            if (player->yaw_offset < -0.5 * TAU) player->yaw_offset += TAU;
-
-                            if (temp_state.pack_attached)
-                            {
-                                int32 rotation_frames = (int32)ceilf(floatAbs(player->yaw_offset) / MAX_ANGULAR_VELOCITY - 1e-3f);
-                                temp_state.pack_turn_state.pack_intermediate_states_timer = rotation_frames;
-                                temp_state.pack_turn_state.turn_total_frames = rotation_frames;
-                                temp_state.pack_turn_state.pack_intermediate_coords = getNextCoords(pack->coords, oppositeDirection(input_direction));
-                                temp_state.pack_turn_state.initial_player_direction = initial_player_direction;
-                            }
-
-                            // if not blue, rotate objects stacked above the player
-                            if (temp_state.blue_gameplay_timer == 0)
-                            {
-                                Int3 coords_above = getNextCoords(player->coords, UP);
-                                TileType type_above = getTileType(coords_above);
-
-                                int32 stack_size = 0;
-                                if (isPushable(type_above)) stack_size = getPushableStackSize(coords_above, UP);
-
-                                // need to add either 1 or -1 to direction of entity being rotated
-                                if (stack_size > 0)
-                                {
-                                    int32 direction_add = (4 + player->direction - initial_player_direction) % 4;
-                                    Int3 current_coords = coords_above;
-
-                                    FOR(stack_index, stack_size)
-                                    {
-                                        Entity* e = getEntityAtCoords(current_coords);
-                                        e->direction = (e->direction + direction_add - NORTH) % 4 + NORTH;
-                                        e->moving_direction = NO_DIRECTION;
-                                        e->move_type = MOVE_TYPE_ROTATE_ON_HEAD;
-
-                                        current_coords = getNextCoords(current_coords, UP);
-                                    }
-                                }
-                            }
-                            break;
-                        }
-                    }
-
-                    if (tick_index == maybe_max_lookahead_frames - 1) break;
-                    doPhysicsTick();
-                }
+                input_direction = input_queue.inputs[0].direction;
+                input_from_queue = true;
+            }
+            else
+            {
+                if      (input->keys_held & KEY_W) input_direction = NORTH; 
+                else if (input->keys_held & KEY_A) input_direction = WEST; 
+                else if (input->keys_held & KEY_S) input_direction = SOUTH; 
+                else if (input->keys_held & KEY_D) input_direction = EAST; 
+            }
 
-                bool revert_to_previous = false;
-                if (!input_allowed && maybe_max_lookahead_frames > 1) revert_to_previous = true;
-                //if (move_failed) revert_to_previous = true; // TODO: this breaks walking towards water when holding button press
-                if (revert_to_previous)
-                {
-                    // undo memcpy if still can't do this input after look-ahead
-                    memcpy(&world_state, &lookahead_world_state_snapshot, sizeof(WorldState));
-                    memcpy(&temp_state,  &lookahead_temp_state_snapshot,  sizeof(TemporaryState));
-                }
+            if (input_direction != NO_DIRECTION && !turbo_resolve_pending)
+            {
+                bool input_allowed = tryMovementInput(input_direction);
+                if (input_allowed && input_from_queue) popQueuedInput();
+                if (input_allowed && turbo_mode) resolveDiscreteOutcome();
             }
         }
 
         // handle all physics that doesn't have to do with player input on this frame
-        doPhysicsTick();
+        doPhysicsTick(!turbo_mode);
 
         // win block logic
-        if (getTileType(getNextCoords(player->coords, DOWN)) == TILE_TYPE_WIN_BLOCK)
+        if (getTileType(getNextCoords(sim->player->coords, DOWN)) == TILE_TYPE_WIN_BLOCK)
         {
             if (input->keys_held & KEY_Q && time_until_allow_meta_input == 0)
             {
                 // go to win_block.next_level if conditions are met
-                Entity* wb = getEntityAtCoords(getNextCoords(player->coords, DOWN));
+                Entity* wb = getEntityAtCoords(getNextCoords(sim->player->coords, DOWN));
                 bool do_win_block_usage = true;
                 if (editor_state.editor_mode != EDITOR_MODE_NONE) do_win_block_usage = false;
                 if (wb->locked) do_win_block_usage = false;
-                if (wb->next_level[0] == 0) do_win_block_usage = false; // don't go through if there is no next level here yet
-                if (!temp_state.pack_attached)
+                if (getEntityMetadata(wb)->next_level[0] == 0) do_win_block_usage = false; // don't go through if there is no next level here yet
+                if (!sim->temp_state.pack_attached)
                 {
                     visual_effects.flash_on_detached_exit_timer = FLASH_ON_DETACHED_EXIT_TIME;
                     //DEBUG_POPUP(POPUP_TYPE_NONE, "backpack must be attached to finish a level!");
@@ -4857,7 +5663,7 @@ GameResult gameFrame(double delta_time, Input* input)
                     if (in_overworld) 
                     {
                         char folder_path[64] = {0};
-                        buildLevelFolderPath(&folder_path, world_state.level_name, false);
+                        buildLevelFolderPath(&folder_path, sim->world_state.level_name, false);
                         writeBaseLevelInfo(folder_path);
                         if (camera_mode == ALT_WAITING) 
                         {
@@ -4872,10 +5678,13 @@ GameResult gameFrame(double delta_time, Input* input)
                     }
 
                     char from_level[64];
-                    strcpy(from_level, world_state.level_name);
-                    levelChangePrep(wb->next_level, true);
-                    initializeLevel(wb->next_level);
-                    memset(&temp_state, 0, sizeof(TemporaryState));
+                    strcpy(from_level, sim->world_state.level_name);
+                    char next_level[64];
+                    strcpy(next_level, getEntityMetadata(wb)->next_level);
+                    levelChangePrep(next_level, true);
+                    initializeLevel(next_level);
+                    memset(&sim->temp_state, 0, sizeof(TemporaryState));
+                    clearInputQueue();
 
                     if (in_overworld)
                     {
@@ -4893,11 +5702,12 @@ GameResult gameFrame(double delta_time, Input* input)
 
                 if (solve_level)
                 {
-                    Entity* wb = getEntityAtCoords(getNextCoords(player->coords, DOWN));
-                    if (findInSolvedLevels(wb->next_level) == -1)
+                    Entity* wb = getEntityAtCoords(getNextCoords(sim->player->coords, DOWN));
+                    char* next_level = getEntityMetadata(wb)->next_level;
+                    if (findInSolvedLevels(next_level) == -1)
                     {
                         int32 next_free = nextFreeInSolvedLevels();
-                        strcpy(solved_levels[next_free], wb->next_level);
+                        strcpy(solved_levels[next_free], next_level);
                     }
                     writeSolvedLevelsToFile();
                     updateLockedTiles(true);
@@ -4915,7 +5725,7 @@ GameResult gameFrame(double delta_time, Input* input)
         // update overworld player coords for camera offset if player not removed
         if (in_overworld)
         {
-            if (!player->removed) ow_player_coords_for_offset = player->coords;
+            if (!sim->player->removed) ow_player_coords_for_offset = sim->player->coords;
         }
         else 
         {
@@ -4925,7 +5735,7 @@ GameResult gameFrame(double delta_time, Input* input)
         // handle visual timers (ones that should only be affected once per frame, i.e. not touched by doPhysicsTick)
         {
             // blue visual timer
-            if (temp_state.blue_gameplay_timer == MAX_BLUE_GAMEPLAY_TIME)
+            if (sim->temp_state.blue_gameplay_timer == MAX_BLUE_GAMEPLAY_TIME)
             {
                 if (visual_effects.blue_visual_timer < MAX_BLUE_VISUAL_TIME) visual_effects.blue_visual_timer++;
             }
@@ -4941,15 +5751,15 @@ GameResult gameFrame(double delta_time, Input* input)
 
         // update restart coords based on current coords of the player, and also update game progress if this is relevant
 
-        if      (player->coords.z > 222) overworldPositionState(PROGRESS_START,     (Int3){ 58, 258, 235 }, 0.0f);
-        else if (player->coords.z > 205) overworldPositionState(PROGRESS_PACK,      (Int3){ 58, 258, 222 }, 0.0f);
-        else if (player->coords.z > 188) overworldPositionState(PROGRESS_RED,       (Int3){ 58, 258, 205 }, 0.0f);
-        else if (player->coords.z > 171) overworldPositionState(PROGRESS_BLUE,      (Int3){ 58, 258, 188 }, 0.0f);
-        else if (player->coords.z > 154) overworldPositionState(PROGRESS_RED_BLUE,  (Int3){ 58, 258, 171 }, 0.0f);
-        else if (player->coords.z > 137) overworldPositionState(PROGRESS_MAGENTA,   (Int3){ 58, 258, 154 }, 0.0f);
-        else if (player->coords.z > 120) overworldPositionState(PROGRESS_BALANCE,   (Int3){ 58, 258, 137 }, 0.0f);
-        else if (player->coords.z > 103) overworldPositionState(PROGRESS_BALANCE_2, (Int3){ 58, 258, 120 }, 0.0f);
-        else if (player->coords.z > 86)  overworldPositionState(PROGRESS_LADDER,    (Int3){ 58, 258, 103 }, 3.0f);
+        if      (sim->player->coords.z > 222) overworldPositionState(PROGRESS_START,     (Int3){ 58, 258, 235 }, 0.0f);
+        else if (sim->player->coords.z > 205) overworldPositionState(PROGRESS_PACK,      (Int3){ 58, 258, 222 }, 0.0f);
+        else if (sim->player->coords.z > 188) overworldPositionState(PROGRESS_RED,       (Int3){ 58, 258, 205 }, 0.0f);
+        else if (sim->player->coords.z > 171) overworldPositionState(PROGRESS_BLUE,      (Int3){ 58, 258, 188 }, 0.0f);
+        else if (sim->player->coords.z > 154) overworldPositionState(PROGRESS_RED_BLUE,  (Int3){ 58, 258, 171 }, 0.0f);
+        else if (sim->player->coords.z > 137) overworldPositionState(PROGRESS_MAGENTA,   (Int3){ 58, 258, 154 }, 0.0f);
+        else if (sim->player->coords.z > 120) overworldPositionState(PROGRESS_BALANCE,   (Int3){ 58, 258, 137 }, 0.0f);
+        else if (sim->player->coords.z > 103) overworldPositionState(PROGRESS_BALANCE_2, (Int3){ 58, 258, 120 }, 0.0f);
+        else if (sim->player->coords.z > 86)  overworldPositionState(PROGRESS_LADDER,    (Int3){ 58, 258, 103 }, 3.0f);
         else                             overworldPositionState(PROGRESS_BLUE_VOID, (Int3){ 58, 261, 86  }, 3.0f);
 
         // perform alt <-> main camera interpolation
@@ -4984,7 +5794,7 @@ GameResult gameFrame(double delta_time, Input* input)
         if (do_debug_text)
         {
             // display level name
-            createDebugText(world_state.level_name);
+            createDebugText(sim->world_state.level_name);
 
             // game progress
             DEBUG_TEXT("game progress: %i", game_progress);
@@ -4993,19 +5803,19 @@ GameResult gameFrame(double delta_time, Input* input)
             DEBUG_TEXT("ow restart coords: %i, %i, %i", overworld_restart_coords.x, overworld_restart_coords.y, overworld_restart_coords.z);
 
             // level origin and dim
-            DEBUG_TEXT("level origin: %i, %i, %i; level dim: %i, %i, %i", level_origin.x, level_origin.y, level_origin.z, level_dim.x, level_dim.y, level_dim.z);
+            DEBUG_TEXT("level origin: %i, %i, %i; level dim: %i, %i, %i", sim->level_origin.x, sim->level_origin.y, sim->level_origin.z, sim->level_dim.x, sim->level_dim.y, sim->level_dim.z);
 
             // player info
             DEBUG_TEXT("player info: coords: %i, %i, %i, pos norm: %.2f, %.2f, %.2f, velocity: %.2f, %.2f, %.2f, falling: %i, move dir: %i",
-                player->coords.x, player->coords.y, player->coords.z, player->position.x, player->position.y, player->position.z, player->velocity.x, player->velocity.y, player->velocity.z, player->falling, player->moving_direction);
+                sim->player->coords.x, sim->player->coords.y, sim->player->coords.z, sim->player->position.x, sim->player->position.y, sim->player->position.z, sim->player->velocity.x, sim->player->velocity.y, sim->player->velocity.z, sim->player->falling, sim->player->moving_direction);
 
             // pack info
             DEBUG_TEXT("pack info: coords: %i, %i, %i, pos norm: %.2f, %.2f, %.2f, velocity: %.2f, %.2f, %.2f, attached: %i, timer: %i", 
-                pack->coords.x, pack->coords.y, pack->coords.z, pack->position.x, pack->position.y, pack->position.z, pack->velocity.x, pack->velocity.y, pack->velocity.z, temp_state.pack_attached, temp_state.pack_turn_state.pack_intermediate_states_timer);
+                sim->pack->coords.x, sim->pack->coords.y, sim->pack->coords.z, sim->pack->position.x, sim->pack->position.y, sim->pack->position.z, sim->pack->velocity.x, sim->pack->velocity.y, sim->pack->velocity.z, sim->temp_state.pack_attached, sim->temp_state.pack_turn_state.pack_intermediate_states_timer);
 
             // boxes
-            Entity box1 = world_state.boxes[0];
-            Entity box2 = world_state.boxes[1];
+            Entity box1 = sim->world_state.boxes[0];
+            Entity box2 = sim->world_state.boxes[1];
             DEBUG_TEXT("box 1: velocity: %.2f, %.2f, %.2f, moving dir: %i, move type: %i; box 2: velocity: %.2f, %.2f, %.2f, moving dir: %i, move type: %i", 
                 box1.velocity.x, box1.velocity.y, box1.velocity.z, box1.moving_direction, box1.move_type, box2.velocity.x, box2.velocity.y, box2.velocity.z, box2.moving_direction, box2.move_type);
 
@@ -5025,8 +5835,8 @@ GameResult gameFrame(double delta_time, Input* input)
                             case WRITING_FIELD_NEXT_LEVEL:  createDebugText("    writing field: next level");       break;
                             case WRITING_FIELD_UNLOCKED_BY: createDebugText("    writing field: unlocked by");      break;
                         }
-                        DEBUG_TEXT("    next_level: %s", e->next_level);
-                        DEBUG_TEXT("    unlocked_by: %s", e->unlocked_by);
+                        DEBUG_TEXT("    next_level: %s", getEntityMetadata(e)->next_level);
+                        DEBUG_TEXT("    unlocked_by: %s", getEntityMetadata(e)->unlocked_by);
                     }
                     else
                     {
@@ -5049,9 +5859,9 @@ GameResult gameFrame(double delta_time, Input* input)
     {
         // paths for saving data both to source and to inside build
         char folder_path[64];
-        buildLevelFolderPath(&folder_path, world_state.level_name, true);
+        buildLevelFolderPath(&folder_path, sim->world_state.level_name, true);
         char relative_folder_path[64];
-        buildLevelFolderPath(&relative_folder_path, world_state.level_name, false);
+        buildLevelFolderPath(&relative_folder_path, sim->world_state.level_name, false);
 
         // only used if saving in overworld
         char overworld_zero_path[64];
@@ -5165,7 +5975,8 @@ GameResult gameFrame(double delta_time, Input* input)
                 writeWaterTexture(overworld_zero_relative_path);
 
                 // overwrite overworld_zero's world state with the new saved one
-                memcpy(&overworld_zero_state, &world_state, sizeof(WorldState));
+                memcpy(&overworld_zero_state, &sim->world_state, sizeof(WorldState));
+                memcpy(overworld_zero_metadata, sim->entity_metadata, sizeof(sim->entity_metadata));
             }
             createDebugPopup("level saved", POPUP_TYPE_LEVEL_SAVE);
         }
@@ -5195,10 +6006,13 @@ GameResult gameFrame(double delta_time, Input* input)
     // DRAW 3D //
     /////////////
 
+    // draw static tiles (first, so they are a fixed prefix of the list)
+    drawStaticTiles();
+
     // draw lasers
     FOR(laser_buffer_index, MAX_SOURCE_COUNT * MAX_LASER_TURNS_ALLOWED)
     {
-        LaserBuffer lb = temp_state.laser_buffer[laser_buffer_index];
+        LaserBuffer lb = sim->temp_state.laser_buffer[laser_buffer_index];
         if (lb.color == COLOR_NONE) continue;
 
         Vec3 diff = vec3Subtract(lb.end_coords, lb.start_coords);
@@ -5219,14 +6033,15 @@ GameResult gameFrame(double delta_time, Input* input)
         float alpha = 1.0f;
         Vec4 color_with_alpha = { color_without_alpha.x, color_without_alpha.y, color_without_alpha.z, alpha };
 
+        draw_interpolation_id = LASER_INTERPOLATION_ID_BASE + laser_buffer_index;
         drawAsset(0, LASER, center, scale, rotation, color_with_alpha, lb.start_clip_plane, lb.end_clip_plane); // the model doesnt matter
+        draw_interpolation_id = 0;
     }
 
-    // TODO: store static tiles at level entry (and on editor place/break), loop through that array on all other frames
-    // draw models
-    for (int tile_index = 0; tile_index < 2 * level_dim.x*level_dim.y*level_dim.z; tile_index += 2)
+    // draw entities
+    for (int tile_index = 0; tile_index < 2 * sim->level_dim.x*sim->level_dim.y*sim->level_dim.z; tile_index += 2)
     {
-        TileType draw_tile = world_state.buffer[tile_index];
+        TileType draw_tile = sim->world_state.buffer[tile_index];
         if (draw_tile == TILE_TYPE_NONE) continue;
         if (isEntity(draw_tile))
         {
@@ -5234,32 +6049,33 @@ GameResult gameFrame(double delta_time, Input* input)
 
             if (e->locked) draw_tile = TILE_TYPE_LOCKED_BLOCK;
 
+            draw_interpolation_id = entitySlot(&sim->world_state, e) + 1;
             switch (draw_tile)
             {
                 case TILE_TYPE_LOCKED_BLOCK:
                 {
-                    drawAsset(CUBE_3D_LOCKED_BLOCK, CUBE_3D, vec3FromInt3(bufferIndexToCoords(tile_index)), DEFAULT_SCALE, composeRotation(world_state.buffer[tile_index + 1], MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION), (Vec4){0}, (Vec4){0}, (Vec4){0});
+                    drawAsset(CUBE_3D_LOCKED_BLOCK, CUBE_3D, vec3FromInt3(bufferIndexToCoords(tile_index)), DEFAULT_SCALE, composeRotation(sim->world_state.buffer[tile_index + 1], MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION), (Vec4){0}, (Vec4){0}, (Vec4){0});
                 }
                 break;
                 case TILE_TYPE_PLAYER:
                 {
-                    Vec4 player_color = { (float)temp_state.player_hit_by_red, 0.0f, (float)(temp_state.blue_gameplay_timer > 0), 0.0f };
-                    drawAsset(MODEL_3D_PLAYER, MODEL_3D, player->position, DEFAULT_SCALE, player->rotation, player_color, (Vec4){0}, (Vec4){0});
+                    Vec4 player_color = { (float)sim->temp_state.player_hit_by_red, 0.0f, (float)(sim->temp_state.blue_gameplay_timer > 0), 0.0f };
+                    drawAsset(MODEL_3D_PLAYER, MODEL_3D, sim->player->position, DEFAULT_SCALE, sim->player->rotation, player_color, (Vec4){0}, (Vec4){0});
                 }
                 break;
                 case TILE_TYPE_PACK:
                 {
-                    Vec4 draw_rotation = pack->rotation;
-                    if (visual_effects.blue_visual_timer > 0 && !temp_state.pack_attached) draw_rotation = getBlueTilt(e);
+                    Vec4 draw_rotation = sim->pack->rotation;
+                    if (visual_effects.blue_visual_timer > 0 && !sim->temp_state.pack_attached) draw_rotation = getBlueTilt(e);
 
                     Vec4 pack_color = { visual_effects.flash_on_detached_exit_timer / FLASH_ON_DETACHED_EXIT_TIME, 0.0f, 0.0f, 0.0f };
 
-                    drawAsset(MODEL_3D_PACK, MODEL_3D, pack->position, DEFAULT_SCALE, draw_rotation, pack_color, (Vec4){0}, (Vec4){0});
+                    drawAsset(MODEL_3D_PACK, MODEL_3D, sim->pack->position, DEFAULT_SCALE, draw_rotation, pack_color, (Vec4){0}, (Vec4){0});
                 }
                 break;
                 case TILE_TYPE_WIN_BLOCK:
                 {
-                    if (in_overworld && findInSolvedLevels(e->next_level) != -1) drawAsset(CUBE_3D_WON_BLOCK, CUBE_3D, e->position, DEFAULT_SCALE, e->rotation, (Vec4){0}, (Vec4){0}, (Vec4){0});
+                    if (in_overworld && findInSolvedLevels(getEntityMetadata(e)->next_level) != -1) drawAsset(CUBE_3D_WON_BLOCK, CUBE_3D, e->position, DEFAULT_SCALE, e->rotation, (Vec4){0}, (Vec4){0}, (Vec4){0});
                     else drawAsset(MODEL_3D_WIN_BLOCK, MODEL_3D, e->position, DEFAULT_SCALE, e->rotation, (Vec4){0}, (Vec4){0}, (Vec4){0});
                 }
                 break;
@@ -5272,17 +6088,14 @@ GameResult gameFrame(double delta_time, Input* input)
                 }
                 break;
             }
-        }
-        else
-        {
-            drawAsset(getCube3DId(draw_tile), CUBE_3D, vec3FromInt3(bufferIndexToCoords(tile_index)), DEFAULT_SCALE, composeRotation(world_state.buffer[tile_index + 1], MIRROR_SIDE, 0.0f, IDENTITY_QUATERNION), (Vec4){0}, (Vec4){0}, (Vec4){0});
+            draw_interpolation_id = 0;
         }
     }
 
     // draw water plane as scaled single quad. drawing at water_plane_y, with dims level_dim.x * level_dim.z, +20 in all directions
-    Vec3 center_point = vec3Add(vec3FromInt3(level_origin), vec3ScalarMultiply(vec3FromInt3(level_dim), 0.5));
+    Vec3 center_point = vec3Add(vec3FromInt3(sim->level_origin), vec3ScalarMultiply(vec3FromInt3(sim->level_dim), 0.5));
     Vec3 center_point_on_plane = vec3SetFloatAlongDirection(UP, water_plane_y, center_point); // TODO: need to change water mesh to be centered along y
-    Vec3 water_scale = { (float)level_dim.x + 40.0f, 1.0f, (float)level_dim.z + 40.0f};
+    Vec3 water_scale = { (float)sim->level_dim.x + 40.0f, 1.0f, (float)sim->level_dim.z + 40.0f};
     drawAsset(MODEL_3D_WATER, WATER_3D, center_point_on_plane, water_scale, IDENTITY_QUATERNION, (Vec4){0}, (Vec4){0}, (Vec4){0});
 
     // draw selected entity
@@ -5301,14 +6114,14 @@ GameResult gameFrame(double delta_time, Input* input)
         if (in_overworld)
         {
             // draw camera screen lines NOTE: if/when levels want to have multiple screens, will want to do this for levels also
-            int32 x_wall_length = ((level_dim.z - 2) / OVERWORLD_SCREEN_SIZE_Z + 2) * OVERWORLD_SCREEN_SIZE_Z; // constant x: depends on z len
-            int32 z_wall_length = ((level_dim.x - 2) / OVERWORLD_SCREEN_SIZE_X + 2) * OVERWORLD_SCREEN_SIZE_X; // constant z: depends on x len
+            int32 x_wall_length = ((sim->level_dim.z - 2) / OVERWORLD_SCREEN_SIZE_Z + 2) * OVERWORLD_SCREEN_SIZE_Z; // constant x: depends on z len
+            int32 z_wall_length = ((sim->level_dim.x - 2) / OVERWORLD_SCREEN_SIZE_X + 2) * OVERWORLD_SCREEN_SIZE_X; // constant z: depends on x len
 
             int32 start_coords_x = OVERWORLD_CAMERA_CENTER_START.x - (OVERWORLD_SCREEN_SIZE_X / 2);
-            while (start_coords_x > level_origin.x) start_coords_x -= OVERWORLD_SCREEN_SIZE_X;
+            while (start_coords_x > sim->level_origin.x) start_coords_x -= OVERWORLD_SCREEN_SIZE_X;
             int32 start_coords_z = OVERWORLD_CAMERA_CENTER_START.z - (OVERWORLD_SCREEN_SIZE_Z / 2);
-            while (start_coords_z > level_origin.z) start_coords_z -= OVERWORLD_SCREEN_SIZE_Z;
-            float y = (float)(level_origin.y + level_dim.y / 2);
+            while (start_coords_z > sim->level_origin.z) start_coords_z -= OVERWORLD_SCREEN_SIZE_Z;
+            float y = (float)(sim->level_origin.y + sim->level_dim.y / 2);
 
             // walls with internal constant x
             /*
@@ -5325,7 +6138,7 @@ GameResult gameFrame(double delta_time, Input* input)
             */
 
             // walls with internal constant z
-            Vec3 z_wall_scale = { 1.0f, (float)level_dim.y, 0 };
+            Vec3 z_wall_scale = { 1.0f, (float)sim->level_dim.y, 0 };
             FOR(z_wall_z_index, x_wall_length / OVERWORLD_SCREEN_SIZE_Z + 1)
             {
                 float z = (float)(start_coords_z + z_wall_z_index * OVERWORLD_SCREEN_SIZE_Z) - 0.5f;
@@ -5339,8 +6152,8 @@ GameResult gameFrame(double delta_time, Input* input)
 
         // draw level boundary
         {
-            Vec3 level_origin_as_vec = vec3Subtract(vec3FromInt3(level_origin), (Vec3){ 0.5f, 0.5f, 0.5f } );
-            Vec3 level_dim_as_vec = vec3FromInt3(level_dim);
+            Vec3 level_origin_as_vec = vec3Subtract(vec3FromInt3(sim->level_origin), (Vec3){ 0.5f, 0.5f, 0.5f } );
+            Vec3 level_dim_as_vec = vec3FromInt3(sim->level_dim);
             Vec3 x_draw_coords_near = (Vec3){ level_origin_as_vec.x,                            level_origin_as_vec.y + (level_dim_as_vec.y / 2), level_origin_as_vec.z + (level_dim_as_vec.z / 2) };
             Vec3 x_draw_coords_far  = (Vec3){ level_origin_as_vec.x + level_dim_as_vec.x,       level_origin_as_vec.y + (level_dim_as_vec.y / 2), level_origin_as_vec.z + (level_dim_as_vec.z / 2) };
             Vec3 z_draw_coords_near = (Vec3){ level_origin_as_vec.x + (level_dim_as_vec.x / 2), level_origin_as_vec.y + (level_dim_as_vec.y / 2), level_origin_as_vec.z };
@@ -5360,7 +6173,7 @@ GameResult gameFrame(double delta_time, Input* input)
     {
         FOR(th_index, MAX_TRAILING_HITBOX_COUNT)
         {
-            TrailingHitbox th = temp_state.trailing_hitboxes[th_index];
+            TrailingHitbox th = sim->temp_state.trailing_hitboxes[th_index];
             if (th.frames == 0) continue;
             drawAsset(SPRITEID_ASSET_COUNT, OUTLINE_3D, vec3FromInt3(th.coords), DEFAULT_SCALE, IDENTITY_QUATERNION, (Vec4){0}, (Vec4){0}, (Vec4){0});
         }
@@ -5440,30 +6253,25 @@ GameResult gameFrame(double delta_time, Input* input)
 
     if (do_profiling_output)
     {
-        double reload_ms    = 1000.0 * (double)(t_after_reload  - t_start)         / (double)frequency;
-        double input_ms     = 1000.0 * (double)(t_after_input   - t_after_reload)  / (double)frequency;
+        double input_ms     = 1000.0 * (double)(t_after_input   - t_start)         / (double)frequency;
         double physics_ms   = 1000.0 * (double)(t_after_physics - t_after_input)   / (double)frequency;
         double saving_ms    = 1000.0 * (double)(t_after_saving  - t_after_physics) / (double)frequency;
         double game_draw_ms = 1000.0 * (double)(t_after_game    - t_after_saving)  / (double)frequency;
 
         char game[256];
-        snprintf(game, sizeof(game), "GAME:\nreload: %.2f ms\ninput: %.2f ms\nphysics: %.2f ms\nsaving: %.2f ms\ngame draw: %.2f ms\n\n", reload_ms, input_ms, physics_ms, saving_ms, game_draw_ms);
+        snprintf(game, sizeof(game), "GAME:\ninput: %.2f ms\nphysics: %.2f ms\nsaving: %.2f ms\ngame draw: %.2f ms\n\n", input_ms, physics_ms, saving_ms, game_draw_ms);
         OutputDebugStringA(game);
     }
 
-    vulkanSubmitFrame(draw_commands, draw_command_count, getRendererInfo());
-    QueryPerformanceCounter(&t_after_submit);
-    vulkanDraw(do_profiling_output);
-    QueryPerformanceCounter(&t_after_draw);
+    // hand off to the render thread. submitting and waiting on the gpu happen there, so they can't hold up input or physics
+    renderPublishSnapshot(draw_commands, draw_command_count, getRendererInfo(), do_profiling_output);
 
     if (do_profiling_output)
     {
-        double game_logic_ms = 1000.0 * (double)(t_after_game   - t_start)        / (double)frequency;
-        double submit_ms     = 1000.0 * (double)(t_after_submit - t_after_game)   / (double)frequency;
-        double draw_ms       = 1000.0 * (double)(t_after_draw   - t_after_submit) / (double)frequency;
+        double game_logic_ms = 1000.0 * (double)(t_after_game - t_start) / (double)frequency;
 
         char overview[256];
-        snprintf(overview, sizeof(overview), "OVERVIEW:\ngame: %.2f ms; submit: %.2f ms; draw: %.2f ms; total: %.2f ms\n\n", game_logic_ms, submit_ms, draw_ms, game_logic_ms + submit_ms + draw_ms);
+        snprintf(overview, sizeof(overview), "OVERVIEW:\ngame: %.2f ms\n\n", game_logic_ms);
         OutputDebugStringA(overview);
 
         profiling_frame_counter = 0;
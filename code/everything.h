@@ -85,6 +85,8 @@ typedef enum
 }
 GameResult;
 
+#define GAME_TICK_SECONDS (1.0 / 60.0) // the simulation's fixed step. the platform calls gameFrame once per tick, on its own thread
+
 typedef enum 
 {
 	SPRITE_2D,
@@ -174,6 +176,8 @@ typedef struct DrawCommand
 
     Vec4 start_clip_plane;
 	Vec4 end_clip_plane;
+
+    int32 interpolation_id; // 0 if drawn as is. otherwise matched against the same id in the previous snapshot, and blended from there
 }
 DrawCommand;
 
@@ -256,7 +260,7 @@ Input;
 typedef struct WaterPaintTexture
 {
     Rgba8 values[WATER_PAINT_MAX_SIDE * WATER_PAINT_MAX_SIDE];
-    bool dirty;
+    uint32 generation; // bumped by the game on every change, so a copy can tell it is stale
 }
 WaterPaintTexture;
 
@@ -274,9 +278,20 @@ typedef enum ShaderMode
 {
     SHADER_MODE_DEFAULT,
     SHADER_MODE_OUTLINE_TEST,
+    SHADER_MODE_WEIGHTED_BLENDED_OIT, // default, but lasers use weighted blended oit instead of per pixel linked lists
 }
 ShaderMode;
 
+// how the renderer updates the water displacement. all three are always available, to compare under the "fft" timestamp
+typedef enum WaterMode
+{
+    WATER_MODE_BAKED_LOOP,    // one loop baked at startup and played back
+    WATER_MODE_REDUCED_RATE,  // live simulation at a fixed rate, blending between the last two updates
+    WATER_MODE_EVERY_FRAME,   // live simulation every frame
+    WATER_MODE_COUNT,
+}
+WaterMode;
+
 typedef struct RendererInfo
 {
     Camera camera;
@@ -285,19 +300,97 @@ typedef struct RendererInfo
     float time;
     float water_plane_y;
     ShaderMode shader_mode;
-    WaterPaintTexture* water_paint_texture;
+    WaterMode water_mode;
+    const WaterPaintTexture* water_paint_texture; // the game's live texture when published; the render thread's copy after
     Vec3 sun_direction;
+
+    // the first static_draw_command_count draw commands are static tile cubes. the renderer draws them from a merged level mesh,
+    // which it only rebuilds when static_draw_version changes
+    int32 static_draw_command_count;
+    uint32 static_draw_version;
+
+    uint32 continuity_generation; // changes on undo, restart and level loads. snapshots from different generations are not blended
 }
 RendererInfo;
 
+// RENDER SNAPSHOTS
+
+#define MAX_DRAW_COMMANDS 16384
+#define MAX_INTERPOLATED_DRAWS 1024 // draws with an interpolation id: every entity and laser segment
+
+// where one draw with an interpolation id is in a given tick
+typedef struct InterpolatedTransform
+{
+    int32 interpolation_id;
+    Vec3 coords;
+    Vec3 scale;
+    Vec4 rotation;
+    Vec4 start_clip_plane;
+    Vec4 end_clip_plane;
+}
+InterpolatedTransform;
+
+// what the render thread blends between two simulation ticks: entity and laser transforms, and the camera. one is published
+// per tick, and kept small so the render thread can hold the two it blends without holding two draw lists
+typedef struct RenderSnapshot
+{
+    InterpolatedTransform transforms[MAX_INTERPOLATED_DRAWS];
+    int32 transform_count;
+    Camera camera;
+    float time;
+    uint32 continuity_generation; // see RendererInfo
+    double publish_time; // seconds, platform clock
+}
+RenderSnapshot;
+
+// the rest of what the render thread needs: the newest tick's draw list, which the snapshots' transforms are blended onto.
+// only the newest scene is ever drawn, so it needs no history
+typedef struct RenderScene
+{
+    DrawCommand draw_commands[MAX_DRAW_COMMANDS];
+    int32 draw_command_count;
+    RendererInfo renderer_info;
+    bool do_profiling_output;
+}
+RenderScene;
+
+// JOBS
+
+// work-stealing job system, implemented by the platform layer. each thread has its own deque: it pushes and pops its own jobs LIFO,
+// and takes the oldest job from another thread's deque when it runs out. a job can spawn more jobs and wait on them.
+typedef void JobFunction(void* data);
+
+// number of jobs still outstanding. zero-initialise, pass to jobsRun, then jobsWait on it. can be reused once waited on
+typedef struct JobCounter
+{
+    volatile long pending;
+}
+JobCounter;
+
 // FUCNTIONS
 
+void jobsInitialize(int32 worker_count); // 0 picks one worker per core, besides the main thread
+void jobsRun(JobFunction* function, void* data, JobCounter* counter);
+void jobsRunBatch(JobFunction* function, void* data, int32 data_stride, int32 count, JobCounter* counter); // one job per element of an array
+void jobsWait(JobCounter* counter); // runs queued jobs while waiting, so it is safe to call from inside a job
+int32 jobsThreadCount(); // workers + main thread
+void jobsBenchmark();
+
+void renderPublishSnapshot(DrawCommand* draw_commands, int32 draw_command_count, RendererInfo renderer_info, bool do_profiling_output);
+
 void gameInitialize(char* level_name, DisplayInfo);
 GameResult gameFrame(double delta_time, Input*);
 void gameRedraw(DisplayInfo);
+int32 gameInterpolateSnapshots(RenderSnapshot* previous, RenderSnapshot* latest, RenderScene* scene, float t, DrawCommand* out_draw_commands, RendererInfo* out_renderer_info); // safe to call from the render thread
+int32 gameFallGatingCheck(char* level_name, int32 tick_count, uint32 seed); // replays a level with seeded input, counting where the falling pass's column gate and full scan disagree
 
 void vulkanInitialize(RendererPlatformHandles, DisplayInfo);
 void vulkanResize(uint32 width, uint32 height);
 void vulkanSubmitFrame(DrawCommand* draw_commands, int32 draw_command_count, RendererInfo renderer_info);
 void vulkanDraw(bool do_profiling_output);
 void vulkanReloadChangedModels();
+void transformBenchmark(); // batch instance transforms against mat4BuildTRS
+void bakeModelBlobs(); // .glb models to the blobs loadModel maps
+void bakeTextureAtlases(); // atlas pngs to the dds cache loadAtlases uploads
+void vulkanDiscardPipelineCache(); // deletes the saved pipeline cache, so the next start compiles every pipeline
+void vulkanFftBenchmark(); // times both water fft paths on the gpu, after vulkanInitialize
@@ -7,12 +7,17 @@
 #include "external/cgltf.h"
 #include "everything.h"
 
-// TEMP: for profiling
+// TEMP: for profiling. also file mapping for the baked model blobs
 #include <windows.h>
 
 // TEMP: for editor reloading stuff
 #include <sys/stat.h>
 
+#if defined(_M_X64) || defined(__SSE2__)
+#define TRANSFORM_SIMD 1
+#include <immintrin.h>
+#endif
+
 typedef struct 
 {
     float x, y, z;
@@ -36,9 +41,8 @@ typedef struct
 {
 	uint32 asset_index;
     Vec3 coords;
-    Vec3 scale;
     Vec4 rotation;
-    Vec4 uv;
+    uint16 atlas_cell;
 }
 Cube;
 
@@ -91,15 +95,75 @@ typedef struct
 }
 LaserLightsBuffer;
 
-// for instancing of cubes. not required in main build
+// for instancing of cubes. not required in main build. cubes are always unit scale, so an instance is a fixed point
+// position and a quaternion that cube-instance.glsl turns back into a matrix, plus the atlas cell for the face strip
 typedef struct 
 {
-    float model[16];
-    Vec4 uv_rect;
-    float padding[4];
+    int16 position[3]; // in 1 / CUBE_POSITION_UNITS_PER_TILE tiles, relative to level_aabb_min
+    uint16 atlas_cell;
+    int16 rotation[4]; // snorm
 }
 CubeInstanceData;
 
+#define STATIC_MESH_CHUNK_SIZE 16 // tiles per side of a mesh column
+#define MAX_STATIC_MESH_CHUNKS 1024
+
+// one column of the static level mesh. laid out for the cull shader
+typedef struct
+{
+    Vec4 aabb_min; // w unused
+    Vec4 aabb_max;
+    uint32 first_index;
+    uint32 index_count;
+    uint32 padding[2];
+}
+StaticMeshChunk;
+
+// views the cull pass runs for. the shadow view reads light_view_proj out of the VIEW_MAIN block
+#define CULL_VIEW_MAIN 0
+#define CULL_VIEW_REFLECTION 1
+#define CULL_VIEW_SHADOW 2
+#define CULL_VIEW_COUNT 3
+
+// what the cull pass leaves behind per view; drawCubes reads it as indirect arguments
+typedef struct
+{
+    uint32 static_draw_count; // compacted chunk draws
+    VkDrawIndexedIndirectCommand cube_draw; // instance_count is the number of visible cubes
+}
+CullViewCounts;
+
+typedef struct
+{
+    uint32 view;
+    uint32 use_light_view;
+    uint32 chunk_count;
+    uint32 cube_count;
+    uint32 max_chunk_count;
+    uint32 cube_capacity;
+}
+CullPushConstants;
+
+// translation, quaternion and scale split by component, so the batch transform builder loads 4 or 8 instances per register.
+// sized for the largest instance list (and the benchmark), plus a batch of padding
+#define TRANSFORM_LANE_CAPACITY (16384 + 8)
+
+typedef struct TransformLanes
+{
+    int32 count;
+    float position_x[TRANSFORM_LANE_CAPACITY];
+    float position_y[TRANSFORM_LANE_CAPACITY];
+    float position_z[TRANSFORM_LANE_CAPACITY];
+    float rotation_x[TRANSFORM_LANE_CAPACITY];
+    float rotation_y[TRANSFORM_LANE_CAPACITY];
+    float rotation_z[TRANSFORM_LANE_CAPACITY];
+    float rotation_w[TRANSFORM_LANE_CAPACITY];
+    float scale_x[TRANSFORM_LANE_CAPACITY];
+    float scale_y[TRANSFORM_LANE_CAPACITY];
+    float scale_z[TRANSFORM_LANE_CAPACITY];
+}
+TransformLanes;
+
 // instancing water. this might be the permanent solution here?
 typedef struct
 {
@@ -123,6 +187,8 @@ typedef struct
 	VkImage image;
     VkDeviceMemory memory;
     VkImageView view;
+    int32 width;
+    int32 height;
     char path[256];
 }
 CachedAsset;
@@ -143,7 +209,8 @@ typedef struct ViewConstants
     float time;
     float water_tile_length;
     float focal_length;
-    
+    float _[3]; // std140 puts the vec4 below on a 16 byte boundary
+    Vec4 atlas_3d_cell; // xy: uv size of one cube cell, z: cells per row. see buildSpriteUvTable
 }
 ViewConstants;
 
@@ -152,20 +219,23 @@ ViewConstants;
 #define VIEW_SPRITE 2
 #define VIEW_BLOCK_COUNT 3
 
-typedef struct SpritePushConstants
+// one per drawn sprite or glyph. sprites are never rotated, so sprite.vert builds the transform from coords and size
+typedef struct SpriteInstanceData
 {
-    float model[16];
+    Vec3 coords;
+    float alpha;
     Vec4 uv_rect;
-    Vec4 color;
+    Vec2 size;
 }
-SpritePushConstants;
+SpriteInstanceData;
 
-typedef struct ModelPushConstants
+// one per drawn model, read through gl_InstanceIndex by model.vert and shadow-model.vert
+typedef struct ModelInstanceData
 {
     float model[16];
     Vec4 color;
 }
-ModelPushConstants;
+ModelInstanceData;
 
 typedef struct OutlinePushConstants
 {
@@ -203,6 +273,7 @@ typedef struct
     float water_tile_length;
     float gravity;
     float time;
+    float loop_period;
 }
 FFTEvolvedPushConstants;
 
@@ -221,6 +292,22 @@ typedef struct
 }
 FFTFinalizePushConstants;
 
+typedef struct
+{
+    int32 texture_size;
+    float water_tile_length;
+}
+FFTRowsPushConstants;
+
+// which two water frames to blend between
+typedef struct
+{
+    int32 frame_a;
+    int32 frame_b;
+    float frame_blend;
+}
+WaterPushConstants;
+
 typedef struct
 {
     cgltf_data* data;
@@ -228,10 +315,49 @@ typedef struct
     VkDeviceMemory vertex_memory;
     VkBuffer index_buffer;
     VkDeviceMemory index_memory;
+    uint32 vertex_count;
     uint32 index_count;
+    Vec3 bounds_min;
+    Vec3 bounds_max;
 }
 LoadedModel;
 
+// final vertex and index arrays of a model, merged across primitives
+typedef struct
+{
+    Vertex* vertices;
+    uint32* indices;
+    uint32 vertex_count;
+    uint32 index_count;
+    Vec3 bounds_min;
+    Vec3 bounds_max;
+}
+ModelGeometry;
+
+// baked model blob: this header, then vertex_count Vertex, then index_count uint32
+typedef struct
+{
+    uint32 magic;
+    uint32 version;
+    uint32 vertex_size; // sizeof(Vertex) at bake time, so a layout change also makes the blob stale
+    uint32 vertex_count;
+    uint32 index_count;
+    uint32 _;
+    int64 source_write_time;
+    Vec3 bounds_min;
+    Vec3 bounds_max;
+}
+ModelBlobHeader;
+
+typedef struct
+{
+    HANDLE file;
+    HANDLE mapping;
+    uint8* view;
+    ModelBlobHeader* header;
+}
+MappedModelBlob;
+
 typedef struct
 {
     uint32 vertex_offset; // in vertices
@@ -250,7 +376,7 @@ typedef struct VulkanState
     float time;
     float water_plane_y;
     ShaderMode shader_mode;
-    WaterPaintTexture* water_paint_texture;
+    const WaterPaintTexture* water_paint_texture; // the render thread's copy, see renderPublishSnapshot
     Vec3 sun_direction;
 
     // platform and instance
@@ -267,6 +393,8 @@ typedef struct VulkanState
     uint64 timestamp_results[3][32];
     bool timestamp_pool_valid[3];
     uint32 timestamp_frame_index;
+    double region_time_total_ms[16]; // each timestamp region summed over every frame since the last output, for per frame averages
+    uint32 region_time_frame_count;
 
     // device and queues
     uint32 graphics_family_index;
@@ -322,6 +450,16 @@ typedef struct VulkanState
     VkDescriptorSetLayout storage_image_descriptor_set_layout;
     VkDescriptorSetLayout ssbo_descriptor_set_layout;
 
+    // weighted blended OIT targets, the alternative to the linked lists above
+    VkImage wboit_accumulation_image;
+    VkDeviceMemory wboit_accumulation_memory;
+    VkImageView wboit_accumulation_view;
+    VkDescriptorSet wboit_accumulation_descriptor_set;
+    VkImage wboit_revealage_image;
+    VkDeviceMemory wboit_revealage_memory;
+    VkImageView wboit_revealage_view;
+    VkDescriptorSet wboit_revealage_descriptor_set;
+
     // FFT resources for water surface
 
     // h0 spectrum at startup
@@ -343,12 +481,34 @@ typedef struct VulkanState
     VkDescriptorSet fft_buffer_b_descriptor_set;
     VkDescriptorSet fft_buffer_b_sampled_descriptor_set;
 
+    // shared memory fft: height and slope spectra after the row pass, read by the column pass
+    VkImage fft_rows_image;
+    VkDeviceMemory fft_rows_image_memory;
+    VkImageView fft_rows_image_view;
+    VkDescriptorSet fft_rows_descriptor_set;
+
     // real valued heightfield for water vertex shader TODO: rename water_ TODO: maybe still use this?
     VkImage displacement_image;
     VkDeviceMemory displacement_image_memory;
     VkImageView displacement_image_view;
     VkDescriptorSet displacement_descriptor_set;
     VkDescriptorSet displacement_sampled_descriptor_set;
+    VkImageView displacement_array_image_view; // single layer array view, so the water shaders read it like the baked loop
+    VkDescriptorSet displacement_array_sampled_descriptor_set;
+
+    // baked water loop, WATER_LOOP_FRAME_COUNT layers of the displacement image
+    VkImage water_loop_image;
+    VkDeviceMemory water_loop_image_memory;
+    VkImageView water_loop_image_view;
+    VkDescriptorSet water_loop_sampled_descriptor_set;
+
+    // reduced rate water: the last two updates, each in the layer given by its tick's parity
+    VkImage water_history_image;
+    VkDeviceMemory water_history_image_memory;
+    VkImageView water_history_image_view;
+    VkDescriptorSet water_history_sampled_descriptor_set;
+    int32 water_history_ticks[2]; // which update each layer holds, -1 for none
+    WaterMode water_mode;
 
     // reflections
     VkImage reflection_color_image;
@@ -379,11 +539,21 @@ typedef struct VulkanState
     VkImageView shadow_map_image_view;
     VkDescriptorSet shadow_map_descriptor_set;
 
+    // depth of the static level alone. copied into the shadow map each frame before dynamic casters are drawn
+    VkImage shadow_static_image;
+    VkDeviceMemory shadow_static_image_memory;
+    VkImageView shadow_static_image_view;
+    bool shadow_static_valid;
+    uint32 shadow_static_mesh_version; // static_mesh_version it was rendered from
+    float shadow_static_light_view_proj[16]; // and the light matrix, which covers sun_direction and the level bounds
+
     // RENDER PASSES
 
     // shadow map pass
-    VkRenderPass shadow_render_pass;
+    VkRenderPass shadow_render_pass; // loads the static depth copied in beforehand
     VkFramebuffer shadow_framebuffer;
+    VkRenderPass shadow_static_render_pass;
+    VkFramebuffer shadow_static_framebuffer;
 
     // scene pass
     VkRenderPass render_pass_handle;
@@ -405,6 +575,10 @@ typedef struct VulkanState
     VkRenderPass reflection_render_pass;
     VkFramebuffer reflection_framebuffer; // just 1
 
+    // weighted blended laser accumulation pass
+    VkRenderPass wboit_render_pass;
+    VkFramebuffer wboit_framebuffer;
+
     // PIPELINES AND LAYOUTS
 
     VkPipelineLayout default_graphics_pipeline_layout;
@@ -435,6 +609,12 @@ typedef struct VulkanState
     VkPipeline oit_resolve_pipeline;
     VkPipelineLayout oit_resolve_pipeline_layout;
 
+    VkPipeline laser_wboit_pipeline;
+    VkPipelineLayout laser_wboit_pipeline_layout;
+
+    VkPipeline oit_wboit_resolve_pipeline;
+    VkPipelineLayout oit_wboit_resolve_pipeline_layout;
+
     VkPipeline sprite_pipeline;
     VkPipelineLayout sprite_pipeline_layout;
 
@@ -450,6 +630,12 @@ typedef struct VulkanState
     VkPipeline fft_finalize_pipeline;             
     VkPipelineLayout fft_finalize_pipeline_layout;
 
+    VkPipeline fft_rows_pipeline;
+    VkPipelineLayout fft_rows_pipeline_layout;
+
+    VkPipeline fft_columns_pipeline;
+    VkPipelineLayout fft_columns_pipeline_layout;
+
     VkPipeline shadow_cube_pipeline;
     VkPipeline shadow_model_pipeline;
     VkPipelineLayout shadow_pipeline_layout;
@@ -493,6 +679,7 @@ typedef struct VulkanState
     void* paint_staging_mapped;
 
     bool paint_image_first_upload;
+    uint32 paint_uploaded_generation; // WaterPaintTexture generation last copied into paint_image
 
     // geometry buffers
 	VkBuffer sprite_vertex_buffer;
@@ -513,6 +700,34 @@ typedef struct VulkanState
     void* cube_instance_mappeds[2];
     uint32 cube_instance_capacity;
 
+    // static tiles, greedy meshed (see buildStaticLevelMesh)
+    VkBuffer static_mesh_vertex_buffer;
+    VkDeviceMemory static_mesh_vertex_memory;
+    VkBuffer static_mesh_index_buffer;
+    VkDeviceMemory static_mesh_index_memory;
+    uint32 static_mesh_index_count;
+    VkBuffer static_mesh_instance_buffer; // one identity instance
+    VkDeviceMemory static_mesh_instance_memory;
+    uint32 static_mesh_version; // static_draw_version the mesh was built from
+    Vec3 static_mesh_origin; // level_aabb_min the vertices are relative to, like cube instances
+    StaticMeshChunk static_mesh_chunks[MAX_STATIC_MESH_CHUNKS];
+    uint32 static_mesh_chunk_count;
+
+    // gpu culling (see cull.comp). everything is per frame in flight
+    VkPipeline cull_pipeline;
+    VkPipelineLayout cull_pipeline_layout;
+    VkDescriptorSetLayout cull_descriptor_set_layout;
+    VkDescriptorSet cull_descriptor_sets[2];
+    VkBuffer cull_chunk_buffers[2]; // chunk bounds in, host visible
+    VkDeviceMemory cull_chunk_memories[2];
+    void* cull_chunk_mappeds[2];
+    VkBuffer cull_static_draw_buffers[2]; // compacted chunk draws, MAX_STATIC_MESH_CHUNKS per view
+    VkDeviceMemory cull_static_draw_memories[2];
+    VkBuffer cull_cube_instance_buffers[2]; // compacted cube instances, CUBE_INSTANCE_CAPACITY per view
+    VkDeviceMemory cull_cube_instance_memories[2];
+    VkBuffer cull_count_buffers[2]; // CullViewCounts per view
+    VkDeviceMemory cull_count_memories[2];
+
     // TODO: no longer need to be instanced, because only one water quad
     VkBuffer water_instance_buffers[2];
     VkDeviceMemory water_instance_memories[2];
@@ -524,6 +739,10 @@ typedef struct VulkanState
     void* laser_instance_mappeds[2];
     uint32 laser_instance_capacity;
 
+    VkBuffer sprite_instance_buffers[2];
+    VkDeviceMemory sprite_instance_memories[2];
+    void* sprite_instance_mappeds[2];
+
     // laser lights resources
     VkBuffer laser_lights_buffers[2];
     VkDeviceMemory laser_lights_memories[2];
@@ -535,6 +754,24 @@ typedef struct VulkanState
     LoadedModel laser_cylinder_model; // TODO: probably index everything into loaded models; figure out what order i want to put stuff in, if can't just take their id
     LoadedModel dummy_cube_model;
 
+    // every loaded_models entry packed into one vertex / index buffer, so all model instances go out in one indirect draw
+    VkBuffer model_mega_vertex_buffer;
+    VkDeviceMemory model_mega_vertex_memory;
+    VkBuffer model_mega_index_buffer;
+    VkDeviceMemory model_mega_index_memory;
+    ModelMeshInfo model_mesh_infos[64]; // indexed like loaded_models
+
+    VkBuffer model_instance_buffers[2];
+    VkDeviceMemory model_instance_memories[2];
+    void* model_instance_mappeds[2];
+    VkDescriptorSet model_instance_descriptor_sets[2];
+    bool draw_indirect_first_instance; // without it indirect draws need firstInstance 0, so drawModels issues the draws directly
+    bool multi_draw_indirect; // without it an indirect draw carries one command, so the static mesh and model draws are recorded one by one
+    bool draw_indirect_count; // without it the cull pass zeroes the chunk draw list first, and drawStaticMesh draws every slot
+    VkBuffer model_draw_buffers[2]; // one VkDrawIndexedIndirectCommand per model in use
+    VkDeviceMemory model_draw_memories[2];
+    void* model_draw_mappeds[2];
+
     // OIT stuff
     VkBuffer oit_fragment_pool;
     VkDeviceMemory oit_fragment_pool_memory;
@@ -543,6 +780,10 @@ typedef struct VulkanState
     VkBuffer oit_counter_buffer;
     VkDeviceMemory oit_counter_memory;
     VkDescriptorSet oit_counter_descriptor_set;
+
+    // every pipeline is created through this, and it is saved to PIPELINE_CACHE_PATH once they all exist
+    VkPipelineCache pipeline_cache;
+    bool pipeline_cache_warm; // started from the saved file rather than empty
 }
 VulkanState;
 
@@ -620,6 +861,11 @@ typedef struct
 }
 ModelAsset;
 
+#define MODEL_BLOB_MAGIC 0x48534D43 // "CMSH"
+#define MODEL_BLOB_VERSION 1
+const char* MODEL_SOURCE_FOLDER = "data/assets/models";
+const char* MODEL_BLOB_FOLDER = "data/meta/models";
+
 ModelAsset model_assets[] =
 {
     { MODEL_3D_BOX,            "data/assets/models/rock.glb",           0 },
@@ -635,33 +881,57 @@ ModelAsset model_assets[] =
 int32 model_asset_count = sizeof(model_assets) / sizeof(model_assets[0]);
 
 const uint32 CUBE_INSTANCE_CAPACITY = 8192;
+const float CUBE_POSITION_UNITS_PER_TILE = 128.0f; // int16 positions cover +-256 tiles around level_aabb_min. mirrored in cube-instance.glsl
 const uint32 WATER_INSTANCE_CAPACITY = 8192;
 const uint32 LASER_INSTANCE_CAPACITY = 1024;
+const uint32 MODEL_INSTANCE_CAPACITY = 1024;
+const uint32 SPRITE_INSTANCE_CAPACITY = 8192; // the last slot is kept for the debug quad, which goes after the frame's sprites
 
 const int32 REFLECTION_DOWNSCALE = 2;
 
 const uint32 SHADOW_MAP_RESOLUTION = 2048;
 
-// TODO: set these in loadAsset where stb_image gives me width / height. store in CachedAsset.
-const int32 ATLAS_2D_WIDTH = 128;
-const int32 ATLAS_2D_HEIGHT = 128;
-const int32 ATLAS_FONT_WIDTH = 120;
-const int32 ATLAS_FONT_HEIGHT = 180;
-const int32 ATLAS_3D_WIDTH = 480;
-const int32 ATLAS_3D_HEIGHT = 320;
-
 const char* ATLAS_2D_PATH 	       = "data/assets/sprites/atlas-2d.png";
 const char* ATLAS_FONT_PATH        = "data/assets/sprites/atlas-font.png";
 const char* ATLAS_3D_PATH 	       = "data/assets/sprites/atlas-3d.png";
 const char* WATER_GRID_PATH        = "data/assets/maps/water-grid/water-grid.dds";
 const char* WATER_GRID_NORMAL_PATH = "data/assets/maps/water-grid/water-grid-normal.dds";
 
+// baked atlases are a dds cache of the atlas pngs, tagged in the header's reserved words, see writeBakedTexture. the atlases
+// are drawn by hand rather than packed from separate sprites, so there is nothing to pack at bake time
+#define BAKED_TEXTURE_MAGIC 0x53555243 // "CRUS"
+#define BAKED_TEXTURE_VERSION 2
+#define BAKED_TEXTURE_COVERAGE_MASK 0x1 // BC4 alpha of a white image
+const char* TEXTURE_BAKE_FOLDER = "data/meta/textures";
+
+// driver compiled pipelines from the last run, see createPipelineCache
+const char* PIPELINE_CACHE_PATH = "data/meta/pipeline-cache.bin";
+#define MAX_QUEUED_GRAPHICS_PIPELINES 32
+#define MAX_QUEUED_COMPUTE_PIPELINES 16
+
+// uv rect (u0, v0, u1, v1) of every sprite and cube cell, from the sizes of the loaded atlases. see buildSpriteUvTable
+Vec4 sprite_uv_table[SPRITEID_ASSET_COUNT];
+Vec4 atlas_3d_cell; // the cube cell layout the shaders use for atlas_cell, in the same units. see ViewConstants
+
 VulkanState vulkan_state;
 DisplayInfo vulkan_display = {0};
 
 // water
 const float water_tile_length = 10.0f;
 const float water_amplitude = 1e-5f;
+bool use_shared_memory_fft = true; // false runs the original per level passes. vulkanFftBenchmark times both
+
+// the spectrum never changes, so with frequencies quantized to the loop period one loop can be baked at startup and played back
+// (WATER_MODE_BAKED_LOOP). otherwise the live simulation runs either at water_update_rate, with the water blending between the
+// last two updates, or every frame. the game switches between them at runtime, to compare the "fft" timestamp region, which
+// also prints its average per frame
+#define WATER_LOOP_FRAME_COUNT 64
+const float water_loop_period = 6.4f;
+const float water_update_rate = 30.0f;
+
+// lasers: weighted blended OIT (SHADER_MODE_WEIGHTED_BLENDED_OIT) accumulates into two blended targets with no atomics or
+// fragment pool, and resolves at a constant cost per pixel. the default keeps the per pixel linked lists. both are always
+// built so the shader mode can switch between them at runtime, to compare the two under the "overlay" timestamp region
 
 // outlines
 const float depth_threshold = 1.5f;
@@ -672,6 +942,8 @@ uint32 cube_instance_count = 0;
 
 Model model_instances[1024];
 uint32 model_instance_count = 0;
+uint32 model_draw_count = 0;
+VkDrawIndexedIndirectCommand model_draw_commands[64]; // this frame's, also copied into model_draw_buffers
 
 Water water_instances[8192];
 uint32 water_instance_count = 0;
@@ -685,6 +957,8 @@ uint32 laser_instance_count = 0;
 Sprite sprite_instances[8192];
 uint32 sprite_instance_count = 0;
 
+TransformLanes transform_lanes; // scratch for whichever instance list is being built
+
 void mat4Identity(float matrix[16]) 
 {
 	memset(matrix, 0, sizeof(float) * 16);
@@ -817,6 +1091,331 @@ void mat4BuildBasicTRS(float output_matrix[16], Vec3 translation)
     output_matrix[14] = translation.z;
 }
 
+// BATCH TRANSFORMS
+
+// same matrices as mat4BuildTRS, built for a whole instance list at once and written straight into the mapped instance
+// buffers. lane i lands at output + i * output_stride, so it fills ModelInstanceData / WaterInstanceData in place
+
+void setTransformLane(TransformLanes* lanes, int32 lane, Vec3 translation, Vec4 quaternion, Vec3 scale)
+{
+    lanes->position_x[lane] = translation.x;
+    lanes->position_y[lane] = translation.y;
+    lanes->position_z[lane] = translation.z;
+    lanes->rotation_x[lane] = quaternion.x;
+    lanes->rotation_y[lane] = quaternion.y;
+    lanes->rotation_z[lane] = quaternion.z;
+    lanes->rotation_w[lane] = quaternion.w;
+    lanes->scale_x[lane] = scale.x;
+    lanes->scale_y[lane] = scale.y;
+    lanes->scale_z[lane] = scale.z;
+}
+
+#if defined(TRANSFORM_SIMD)
+// columns[column][component] each hold one matrix element for four instances. transposing turns that into four columns,
+// one per instance
+void storeTransformColumns(uint8* output, size_t output_stride, int32 lane_count, __m128 columns[4][4])
+{
+    for (int32 column = 0; column < 4; column++)
+    {
+        __m128 instance_0 = columns[column][0];
+        __m128 instance_1 = columns[column][1];
+        __m128 instance_2 = columns[column][2];
+        __m128 instance_3 = columns[column][3];
+        _MM_TRANSPOSE4_PS(instance_0, instance_1, instance_2, instance_3);
+
+        __m128 instance_columns[4] = { instance_0, instance_1, instance_2, instance_3 };
+        for (int32 lane = 0; lane < lane_count; lane++) _mm_storeu_ps((float*)(output + lane * output_stride) + column * 4, instance_columns[lane]);
+    }
+}
+#endif
+
+void buildTransformLanes(TransformLanes* lanes, void* output, size_t output_stride)
+{
+    uint8* output_bytes = (uint8*)output;
+
+    // zero the padding lanes so the last batch reads defined values. a zero quaternion builds the identity, like
+    // mat4BuildRotation, and padding lanes are never stored
+    int32 padded_count = (lanes->count + 7) & ~7;
+    for (int32 lane = lanes->count; lane < padded_count; lane++) setTransformLane(lanes, lane, (Vec3){0}, (Vec4){0}, (Vec3){0});
+
+#if defined(__AVX__)
+    for (int32 lane = 0; lane < padded_count; lane += 8)
+    {
+        __m256 one = _mm256_set1_ps(1.0f);
+        __m256 two = _mm256_set1_ps(2.0f);
+
+        __m256 x = _mm256_loadu_ps(&lanes->rotation_x[lane]);
+        __m256 y = _mm256_loadu_ps(&lanes->rotation_y[lane]);
+        __m256 z = _mm256_loadu_ps(&lanes->rotation_z[lane]);
+        __m256 w = _mm256_loadu_ps(&lanes->rotation_w[lane]);
+
+        // normalize, with degenerate quaternions becoming the identity
+        __m256 length_squared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_add_ps(_mm256_mul_ps(z, z), _mm256_mul_ps(w, w)));
+        __m256 degenerate = _mm256_cmp_ps(length_squared, _mm256_set1_ps(1e-8f), _CMP_LT_OQ);
+        __m256 inv_length = _mm256_div_ps(one, _mm256_sqrt_ps(length_squared));
+        x = _mm256_andnot_ps(degenerate, _mm256_mul_ps(x, inv_length));
+        y = _mm256_andnot_ps(degenerate, _mm256_mul_ps(y, inv_length));
+        z = _mm256_andnot_ps(degenerate, _mm256_mul_ps(z, inv_length));
+        w = _mm256_blendv_ps(_mm256_mul_ps(w, inv_length), one, degenerate);
+
+        __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+        __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+        __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+        __m256 scale_x = _mm256_loadu_ps(&lanes->scale_x[lane]);
+        __m256 scale_y = _mm256_loadu_ps(&lanes->scale_y[lane]);
+        __m256 scale_z = _mm256_loadu_ps(&lanes->scale_z[lane]);
+
+        __m256 columns[4][4];
+        columns[0][0] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), scale_x);
+        columns[0][1] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), scale_x);
+        columns[0][2] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), scale_x);
+        columns[0][3] = _mm256_setzero_ps();
+        columns[1][0] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), scale_y);
+        columns[1][1] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), scale_y);
+        columns[1][2] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), scale_y);
+        columns[1][3] = _mm256_setzero_ps();
+        columns[2][0] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), scale_z);
+        columns[2][1] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), scale_z);
+        columns[2][2] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))), scale_z);
+        columns[2][3] = _mm256_setzero_ps();
+        columns[3][0] = _mm256_loadu_ps(&lanes->position_x[lane]);
+        columns[3][1] = _mm256_loadu_ps(&lanes->position_y[lane]);
+        columns[3][2] = _mm256_loadu_ps(&lanes->position_z[lane]);
+        columns[3][3] = one;
+
+        // stored as two halves of four
+        for (int32 half = 0; half < 2; half++)
+        {
+            int32 first_lane = lane + half * 4;
+            int32 lane_count = lanes->count - first_lane;
+            if (lane_count <= 0) break;
+            if (lane_count > 4) lane_count = 4;
+
+            __m128 half_columns[4][4];
+            for (int32 column = 0; column < 4; column++)
+            {
+                for (int32 component = 0; component < 4; component++)
+                {
+                    half_columns[column][component] = half == 0 ? _mm256_castps256_ps128(columns[column][component]) : _mm256_extractf128_ps(columns[column][component], 1);
+                }
+            }
+            storeTransformColumns(output_bytes + first_lane * output_stride, output_stride, lane_count, half_columns);
+        }
+    }
+#elif defined(TRANSFORM_SIMD)
+    for (int32 lane = 0; lane < padded_count; lane += 4)
+    {
+        int32 lane_count = lanes->count - lane;
+        if (lane_count <= 0) break;
+        if (lane_count > 4) lane_count = 4;
+
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 two = _mm_set1_ps(2.0f);
+
+        __m128 x = _mm_loadu_ps(&lanes->rotation_x[lane]);
+        __m128 y = _mm_loadu_ps(&lanes->rotation_y[lane]);
+        __m128 z = _mm_loadu_ps(&lanes->rotation_z[lane]);
+        __m128 w = _mm_loadu_ps(&lanes->rotation_w[lane]);
+
+        // normalize, with degenerate quaternions becoming the identity
+        __m128 length_squared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+        __m128 degenerate = _mm_cmplt_ps(length_squared, _mm_set1_ps(1e-8f));
+        __m128 inv_length = _mm_div_ps(one, _mm_sqrt_ps(length_squared));
+        x = _mm_andnot_ps(degenerate, _mm_mul_ps(x, inv_length));
+        y = _mm_andnot_ps(degenerate, _mm_mul_ps(y, inv_length));
+        z = _mm_andnot_ps(degenerate, _mm_mul_ps(z, inv_length));
+        w = _mm_or_ps(_mm_and_ps(degenerate, one), _mm_andnot_ps(degenerate, _mm_mul_ps(w, inv_length)));
+
+        __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+        __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+        __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+        __m128 scale_x = _mm_loadu_ps(&lanes->scale_x[lane]);
+        __m128 scale_y = _mm_loadu_ps(&lanes->scale_y[lane]);
+        __m128 scale_z = _mm_loadu_ps(&lanes->scale_z[lane]);
+
+        __m128 columns[4][4];
+        columns[0][0] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), scale_x);
+        columns[0][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), scale_x);
+        columns[0][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), scale_x);
+        columns[0][3] = _mm_setzero_ps();
+        columns[1][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), scale_y);
+        columns[1][1] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), scale_y);
+        columns[1][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), scale_y);
+        columns[1][3] = _mm_setzero_ps();
+        columns[2][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), scale_z);
+        columns[2][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), scale_z);
+        columns[2][2] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), scale_z);
+        columns[2][3] = _mm_setzero_ps();
+        columns[3][0] = _mm_loadu_ps(&lanes->position_x[lane]);
+        columns[3][1] = _mm_loadu_ps(&lanes->position_y[lane]);
+        columns[3][2] = _mm_loadu_ps(&lanes->position_z[lane]);
+        columns[3][3] = one;
+
+        storeTransformColumns(output_bytes + lane * output_stride, output_stride, lane_count, columns);
+    }
+#else
+    for (int32 lane = 0; lane < lanes->count; lane++)
+    {
+        float x = lanes->rotation_x[lane], y = lanes->rotation_y[lane], z = lanes->rotation_z[lane], w = lanes->rotation_w[lane];
+        float length_squared = x*x + y*y + z*z + w*w;
+        if (length_squared < 1e-8f)
+        {
+            x = 0.0f; y = 0.0f; z = 0.0f; w = 1.0f;
+        }
+        else
+        {
+            float inv_length = 1.0f / sqrtf(length_squared);
+            x *= inv_length; y *= inv_length; z *= inv_length; w *= inv_length;
+        }
+
+        float scale_x = lanes->scale_x[lane], scale_y = lanes->scale_y[lane], scale_z = lanes->scale_z[lane];
+        float* m = (float*)(output_bytes + lane * output_stride);
+        m[0]  = (1.0f - 2.0f*(y*y + z*z)) * scale_x;
+        m[1]  = 2.0f*(x*y + w*z) * scale_x;
+        m[2]  = 2.0f*(x*z - w*y) * scale_x;
+        m[3]  = 0.0f;
+        m[4]  = 2.0f*(x*y - w*z) * scale_y;
+        m[5]  = (1.0f - 2.0f*(x*x + z*z)) * scale_y;
+        m[6]  = 2.0f*(y*z + w*x) * scale_y;
+        m[7]  = 0.0f;
+        m[8]  = 2.0f*(x*z + w*y) * scale_z;
+        m[9]  = 2.0f*(y*z - w*x) * scale_z;
+        m[10] = (1.0f - 2.0f*(x*x + y*y)) * scale_z;
+        m[11] = 0.0f;
+        m[12] = lanes->position_x[lane];
+        m[13] = lanes->position_y[lane];
+        m[14] = lanes->position_z[lane];
+        m[15] = 1.0f;
+    }
+#endif
+}
+
+// CUBE INSTANCES
+
+int16 packCubeSnorm(float value)
+{
+    if (value > 1.0f) value = 1.0f;
+    if (value < -1.0f) value = -1.0f;
+    return (int16)roundf(value * 32767.0f);
+}
+
+// coords are packed relative to origin, which the shaders add back from ViewConstants.level_aabb_min. levels sit
+// hundreds of tiles from the world origin, so absolute coordinates would not fit. anything that would still clamp
+// is a bug, not something to draw at the edge of the range
+CubeInstanceData packCubeInstance(Vec3 coords, Vec3 origin, Vec4 rotation, uint16 atlas_cell)
+{
+    CubeInstanceData instance = {0};
+
+    float coordinates[3] = { coords.x - origin.x, coords.y - origin.y, coords.z - origin.z };
+    for (int32 axis = 0; axis < 3; axis++)
+    {
+        float units = roundf(coordinates[axis] * CUBE_POSITION_UNITS_PER_TILE);
+        assert(units <= 32767.0f && units >= -32768.0f);
+        if (units > 32767.0f) units = 32767.0f;
+        if (units < -32768.0f) units = -32768.0f;
+        instance.position[axis] = (int16)units;
+    }
+    instance.atlas_cell = atlas_cell;
+
+    // normalized before quantizing so every component uses the full snorm range. degenerate rotations become identity,
+    // like mat4BuildRotation
+    float length_squared = rotation.x*rotation.x + rotation.y*rotation.y + rotation.z*rotation.z + rotation.w*rotation.w;
+    if (length_squared < 1e-8f) rotation = (Vec4){ 0, 0, 0, 1 };
+    else
+    {
+        float inv_length = 1.0f / sqrtf(length_squared);
+        rotation = (Vec4){ rotation.x * inv_length, rotation.y * inv_length, rotation.z * inv_length, rotation.w * inv_length };
+    }
+    instance.rotation[0] = packCubeSnorm(rotation.x);
+    instance.rotation[1] = packCubeSnorm(rotation.y);
+    instance.rotation[2] = packCubeSnorm(rotation.z);
+    instance.rotation[3] = packCubeSnorm(rotation.w);
+
+    return instance;
+}
+
+// batch builder against the scalar path it replaces, over a cube list sized set of random transforms. results go to the
+// debugger output
+void transformBenchmark()
+{
+    LARGE_INTEGER ticks_per_second, start, end;
+    QueryPerformanceFrequency(&ticks_per_second);
+    char output[256];
+
+    const int32 transform_count = 16384;
+    const int32 repeats = 5;
+
+    static TransformLanes lanes;
+    static ModelInstanceData batch_output[16384];
+    static float scalar_output[16384][16];
+    static float rotation_output[16384][16];
+
+    uint32 random_state = 12345;
+    lanes.count = transform_count;
+    for (int32 lane = 0; lane < transform_count; lane++)
+    {
+        float random[10];
+        for (int32 random_index = 0; random_index < 10; random_index++)
+        {
+            random_state = random_state * 1664525u + 1013904223u;
+            random[random_index] = (float)(random_state >> 8) / (float)(1 << 24) * 2.0f - 1.0f;
+        }
+        setTransformLane(&lanes, lane, (Vec3){ random[0] * 100.0f, random[1] * 100.0f, random[2] * 100.0f }, (Vec4){ random[3], random[4], random[5], random[6] }, (Vec3){ 1.0f + random[7], 1.0f + random[8], 1.0f + random[9] });
+    }
+
+#if defined(__AVX__)
+    const char* path_name = "avx";
+#elif defined(TRANSFORM_SIMD)
+    const char* path_name = "sse";
+#else
+    const char* path_name = "scalar";
+#endif
+
+    for (int32 repeat = 0; repeat < repeats; repeat++)
+    {
+        QueryPerformanceCounter(&start);
+        for (int32 lane = 0; lane < transform_count; lane++)
+        {
+            Vec3 translation = { lanes.position_x[lane], lanes.position_y[lane], lanes.position_z[lane] };
+            Vec4 quaternion = { lanes.rotation_x[lane], lanes.rotation_y[lane], lanes.rotation_z[lane], lanes.rotation_w[lane] };
+            Vec3 scale = { lanes.scale_x[lane], lanes.scale_y[lane], lanes.scale_z[lane] };
+            mat4BuildTRS(scalar_output[lane], translation, quaternion, scale);
+        }
+        QueryPerformanceCounter(&end);
+        double trs_ns = (double)(end.QuadPart - start.QuadPart) * 1e9 / ticks_per_second.QuadPart / transform_count;
+
+        QueryPerformanceCounter(&start);
+        for (int32 lane = 0; lane < transform_count; lane++)
+        {
+            Vec4 quaternion = { lanes.rotation_x[lane], lanes.rotation_y[lane], lanes.rotation_z[lane], lanes.rotation_w[lane] };
+            mat4BuildRotation(rotation_output[lane], quaternion);
+        }
+        QueryPerformanceCounter(&end);
+        double rotation_ns = (double)(end.QuadPart - start.QuadPart) * 1e9 / ticks_per_second.QuadPart / transform_count;
+
+        QueryPerformanceCounter(&start);
+        buildTransformLanes(&lanes, batch_output[0].model, sizeof(ModelInstanceData));
+        QueryPerformanceCounter(&end);
+        double batch_ns = (double)(end.QuadPart - start.QuadPart) * 1e9 / ticks_per_second.QuadPart / transform_count;
+
+        float max_difference = 0.0f;
+        for (int32 lane = 0; lane < transform_count; lane++)
+        {
+            for (int32 element = 0; element < 16; element++)
+            {
+                float difference = fabsf(batch_output[lane].model[element] - scalar_output[lane][element]);
+                if (difference > max_difference) max_difference = difference;
+            }
+        }
+
+        snprintf(output, sizeof(output), "transform benchmark (%s), run %d: mat4BuildTRS %.1f ns, mat4BuildRotation %.1f ns, batch %.1f ns per transform, max difference %g\n",
+                 path_name, repeat, trs_ns, rotation_ns, batch_ns, max_difference);
+        OutputDebugStringA(output);
+    }
+}
+
 void mat4BuildViewFromQuat(float output_matrix[16], Vec3 coords, Vec4 quaternion)
 {
     mat4Identity(output_matrix);
@@ -1277,6 +1876,8 @@ int32 loadAsset(char* path, VkFormat format)
     vulkan_state.asset_cache[vulkan_state.asset_cache_count].image = texture_image;
     vulkan_state.asset_cache[vulkan_state.asset_cache_count].memory = texture_image_memory;
     vulkan_state.asset_cache[vulkan_state.asset_cache_count].view = texture_image_view;
+    vulkan_state.asset_cache[vulkan_state.asset_cache_count].width = width;
+    vulkan_state.asset_cache[vulkan_state.asset_cache_count].height = height;
     strcpy(vulkan_state.asset_cache[vulkan_state.asset_cache_count].path, path);
 
     vulkan_state.asset_cache_count++;
@@ -1295,8 +1896,8 @@ int32 getOrLoadAsset(char* path, VkFormat format)
     return loadAsset(path, format);
 }
 
-// load BC4/BC5 DDS array texture TODO: various cleanups / formatting stuff (and that imageBarrier thing)
-int32 loadDdsArray(char* path)
+// load BC4/BC5/BC7/RGBA8 DDS texture TODO: various cleanups / formatting stuff (and that imageBarrier thing)
+int32 loadDdsTexture(char* path, VkImageViewType view_type, VkSampler sampler)
 {
     void*  file_data = 0;
     size_t file_size = 0;
@@ -1314,8 +1915,12 @@ int32 loadDdsArray(char* path)
     uint32 layers = *(uint32*)(bytes + 140);
     uint8* texels = bytes + 148;
 
+    // baked atlases carry a tag in the reserved words
+    uint32 baked_flags = *(uint32*)(bytes + 32) == BAKED_TEXTURE_MAGIC ? *(uint32*)(bytes + 48) : 0;
+
     VkFormat format;
     uint32 block_bytes;
+    uint32 block_dim = 4;
     if (dxgi == 80) 
     {
         format = VK_FORMAT_BC4_UNORM_BLOCK; 
@@ -1326,11 +1931,23 @@ int32 loadDdsArray(char* path)
         format = VK_FORMAT_BC5_UNORM_BLOCK;
         block_bytes = 16;
     }
+    else if (dxgi == 98 || dxgi == 99)
+    {
+        format = dxgi == 99 ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+        block_bytes = 16;
+    }
+    else if (dxgi == 28 || dxgi == 29)
+    {
+        format = dxgi == 29 ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+        block_bytes = 4;
+        block_dim = 1;
+    }
     else
     {
         free(file_data);
         return -1;
     }
+    if (levels == 0) levels = 1;
 
     // precompute level sizes and get one slice's total size
     uint32 level_size[16] = {0};
@@ -1339,8 +1956,8 @@ int32 loadDdsArray(char* path)
     {
         uint32 lw = width  >> level; if (lw == 0) lw = 1;
         uint32 lh = height >> level; if (lh == 0) lh = 1;
-        uint32 bx = (lw + 3) / 4;
-        uint32 by = (lh + 3) / 4;
+        uint32 bx = (lw + block_dim - 1) / block_dim;
+        uint32 by = (lh + block_dim - 1) / block_dim;
         level_size[level] = bx * by * block_bytes;
         slice_size += level_size[level];
     }
@@ -1482,8 +2099,9 @@ int32 loadDdsArray(char* path)
     VkImageViewCreateInfo view_info = {0};
     view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     view_info.image = texture_image;
-    view_info.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+    view_info.viewType = view_type;
     view_info.format = format;
+    if (baked_flags & BAKED_TEXTURE_COVERAGE_MASK) view_info.components = (VkComponentMapping){ VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_R };
     view_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     view_info.subresourceRange.levelCount = levels;
     view_info.subresourceRange.layerCount = layers;
@@ -1492,7 +2110,7 @@ int32 loadDdsArray(char* path)
 
     // descriptor
     VkDescriptorImageInfo image_desc = {0};
-    image_desc.sampler = vulkan_state.tiling_linear_sampler;
+    image_desc.sampler = sampler;
     image_desc.imageView = texture_image_view;
     image_desc.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
@@ -1516,12 +2134,19 @@ int32 loadDdsArray(char* path)
     vulkan_state.asset_cache[vulkan_state.asset_cache_count].image  = texture_image;
     vulkan_state.asset_cache[vulkan_state.asset_cache_count].memory = texture_image_memory;
     vulkan_state.asset_cache[vulkan_state.asset_cache_count].view   = texture_image_view;
+    vulkan_state.asset_cache[vulkan_state.asset_cache_count].width  = (int32)width;
+    vulkan_state.asset_cache[vulkan_state.asset_cache_count].height = (int32)height;
     strcpy(vulkan_state.asset_cache[vulkan_state.asset_cache_count].path, path);
 
     vulkan_state.asset_cache_count++;
     return (int32)(vulkan_state.asset_cache_count - 1);
 }
 
+int32 loadDdsArray(char* path)
+{
+    return loadDdsTexture(path, VK_IMAGE_VIEW_TYPE_2D_ARRAY, vulkan_state.tiling_linear_sampler);
+}
+
 void uploadBufferToLocalDevice(void* source, VkDeviceSize size, VkBufferUsageFlags final_usage, VkBuffer* out_buffer, VkDeviceMemory* out_memory)
 {
     // create staging buffer
@@ -1618,12 +2243,12 @@ void uploadBufferToLocalDevice(void* source, VkDeviceSize size, VkBufferUsageFla
     *out_memory = device_memory;
 }
 
-void createInstanceBuffer(VkBuffer* instance_buffer, VkDeviceSize buffer_size, VkDeviceMemory* instance_memory, void** instance_mapped)
+void createInstanceBuffer(VkBuffer* instance_buffer, VkDeviceSize buffer_size, VkBufferUsageFlags usage, VkDeviceMemory* instance_memory, void** instance_mapped)
 {
     VkBufferCreateInfo buffer_info = {0};
     buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     buffer_info.size = buffer_size;
-    buffer_info.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    buffer_info.usage = usage;
     buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
     vkCreateBuffer(vulkan_state.logical_device_handle, &buffer_info, 0, instance_buffer);
@@ -1643,17 +2268,41 @@ void createInstanceBuffer(VkBuffer* instance_buffer, VkDeviceSize buffer_size, V
     memset(*instance_mapped, 0, (size_t)buffer_size);
 }
 
-LoadedModel loadModel(char* path)
+// gpu-only buffer, written by shaders or transfers
+void createDeviceLocalBuffer(VkDeviceSize buffer_size, VkBufferUsageFlags usage, VkBuffer* buffer, VkDeviceMemory* memory)
 {
-    LoadedModel result = {0};
+    VkBufferCreateInfo buffer_info = {0};
+    buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_info.size = buffer_size;
+    buffer_info.usage = usage;
+    buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    vkCreateBuffer(vulkan_state.logical_device_handle, &buffer_info, 0, buffer);
+
+    VkMemoryRequirements memory_requirements = {0};
+    vkGetBufferMemoryRequirements(vulkan_state.logical_device_handle, *buffer, &memory_requirements);
+
+    VkMemoryAllocateInfo alloc_info = {0};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = memory_requirements.size;
+    alloc_info.memoryTypeIndex = findMemoryType(memory_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    vkAllocateMemory(vulkan_state.logical_device_handle, &alloc_info, 0, memory);
+    vkBindBufferMemory(vulkan_state.logical_device_handle, *buffer, *memory, 0);
+}
+
+// MODEL LOADING
 
+// reads a .glb through cgltf. on success the arrays in out are malloc'd and owned by the caller
+bool parseModelGeometry(char* path, ModelGeometry* out)
+{
     cgltf_options options = {0};
     cgltf_data* data = 0;
     cgltf_result parse_result = cgltf_parse_file(&options, path, &data);
     if (parse_result != cgltf_result_success)
     {
         //LOG("failed to parse gltf file: %s\n", path);
-        return result;
+        return false;
     }
 
     cgltf_result load_result = cgltf_load_buffers(&options, data, path);
@@ -1661,7 +2310,7 @@ LoadedModel loadModel(char* path)
     {
         //LOG("failed to load gltf buffers: %s\n", path);
         cgltf_free(data);
-        return result;
+        return false;
     }
 
     // first pass: count total verts and indices across all meshes/primitives
@@ -1683,7 +2332,7 @@ LoadedModel loadModel(char* path)
     {
         //LOG("no geometry in: %s\n", path);
         cgltf_free(data);
-        return result;
+        return false;
     }
 
     Vertex* vertices = malloc(sizeof(Vertex) * total_verts);
@@ -1692,6 +2341,9 @@ LoadedModel loadModel(char* path)
     cgltf_size vert_offset = 0;
     cgltf_size index_offset = 0;
 
+    Vec3 bounds_min = {  1e30f,  1e30f,  1e30f };
+    Vec3 bounds_max = { -1e30f, -1e30f, -1e30f };
+
     // second pass: fill buffers
     for (cgltf_size mesh_index = 0; mesh_index < data->meshes_count; mesh_index++)
     {
@@ -1731,6 +2383,13 @@ LoadedModel loadModel(char* path)
                 vertex->y = pos[1];
                 vertex->z = pos[2];
 
+                if (pos[0] < bounds_min.x) bounds_min.x = pos[0];
+                if (pos[1] < bounds_min.y) bounds_min.y = pos[1];
+                if (pos[2] < bounds_min.z) bounds_min.z = pos[2];
+                if (pos[0] > bounds_max.x) bounds_max.x = pos[0];
+                if (pos[1] > bounds_max.y) bounds_max.y = pos[1];
+                if (pos[2] > bounds_max.z) bounds_max.z = pos[2];
+
                 if (uv_accessor)
                 {
                     float uv[2] = {0};
@@ -1773,19 +2432,18 @@ LoadedModel loadModel(char* path)
         }
     }
 
-    uploadBufferToLocalDevice(vertices, sizeof(Vertex) * total_verts, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, &result.vertex_buffer, &result.vertex_memory);
-    uploadBufferToLocalDevice(indices, sizeof(uint32) * total_indices, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, &result.index_buffer, &result.index_memory);
-
-    result.index_count = (uint32)total_indices;
     cgltf_free(data);
-    result.data = 0;
 
-    free(vertices);
-    free(indices);
+    out->vertices     = vertices;
+    out->indices      = indices;
+    out->vertex_count = (uint32)total_verts;
+    out->index_count  = (uint32)total_indices;
+    out->bounds_min   = bounds_min;
+    out->bounds_max   = bounds_max;
 
     //LOG("loaded model: %s (%u verts, %u indices)\n", path, (uint32)total_verts, (uint32)total_indices);
 
-    return result;
+    return true;
 }
 
 int32 getFileLastWriteTime(char* path)
@@ -1795,73 +2453,845 @@ int32 getFileLastWriteTime(char* path)
     return (int32)file_info.st_mtime;
 }
 
-void vulkanReloadChangedModels()
+// data/assets/models/rock.glb -> data/meta/models/rock.mesh
+void modelBlobPath(char* source_path, char (*out_path)[128])
 {
-    for (int asset_index = 0; asset_index < model_asset_count; asset_index++)
-    {
-        ModelAsset* asset = &model_assets[asset_index];
-
-        int64 write_time = getFileLastWriteTime(asset->path);
-        if (write_time == 0 || write_time == asset->last_write_time) continue;
-        asset->last_write_time = write_time;
+    char* file_name = strrchr(source_path, '/');
+    file_name = file_name ? file_name + 1 : source_path;
+    int32 name_length = (int32)strlen(file_name);
+    char* extension = strrchr(file_name, '.');
+    if (extension) name_length = (int32)(extension - file_name);
+    snprintf(*out_path, sizeof(*out_path), "%s/%.*s.mesh", MODEL_BLOB_FOLDER, name_length, file_name);
+}
 
-        int32 slot = asset->model_id - MODEL_3D_VOID;
-        if (slot < 0 || slot >= 64) continue;
+bool writeModelBlob(char* blob_path, int64 source_write_time, ModelGeometry* geometry)
+{
+    CreateDirectoryA(MODEL_BLOB_FOLDER, 0); // fails harmlessly when it already exists
 
-        vkDeviceWaitIdle(vulkan_state.logical_device_handle); // nothing in flight may reference the old buffers
+    FILE* file = fopen(blob_path, "wb");
+    if (!file) return false;
 
-        LoadedModel* old_model = &vulkan_state.loaded_models[slot];
-        if (old_model->vertex_buffer) vkDestroyBuffer(vulkan_state.logical_device_handle, old_model->vertex_buffer, 0);
-        if (old_model->vertex_memory) vkFreeMemory(vulkan_state.logical_device_handle, old_model->vertex_memory, 0);
-        if (old_model->index_buffer)  vkDestroyBuffer(vulkan_state.logical_device_handle, old_model->index_buffer, 0);
-        if (old_model->index_memory)  vkFreeMemory(vulkan_state.logical_device_handle, old_model->index_memory, 0);
-        if (old_model->data)          cgltf_free(old_model->data);
+    ModelBlobHeader header = {0};
+    header.magic             = MODEL_BLOB_MAGIC;
+    header.version           = MODEL_BLOB_VERSION;
+    header.vertex_size       = sizeof(Vertex);
+    header.vertex_count      = geometry->vertex_count;
+    header.index_count       = geometry->index_count;
+    header.source_write_time = source_write_time;
+    header.bounds_min        = geometry->bounds_min;
+    header.bounds_max        = geometry->bounds_max;
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                && fwrite(geometry->vertices, sizeof(Vertex), geometry->vertex_count, file) == geometry->vertex_count
+                && fwrite(geometry->indices, sizeof(uint32), geometry->index_count, file) == geometry->index_count;
+    fclose(file);
+
+    // a half written blob would only fail the size check on load, but there is no reason to leave it around
+    if (!written) remove(blob_path);
+    return written;
+}
 
-        vulkan_state.loaded_models[slot] = loadModel(asset->path);
-    }
+void unmapModelBlob(MappedModelBlob* blob)
+{
+    if (blob->view) UnmapViewOfFile(blob->view);
+    if (blob->mapping) CloseHandle(blob->mapping);
+    if (blob->file && blob->file != INVALID_HANDLE_VALUE) CloseHandle(blob->file);
+    *blob = (MappedModelBlob){0};
 }
 
-void loadAllEntities()
+// maps the blob if it is current for the source: same version and vertex layout, baked from a .glb with the same
+// write time. with no .glb on disk at all, whatever blob there is gets used
+bool mapModelBlob(char* blob_path, int64 source_write_time, MappedModelBlob* out)
 {
-    for (int asset_index = 0; asset_index < model_asset_count; asset_index++)
+    *out = (MappedModelBlob){0};
+
+    out->file = CreateFileA(blob_path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (out->file == INVALID_HANDLE_VALUE)
     {
-        ModelAsset* asset = &model_assets[asset_index];
-        int32 slot = asset->model_id - MODEL_3D_VOID;
-        vulkan_state.loaded_models[slot] = loadModel(asset->path);
-        asset->last_write_time = getFileLastWriteTime(asset->path);
+        out->file = 0;
+        return false;
     }
 
-    // TODO: add these to the main array
-    vulkan_state.laser_cylinder_model = loadModel("data/assets/models/laser-cylinder.glb");
-    vulkan_state.dummy_cube_model = loadModel("data/assets/models/dummy-cube.glb");
+    LARGE_INTEGER file_size = {0};
+    GetFileSizeEx(out->file, &file_size);
+    if (file_size.QuadPart < (LONGLONG)sizeof(ModelBlobHeader))
+    {
+        unmapModelBlob(out);
+        return false;
+    }
+
+    out->mapping = CreateFileMappingA(out->file, 0, PAGE_READONLY, 0, 0, 0);
+    if (out->mapping) out->view = (uint8*)MapViewOfFile(out->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!out->view)
+    {
+        unmapModelBlob(out);
+        return false;
+    }
+    out->header = (ModelBlobHeader*)out->view;
+
+    ModelBlobHeader* header = out->header;
+    LONGLONG expected_size = (LONGLONG)sizeof(ModelBlobHeader) + (LONGLONG)sizeof(Vertex) * header->vertex_count + (LONGLONG)sizeof(uint32) * header->index_count;
+    bool current = header->magic == MODEL_BLOB_MAGIC
+                && header->version == MODEL_BLOB_VERSION
+                && header->vertex_size == sizeof(Vertex)
+                && header->vertex_count > 0 && header->index_count > 0
+                && file_size.QuadPart == expected_size
+                && (source_write_time == 0 || header->source_write_time == source_write_time);
+    if (!current)
+    {
+        unmapModelBlob(out);
+        return false;
+    }
+    return true;
 }
 
-VkPipelineShaderStageCreateInfo loadShaderStage(char* path, VkShaderModule* module, VkShaderStageFlagBits stage_bit)
+LoadedModel uploadModel(Vertex* vertices, uint32 vertex_count, uint32* indices, uint32 index_count, Vec3 bounds_min, Vec3 bounds_max)
 {
-    // load module
-    void* bytes = 0;
-    size_t size = 0;
-    if (!readEntireFile(path, &bytes, &size)) return (VkPipelineShaderStageCreateInfo){0};
-    VkShaderModuleCreateInfo shader_module_ci = {0};
-    shader_module_ci.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    shader_module_ci.codeSize = size;
-    shader_module_ci.pCode = (uint32*)bytes;
-    vkCreateShaderModule(vulkan_state.logical_device_handle, &shader_module_ci, 0, module);
-    free(bytes);
+    LoadedModel result = {0};
 
-    // load stage
-    VkPipelineShaderStageCreateInfo shader_stage_ci = {0};
-    shader_stage_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    shader_stage_ci.stage = stage_bit;
-    shader_stage_ci.module = *module;
-    shader_stage_ci.pName = "main";
-    return shader_stage_ci;
+    // transfer src so buildModelMegaBuffer can copy out of them
+    uploadBufferToLocalDevice(vertices, sizeof(Vertex) * vertex_count, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, &result.vertex_buffer, &result.vertex_memory);
+    uploadBufferToLocalDevice(indices, sizeof(uint32) * index_count, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, &result.index_buffer, &result.index_memory);
+
+    result.vertex_count = vertex_count;
+    result.index_count  = index_count;
+    result.bounds_min   = bounds_min;
+    result.bounds_max   = bounds_max;
+    return result;
 }
 
-void createSwapchainResources(void)
+// the cpu side of loading a model. a current blob is mapped; otherwise the .glb is parsed and the blob is (re)baked for
+// next time, which is also what happens on hot reload since the .glb write time changed. touches no vulkan state, so
+// loadAllEntities runs these as jobs
+typedef struct
 {
-    // query current surface state
-    VkSurfaceCapabilitiesKHR surface_capabilities = {0};
+    char* path;
+    MappedModelBlob blob;
+    ModelGeometry geometry; // parsed from the .glb when there was no current blob
+    bool prepared;
+}
+ModelLoad;
+
+void prepareModelLoad(void* data)
+{
+    ModelLoad* load = (ModelLoad*)data;
+    int64 source_write_time = getFileLastWriteTime(load->path);
+    char blob_path[128];
+    modelBlobPath(load->path, &blob_path);
+
+    if (mapModelBlob(blob_path, source_write_time, &load->blob))
+    {
+        load->prepared = true;
+        return;
+    }
+
+    if (!parseModelGeometry(load->path, &load->geometry)) return;
+    writeModelBlob(blob_path, source_write_time, &load->geometry);
+    load->prepared = true;
+}
+
+// uploads whichever of the two prepareModelLoad produced into the staging buffers, then releases it. main thread only
+LoadedModel finishModelLoad(ModelLoad* load)
+{
+    LoadedModel result = {0};
+    if (!load->prepared) return result;
+
+    if (load->blob.view)
+    {
+        Vertex* vertices = (Vertex*)(load->blob.view + sizeof(ModelBlobHeader));
+        uint32* indices = (uint32*)(vertices + load->blob.header->vertex_count);
+        result = uploadModel(vertices, load->blob.header->vertex_count, indices, load->blob.header->index_count, load->blob.header->bounds_min, load->blob.header->bounds_max);
+        unmapModelBlob(&load->blob);
+        return result;
+    }
+
+    result = uploadModel(load->geometry.vertices, load->geometry.vertex_count, load->geometry.indices, load->geometry.index_count, load->geometry.bounds_min, load->geometry.bounds_max);
+    free(load->geometry.vertices);
+    free(load->geometry.indices);
+    load->geometry = (ModelGeometry){0};
+    return result;
+}
+
+LoadedModel loadModel(char* path)
+{
+    ModelLoad load = { .path = path };
+    prepareModelLoad(&load);
+    return finishModelLoad(&load);
+}
+
+// bakes every .glb in the models folder without starting the renderer. results go to the debugger output
+void bakeModelBlobs()
+{
+    char search_path[128];
+    snprintf(search_path, sizeof(search_path), "%s/*.glb", MODEL_SOURCE_FOLDER);
+
+    WIN32_FIND_DATAA find_data = {0};
+    HANDLE find_handle = FindFirstFileA(search_path, &find_data);
+    if (find_handle == INVALID_HANDLE_VALUE) return;
+
+    int32 baked_count = 0;
+    int32 failed_count = 0;
+    char output[256];
+    do
+    {
+        char source_path[128];
+        snprintf(source_path, sizeof(source_path), "%s/%s", MODEL_SOURCE_FOLDER, find_data.cFileName);
+        char blob_path[128];
+        modelBlobPath(source_path, &blob_path);
+
+        ModelGeometry geometry = {0};
+        if (parseModelGeometry(source_path, &geometry) && writeModelBlob(blob_path, getFileLastWriteTime(source_path), &geometry))
+        {
+            snprintf(output, sizeof(output), "baked %s -> %s (%u vertices, %u indices)\n", source_path, blob_path, geometry.vertex_count, geometry.index_count);
+            baked_count++;
+        }
+        else
+        {
+            snprintf(output, sizeof(output), "failed to bake %s\n", source_path);
+            failed_count++;
+        }
+        OutputDebugStringA(output);
+
+        free(geometry.vertices);
+        free(geometry.indices);
+    }
+    while (FindNextFileA(find_handle, &find_data));
+    FindClose(find_handle);
+
+    snprintf(output, sizeof(output), "model bake: %d baked, %d failed\n", baked_count, failed_count);
+    OutputDebugStringA(output);
+}
+
+// concatenates every loaded model on the gpu. indices stay relative to their own model; the draw's vertex offset rebases them.
+// a model that still has its own buffers was just loaded; every other model is carried over from the previous mega buffer.
+// the per model buffers are freed afterwards so each mesh is only resident once
+void buildModelMegaBuffer()
+{
+    VkBuffer old_vertex_buffer = vulkan_state.model_mega_vertex_buffer;
+    VkDeviceMemory old_vertex_memory = vulkan_state.model_mega_vertex_memory;
+    VkBuffer old_index_buffer = vulkan_state.model_mega_index_buffer;
+    VkDeviceMemory old_index_memory = vulkan_state.model_mega_index_memory;
+    ModelMeshInfo old_infos[64];
+    memcpy(old_infos, vulkan_state.model_mesh_infos, sizeof(old_infos));
+
+    uint32 total_vertices = 0;
+    uint32 total_indices = 0;
+    for (int32 slot = 0; slot < 64; slot++)
+    {
+        LoadedModel* model = &vulkan_state.loaded_models[slot];
+        ModelMeshInfo* info = &vulkan_state.model_mesh_infos[slot];
+        info->vertex_offset = total_vertices;
+        info->index_offset  = total_indices;
+        info->index_count   = model->index_count;
+        total_vertices += model->vertex_count;
+        total_indices  += model->index_count;
+    }
+    if (total_vertices == 0) total_vertices = 1; // keep the buffers valid even with nothing loaded
+    if (total_indices == 0) total_indices = 1;
+
+    createDeviceLocalBuffer(sizeof(Vertex) * total_vertices, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, &vulkan_state.model_mega_vertex_buffer, &vulkan_state.model_mega_vertex_memory);
+    createDeviceLocalBuffer(sizeof(uint32) * total_indices, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, &vulkan_state.model_mega_index_buffer, &vulkan_state.model_mega_index_memory);
+
+    VkCommandBufferAllocateInfo cb_alloc = {0};
+    cb_alloc.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cb_alloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cb_alloc.commandPool = vulkan_state.graphics_command_pool_handle;
+    cb_alloc.commandBufferCount = 1;
+
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    vkAllocateCommandBuffers(vulkan_state.logical_device_handle, &cb_alloc, &command_buffer);
+
+    VkCommandBufferBeginInfo cb_begin = {0};
+    cb_begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    cb_begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkBeginCommandBuffer(command_buffer, &cb_begin);
+
+    for (int32 slot = 0; slot < 64; slot++)
+    {
+        LoadedModel* model = &vulkan_state.loaded_models[slot];
+        ModelMeshInfo* info = &vulkan_state.model_mesh_infos[slot];
+        if (model->index_count == 0) continue;
+
+        bool freshly_loaded = model->vertex_buffer != VK_NULL_HANDLE;
+
+        VkBufferCopy vertex_copy = {0};
+        vertex_copy.srcOffset = freshly_loaded ? 0 : sizeof(Vertex) * old_infos[slot].vertex_offset;
+        vertex_copy.dstOffset = sizeof(Vertex) * info->vertex_offset;
+        vertex_copy.size = sizeof(Vertex) * model->vertex_count;
+        vkCmdCopyBuffer(command_buffer, freshly_loaded ? model->vertex_buffer : old_vertex_buffer, vulkan_state.model_mega_vertex_buffer, 1, &vertex_copy);
+
+        VkBufferCopy index_copy = {0};
+        index_copy.srcOffset = freshly_loaded ? 0 : sizeof(uint32) * old_infos[slot].index_offset;
+        index_copy.dstOffset = sizeof(uint32) * info->index_offset;
+        index_copy.size = sizeof(uint32) * model->index_count;
+        vkCmdCopyBuffer(command_buffer, freshly_loaded ? model->index_buffer : old_index_buffer, vulkan_state.model_mega_index_buffer, 1, &index_copy);
+    }
+
+    vkEndCommandBuffer(command_buffer);
+
+    VkSubmitInfo submit = {0};
+    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &command_buffer;
+
+    vkQueueSubmit(vulkan_state.graphics_queue_handle, 1, &submit, VK_NULL_HANDLE);
+    vkQueueWaitIdle(vulkan_state.graphics_queue_handle);
+
+    vkFreeCommandBuffers(vulkan_state.logical_device_handle, vulkan_state.graphics_command_pool_handle, 1, &command_buffer);
+
+    if (old_vertex_buffer) vkDestroyBuffer(vulkan_state.logical_device_handle, old_vertex_buffer, 0);
+    if (old_vertex_memory) vkFreeMemory(vulkan_state.logical_device_handle, old_vertex_memory, 0);
+    if (old_index_buffer)  vkDestroyBuffer(vulkan_state.logical_device_handle, old_index_buffer, 0);
+    if (old_index_memory)  vkFreeMemory(vulkan_state.logical_device_handle, old_index_memory, 0);
+
+    for (int32 slot = 0; slot < 64; slot++)
+    {
+        LoadedModel* model = &vulkan_state.loaded_models[slot];
+        if (model->vertex_buffer) vkDestroyBuffer(vulkan_state.logical_device_handle, model->vertex_buffer, 0);
+        if (model->vertex_memory) vkFreeMemory(vulkan_state.logical_device_handle, model->vertex_memory, 0);
+        if (model->index_buffer)  vkDestroyBuffer(vulkan_state.logical_device_handle, model->index_buffer, 0);
+        if (model->index_memory)  vkFreeMemory(vulkan_state.logical_device_handle, model->index_memory, 0);
+        model->vertex_buffer = VK_NULL_HANDLE;
+        model->vertex_memory = VK_NULL_HANDLE;
+        model->index_buffer = VK_NULL_HANDLE;
+        model->index_memory = VK_NULL_HANDLE;
+    }
+}
+
+void vulkanReloadChangedModels()
+{
+    bool any_reloaded = false;
+
+    for (int asset_index = 0; asset_index < model_asset_count; asset_index++)
+    {
+        ModelAsset* asset = &model_assets[asset_index];
+
+        int64 write_time = getFileLastWriteTime(asset->path);
+        if (write_time == 0 || write_time == asset->last_write_time) continue;
+        asset->last_write_time = write_time;
+
+        int32 slot = asset->model_id - MODEL_3D_VOID;
+        if (slot < 0 || slot >= 64) continue;
+
+        vkDeviceWaitIdle(vulkan_state.logical_device_handle); // nothing in flight may reference the old buffers
+
+        LoadedModel* old_model = &vulkan_state.loaded_models[slot];
+        if (old_model->vertex_buffer) vkDestroyBuffer(vulkan_state.logical_device_handle, old_model->vertex_buffer, 0);
+        if (old_model->vertex_memory) vkFreeMemory(vulkan_state.logical_device_handle, old_model->vertex_memory, 0);
+        if (old_model->index_buffer)  vkDestroyBuffer(vulkan_state.logical_device_handle, old_model->index_buffer, 0);
+        if (old_model->index_memory)  vkFreeMemory(vulkan_state.logical_device_handle, old_model->index_memory, 0);
+        if (old_model->data)          cgltf_free(old_model->data);
+
+        vulkan_state.loaded_models[slot] = loadModel(asset->path);
+        any_reloaded = true;
+    }
+
+    if (any_reloaded) buildModelMegaBuffer(); // still idle from the wait above
+}
+
+void loadAllEntities()
+{
+    // model_assets in order, then the two models kept outside loaded_models
+    ModelLoad loads[64 + 2] = {0};
+    int32 load_count = 0;
+    for (int asset_index = 0; asset_index < model_asset_count; asset_index++) loads[load_count++].path = model_assets[asset_index].path;
+    loads[load_count++].path = "data/assets/models/laser-cylinder.glb";
+    loads[load_count++].path = "data/assets/models/dummy-cube.glb";
+
+    // blob mapping and .glb parsing spread over the workers, uploads stay on this thread since they use the queue
+    JobCounter load_counter = {0};
+    jobsRunBatch(prepareModelLoad, loads, sizeof(ModelLoad), load_count, &load_counter);
+    jobsWait(&load_counter);
+
+    for (int asset_index = 0; asset_index < model_asset_count; asset_index++)
+    {
+        ModelAsset* asset = &model_assets[asset_index];
+        int32 slot = asset->model_id - MODEL_3D_VOID;
+        vulkan_state.loaded_models[slot] = finishModelLoad(&loads[asset_index]);
+        asset->last_write_time = getFileLastWriteTime(asset->path);
+    }
+
+    // TODO: add these to the main array
+    vulkan_state.laser_cylinder_model = finishModelLoad(&loads[model_asset_count]);
+    vulkan_state.dummy_cube_model = finishModelLoad(&loads[model_asset_count + 1]);
+
+    buildModelMegaBuffer();
+}
+
+// TEXTURE BAKING
+
+// the bake caches the decoded atlases so startup skips the png decode; it does not reduce vram for colour. pixel art
+// has too many hard edged colours per 4x4 block for BC1/BC7 endpoints to reproduce, so colour atlases stay RGBA8.
+// only a white coverage mask (the font) is compressed, as BC4, which is exact for its 0/255 alpha
+
+void writeBlockBits(uint8 block[16], int32* bit_position, uint32 value, int32 bit_count)
+{
+    for (int32 bit = 0; bit < bit_count; bit++)
+    {
+        if (value & (1u << bit)) block[*bit_position >> 3] |= (uint8)(1u << (*bit_position & 7));
+        (*bit_position)++;
+    }
+}
+
+// BC4 of one channel: the two extremes as endpoints with six values between them. returns the largest error
+int32 encodeBc4Block(uint8 values[16], uint8 out_block[8])
+{
+    int32 low = 255, high = 0;
+    for (int32 texel = 0; texel < 16; texel++)
+    {
+        if (values[texel] < low) low = values[texel];
+        if (values[texel] > high) high = values[texel];
+    }
+
+    // red_0 > red_1 selects the eight value palette. equal endpoints still decode to red_0 for index 0
+    int32 palette[8];
+    palette[0] = high;
+    palette[1] = low;
+    for (int32 level = 1; level < 7; level++) palette[level + 1] = ((7 - level) * high + level * low) / 7;
+
+    memset(out_block, 0, 8);
+    out_block[0] = (uint8)high;
+    out_block[1] = (uint8)low;
+
+    int32 max_error = 0;
+    int32 bit_position = 16;
+    for (int32 texel = 0; texel < 16; texel++)
+    {
+        int32 best_level = 0;
+        for (int32 level = 1; level < 8; level++)
+        {
+            if (abs(palette[level] - values[texel]) < abs(palette[best_level] - values[texel])) best_level = level;
+        }
+        int32 error = abs(palette[best_level] - values[texel]);
+        if (error > max_error) max_error = error;
+        writeBlockBits(out_block, &bit_position, (uint32)best_level, 3);
+    }
+    return max_error;
+}
+
+// writes a single level dds with a dx10 header. the reserved words hold a tag (magic, version, source write time,
+// flags) so prepareAtlasLoad can tell a current bake from a stale one
+bool writeBakedTexture(char* path, uint32 width, uint32 height, uint32 dxgi_format, uint32 flags, int64 source_write_time, void* texels, size_t texel_bytes)
+{
+    uint8 header[148] = {0};
+    memcpy(header, "DDS ", 4);
+    *(uint32*)(header + 4)   = 124; // header size
+    *(uint32*)(header + 8)   = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000; // caps, height, width, pixel format, mip count, linear size
+    *(uint32*)(header + 12)  = height;
+    *(uint32*)(header + 16)  = width;
+    *(uint32*)(header + 20)  = (uint32)texel_bytes;
+    *(uint32*)(header + 28)  = 1; // mip levels
+    *(uint32*)(header + 32)  = BAKED_TEXTURE_MAGIC;
+    *(uint32*)(header + 36)  = BAKED_TEXTURE_VERSION;
+    *(int64*)(header + 40)   = source_write_time;
+    *(uint32*)(header + 48)  = flags;
+    *(uint32*)(header + 76)  = 32; // pixel format size
+    *(uint32*)(header + 80)  = 0x4; // four cc
+    memcpy(header + 84, "DX10", 4);
+    *(uint32*)(header + 108) = 0x1000; // caps: texture
+    *(uint32*)(header + 128) = dxgi_format;
+    *(uint32*)(header + 132) = 3; // texture 2d
+    *(uint32*)(header + 140) = 1; // array size
+
+    CreateDirectoryA(TEXTURE_BAKE_FOLDER, 0); // fails harmlessly when it already exists
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool written = fwrite(header, sizeof(header), 1, file) == 1 && fwrite(texels, 1, texel_bytes, file) == texel_bytes;
+    fclose(file);
+
+    if (!written) remove(path);
+    return written;
+}
+
+// data/assets/sprites/atlas-2d.png -> data/meta/textures/atlas-2d.dds
+void bakedTexturePath(char* source_path, char (*out_path)[128])
+{
+    char* file_name = strrchr(source_path, '/');
+    file_name = file_name ? file_name + 1 : source_path;
+    int32 name_length = (int32)strlen(file_name);
+    char* extension = strrchr(file_name, '.');
+    if (extension) name_length = (int32)(extension - file_name);
+    snprintf(*out_path, sizeof(*out_path), "%s/%.*s.dds", TEXTURE_BAKE_FOLDER, name_length, file_name);
+}
+
+// picks the format:
+// - BC4 coverage mask when every visible texel is white. only offered when transparent_colour_unused, since transparent
+//   texels come back white
+// - otherwise RGBA8, the same texels the png decode gave, without the decode
+bool bakeAtlasTexture(char* source_path, char* baked_path, bool transparent_colour_unused, char (*out_summary)[128])
+{
+    int width, height, channels;
+    uint8* pixels = (uint8*)stbi_load(source_path, &width, &height, &channels, STBI_rgb_alpha);
+    if (!pixels) return false;
+    int64 source_write_time = getFileLastWriteTime(source_path);
+
+    bool coverage_mask = transparent_colour_unused;
+    for (int32 texel = 0; texel < width * height && coverage_mask; texel++)
+    {
+        uint8* rgba = pixels + texel * 4;
+        if (rgba[3] != 0 && (rgba[0] != 255 || rgba[1] != 255 || rgba[2] != 255)) coverage_mask = false;
+    }
+
+    bool written = false;
+    if (coverage_mask)
+    {
+        uint32 blocks_x = (uint32)(width + 3) / 4;
+        uint32 blocks_y = (uint32)(height + 3) / 4;
+        uint8* blocks = malloc(8 * blocks_x * blocks_y);
+        int32 max_error = 0;
+
+        for (uint32 block_y = 0; block_y < blocks_y; block_y++)
+        {
+            for (uint32 block_x = 0; block_x < blocks_x; block_x++)
+            {
+                // edge blocks repeat the last row / column
+                uint8 alphas[16];
+                for (int32 texel = 0; texel < 16; texel++)
+                {
+                    int32 x = (int32)block_x * 4 + (texel & 3);
+                    int32 y = (int32)block_y * 4 + (texel >> 2);
+                    if (x >= width) x = width - 1;
+                    if (y >= height) y = height - 1;
+                    alphas[texel] = pixels[(y * width + x) * 4 + 3];
+                }
+
+                int32 block_error = encodeBc4Block(alphas, blocks + 8 * (block_y * blocks_x + block_x));
+                if (block_error > max_error) max_error = block_error;
+            }
+        }
+
+        written = writeBakedTexture(baked_path, width, height, 80, BAKED_TEXTURE_COVERAGE_MASK, source_write_time, blocks, 8 * blocks_x * blocks_y);
+        snprintf(*out_summary, sizeof(*out_summary), "BC4 coverage mask, max error %d", max_error);
+        free(blocks);
+    }
+    else
+    {
+        written = writeBakedTexture(baked_path, width, height, 29, 0, source_write_time, pixels, (size_t)width * height * 4);
+        snprintf(*out_summary, sizeof(*out_summary), "RGBA8");
+    }
+
+    stbi_image_free(pixels);
+    return written;
+}
+
+bool bakedTextureCurrent(char* baked_path, int64 source_write_time)
+{
+    FILE* file = fopen(baked_path, "rb");
+    if (!file) return false;
+    uint8 header[148] = {0};
+    bool read = fread(header, sizeof(header), 1, file) == 1;
+    fclose(file);
+
+    return read
+        && memcmp(header, "DDS ", 4) == 0
+        && *(uint32*)(header + 32) == BAKED_TEXTURE_MAGIC
+        && *(uint32*)(header + 36) == BAKED_TEXTURE_VERSION
+        && (source_write_time == 0 || *(int64*)(header + 40) == source_write_time);
+}
+
+// makes sure an atlas png has a current baked dds, baking it when missing or stale. no vulkan calls, so loadAtlases
+// runs one job per atlas
+typedef struct
+{
+    char* source_path;
+    bool transparent_colour_unused;
+    char baked_path[128];
+    bool baked; // baked_path is current, from before or from this job
+}
+AtlasLoad;
+
+void prepareAtlasLoad(void* data)
+{
+    AtlasLoad* load = (AtlasLoad*)data;
+    bakedTexturePath(load->source_path, &load->baked_path);
+
+    load->baked = bakedTextureCurrent(load->baked_path, getFileLastWriteTime(load->source_path));
+    if (!load->baked)
+    {
+        char summary[128];
+        load->baked = bakeAtlasTexture(load->source_path, load->baked_path, load->transparent_colour_unused, &summary);
+    }
+}
+
+// uploads the baked dds. the png itself is the last resort
+int32 finishAtlasLoad(AtlasLoad* load)
+{
+    if (!load->baked) return loadAsset(load->source_path, VK_FORMAT_R8G8B8A8_SRGB);
+
+    int32 asset_index = loadDdsTexture(load->baked_path, VK_IMAGE_VIEW_TYPE_2D, vulkan_state.pixel_art_sampler);
+    if (asset_index < 0) return loadAsset(load->source_path, VK_FORMAT_R8G8B8A8_SRGB);
+    return asset_index;
+}
+
+// bakes the atlases without starting the renderer. results go to the debugger output
+void bakeTextureAtlases()
+{
+    char* source_paths[3] = { (char*)ATLAS_2D_PATH, (char*)ATLAS_FONT_PATH, (char*)ATLAS_3D_PATH };
+    bool transparent_colour_unused[3] = { true, true, false }; // the 3d atlas is drawn opaque
+    char output[512];
+
+    for (int32 atlas_index = 0; atlas_index < 3; atlas_index++)
+    {
+        char baked_path[128];
+        bakedTexturePath(source_paths[atlas_index], &baked_path);
+
+        char summary[128] = {0};
+        if (bakeAtlasTexture(source_paths[atlas_index], baked_path, transparent_colour_unused[atlas_index], &summary)) snprintf(output, sizeof(output), "baked %s -> %s: %s\n", source_paths[atlas_index], baked_path, summary);
+        else snprintf(output, sizeof(output), "failed to bake %s\n", source_paths[atlas_index]);
+        OutputDebugStringA(output);
+    }
+}
+
+// replaces the per draw spriteUV arithmetic with a lookup, sized from whatever the atlases turned out to be
+void buildSpriteUvTable()
+{
+    if (vulkan_state.atlas_2d_asset_index < 0 || vulkan_state.atlas_font_asset_index < 0 || vulkan_state.atlas_3d_asset_index < 0) return;
+
+    CachedAsset* atlas_2d   = &vulkan_state.asset_cache[vulkan_state.atlas_2d_asset_index];
+    CachedAsset* atlas_font = &vulkan_state.asset_cache[vulkan_state.atlas_font_asset_index];
+    CachedAsset* atlas_3d   = &vulkan_state.asset_cache[vulkan_state.atlas_3d_asset_index];
+
+    for (int32 id = 0; id < SPRITE_2D_COUNT; id++)
+    {
+        CachedAsset* atlas = spriteIsFont((SpriteId)id) ? atlas_font : atlas_2d;
+        sprite_uv_table[id] = spriteUV((SpriteId)id, SPRITE_2D, atlas->width, atlas->height);
+    }
+    for (int32 id = CUBE_3D_VOID; id < MODEL_3D_VOID; id++) sprite_uv_table[id] = spriteUV((SpriteId)id, CUBE_3D, atlas_3d->width, atlas_3d->height);
+
+    int32 cell_width = 0, cell_height = 0;
+    atlasCellSize(CUBE_3D_VOID, CUBE_3D, &cell_width, &cell_height);
+    atlas_3d_cell = (Vec4){ (float)cell_width / (float)atlas_3d->width, (float)cell_height / (float)atlas_3d->height, (float)(atlas_3d->width / cell_width), 0.0f };
+}
+
+void loadAtlases()
+{
+    AtlasLoad loads[3] =
+    {
+        { .source_path = (char*)ATLAS_2D_PATH,   .transparent_colour_unused = true },
+        { .source_path = (char*)ATLAS_FONT_PATH, .transparent_colour_unused = true },
+        { .source_path = (char*)ATLAS_3D_PATH,   .transparent_colour_unused = false }, // drawn opaque
+    };
+
+    JobCounter load_counter = {0};
+    jobsRunBatch(prepareAtlasLoad, loads, sizeof(AtlasLoad), 3, &load_counter);
+    jobsWait(&load_counter);
+
+    vulkan_state.atlas_2d_asset_index   = finishAtlasLoad(&loads[0]);
+    vulkan_state.atlas_font_asset_index = finishAtlasLoad(&loads[1]);
+    vulkan_state.atlas_3d_asset_index   = finishAtlasLoad(&loads[2]);
+    buildSpriteUvTable();
+}
+
+VkPipelineShaderStageCreateInfo loadShaderStage(char* path, VkShaderModule* module, VkShaderStageFlagBits stage_bit)
+{
+    // load module
+    void* bytes = 0;
+    size_t size = 0;
+    if (!readEntireFile(path, &bytes, &size)) return (VkPipelineShaderStageCreateInfo){0};
+    VkShaderModuleCreateInfo shader_module_ci = {0};
+    shader_module_ci.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    shader_module_ci.codeSize = size;
+    shader_module_ci.pCode = (uint32*)bytes;
+    vkCreateShaderModule(vulkan_state.logical_device_handle, &shader_module_ci, 0, module);
+    free(bytes);
+
+    // load stage
+    VkPipelineShaderStageCreateInfo shader_stage_ci = {0};
+    shader_stage_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shader_stage_ci.stage = stage_bit;
+    shader_stage_ci.module = *module;
+    shader_stage_ci.pName = "main";
+    return shader_stage_ci;
+}
+
+// PIPELINE CACHE
+
+// the saved file is what vkGetPipelineCacheData returned, which starts with a VkPipelineCacheHeaderVersionOne. a cache
+// from another gpu or driver would be ignored by the driver anyway, but checking the header here means a stale file
+// gets reported and replaced instead of silently compiling everything on every start
+void createPipelineCache(VkPhysicalDeviceProperties* device_properties)
+{
+    void* bytes = 0;
+    size_t size = 0;
+    bool usable = false;
+    if (readEntireFile((char*)PIPELINE_CACHE_PATH, &bytes, &size))
+    {
+        VkPipelineCacheHeaderVersionOne* header = (VkPipelineCacheHeaderVersionOne*)bytes;
+        usable = size >= sizeof(VkPipelineCacheHeaderVersionOne)
+              && header->headerSize >= sizeof(VkPipelineCacheHeaderVersionOne)
+              && header->headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+              && header->vendorID == device_properties->vendorID
+              && header->deviceID == device_properties->deviceID
+              && memcmp(header->pipelineCacheUUID, device_properties->pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        if (!usable) OutputDebugStringA("pipeline cache is from another device or driver, starting empty\n");
+    }
+
+    VkPipelineCacheCreateInfo cache_ci = {0};
+    cache_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cache_ci.initialDataSize = usable ? size : 0;
+    cache_ci.pInitialData = usable ? bytes : 0;
+
+    if (vkCreatePipelineCache(vulkan_state.logical_device_handle, &cache_ci, 0, &vulkan_state.pipeline_cache) != VK_SUCCESS && usable)
+    {
+        cache_ci.initialDataSize = 0;
+        cache_ci.pInitialData = 0;
+        usable = false;
+        vkCreatePipelineCache(vulkan_state.logical_device_handle, &cache_ci, 0, &vulkan_state.pipeline_cache);
+    }
+    vulkan_state.pipeline_cache_warm = usable;
+    free(bytes);
+}
+
+void savePipelineCache()
+{
+    size_t size = 0;
+    if (vkGetPipelineCacheData(vulkan_state.logical_device_handle, vulkan_state.pipeline_cache, &size, 0) != VK_SUCCESS || size == 0) return;
+    void* bytes = malloc(size);
+    if (vkGetPipelineCacheData(vulkan_state.logical_device_handle, vulkan_state.pipeline_cache, &size, bytes) == VK_SUCCESS)
+    {
+        CreateDirectoryA("data/meta", 0); // fails harmlessly when it already exists
+        FILE* file = fopen(PIPELINE_CACHE_PATH, "wb");
+        if (file)
+        {
+            bool written = fwrite(bytes, size, 1, file) == 1;
+            fclose(file);
+            if (!written) remove(PIPELINE_CACHE_PATH);
+        }
+    }
+    free(bytes);
+}
+
+// the next start compiles every pipeline again. for startupBenchmark's cold run
+void vulkanDiscardPipelineCache()
+{
+    remove(PIPELINE_CACHE_PATH);
+}
+
+// pipeline definitions in vulkanInitialize share one set of state structs and rewrite them between pipelines, so a
+// queued pipeline takes its own copy of everything its create info points at. the vertex input states and the dummy
+// viewport / scissor live for all of vulkanInitialize, and are left pointing there
+typedef struct
+{
+    VkGraphicsPipelineCreateInfo info;
+    VkPipelineShaderStageCreateInfo stages[2];
+    VkPipelineInputAssemblyStateCreateInfo input_assembly;
+    VkPipelineViewportStateCreateInfo viewport;
+    VkPipelineRasterizationStateCreateInfo rasterization;
+    VkPipelineMultisampleStateCreateInfo multisample;
+    VkPipelineDepthStencilStateCreateInfo depth_stencil;
+    VkPipelineColorBlendStateCreateInfo color_blend;
+    VkPipelineColorBlendAttachmentState blend_attachments[4];
+    VkPipelineDynamicStateCreateInfo dynamic;
+    VkDynamicState dynamic_states[4];
+    VkPipeline* output;
+    LARGE_INTEGER finished_at;
+}
+QueuedGraphicsPipeline;
+
+typedef struct
+{
+    VkComputePipelineCreateInfo info;
+    VkPipeline* output;
+    LARGE_INTEGER finished_at;
+}
+QueuedComputePipeline;
+
+// compiling is most of a cold start, and vkCreate*Pipelines may be called from any thread with a shared cache, so
+// the pipelines are collected here and created as one job each
+typedef struct
+{
+    QueuedGraphicsPipeline graphics[MAX_QUEUED_GRAPHICS_PIPELINES];
+    int32 graphics_count;
+    QueuedComputePipeline compute[MAX_QUEUED_COMPUTE_PIPELINES];
+    int32 compute_count;
+    JobCounter counter;
+}
+PipelineQueue;
+
+void queueGraphicsPipeline(PipelineQueue* queue, VkGraphicsPipelineCreateInfo* info, VkPipeline* output)
+{
+    QueuedGraphicsPipeline* queued = &queue->graphics[queue->graphics_count++];
+    queued->info = *info;
+    queued->output = output;
+
+    memcpy(queued->stages, info->pStages, sizeof(VkPipelineShaderStageCreateInfo) * info->stageCount);
+    queued->info.pStages = queued->stages;
+
+    queued->input_assembly = *info->pInputAssemblyState;
+    queued->info.pInputAssemblyState = &queued->input_assembly;
+
+    queued->viewport = *info->pViewportState;
+    queued->info.pViewportState = &queued->viewport;
+
+    queued->rasterization = *info->pRasterizationState;
+    queued->info.pRasterizationState = &queued->rasterization;
+
+    queued->multisample = *info->pMultisampleState;
+    queued->info.pMultisampleState = &queued->multisample;
+
+    queued->depth_stencil = *info->pDepthStencilState;
+    queued->info.pDepthStencilState = &queued->depth_stencil;
+
+    queued->color_blend = *info->pColorBlendState;
+    memcpy(queued->blend_attachments, info->pColorBlendState->pAttachments, sizeof(VkPipelineColorBlendAttachmentState) * info->pColorBlendState->attachmentCount);
+    queued->color_blend.pAttachments = queued->blend_attachments;
+    queued->info.pColorBlendState = &queued->color_blend;
+
+    queued->dynamic = *info->pDynamicState;
+    memcpy(queued->dynamic_states, info->pDynamicState->pDynamicStates, sizeof(VkDynamicState) * info->pDynamicState->dynamicStateCount);
+    queued->dynamic.pDynamicStates = queued->dynamic_states;
+    queued->info.pDynamicState = &queued->dynamic;
+}
+
+void queueComputePipeline(PipelineQueue* queue, VkComputePipelineCreateInfo* info, VkPipeline* output)
+{
+    QueuedComputePipeline* queued = &queue->compute[queue->compute_count++];
+    queued->info = *info;
+    queued->output = output;
+}
+
+void createQueuedGraphicsPipeline(void* data)
+{
+    QueuedGraphicsPipeline* queued = (QueuedGraphicsPipeline*)data;
+    vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, vulkan_state.pipeline_cache, 1, &queued->info, 0, queued->output);
+    QueryPerformanceCounter(&queued->finished_at);
+}
+
+void createQueuedComputePipeline(void* data)
+{
+    QueuedComputePipeline* queued = (QueuedComputePipeline*)data;
+    vkCreateComputePipelines(vulkan_state.logical_device_handle, vulkan_state.pipeline_cache, 1, &queued->info, 0, queued->output);
+    QueryPerformanceCounter(&queued->finished_at);
+}
+
+// returns straight away. jobsWait on queue->counter before using any of the pipelines
+void startQueuedPipelines(PipelineQueue* queue)
+{
+    jobsRunBatch(createQueuedGraphicsPipeline, queue->graphics, sizeof(QueuedGraphicsPipeline), queue->graphics_count, &queue->counter);
+    jobsRunBatch(createQueuedComputePipeline, queue->compute, sizeof(QueuedComputePipeline), queue->compute_count, &queue->counter);
+}
+
+// when the last pipeline finished compiling, which can be well before anything waits on queue->counter. only valid after that wait
+LARGE_INTEGER queuedPipelinesFinishedAt(PipelineQueue* queue, LARGE_INTEGER started_at)
+{
+    LARGE_INTEGER finished_at = started_at;
+    for (int32 graphics_index = 0; graphics_index < queue->graphics_count; graphics_index++)
+    {
+        if (queue->graphics[graphics_index].finished_at.QuadPart > finished_at.QuadPart) finished_at = queue->graphics[graphics_index].finished_at;
+    }
+    for (int32 compute_index = 0; compute_index < queue->compute_count; compute_index++)
+    {
+        if (queue->compute[compute_index].finished_at.QuadPart > finished_at.QuadPart) finished_at = queue->compute[compute_index].finished_at;
+    }
+    return finished_at;
+}
+
+void createSwapchainResources(void)
+{
+    // query current surface state
+    VkSurfaceCapabilitiesKHR surface_capabilities = {0};
     vkGetPhysicalDeviceSurfaceCapabilitiesKHR(vulkan_state.physical_device_handle, vulkan_state.surface_handle, &surface_capabilities);
 
     VkExtent2D chosen_extent = surface_capabilities.currentExtent;
@@ -2172,6 +3602,94 @@ void createSwapchainResources(void)
         vkBindBufferMemory(vulkan_state.logical_device_handle, vulkan_state.oit_counter_buffer, vulkan_state.oit_counter_memory, 0);
     }
 
+    // weighted blended OIT accumulation (premultiplied color and alpha, weighted)
+    {
+        VkImageCreateInfo ci = {0};
+        ci.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        ci.imageType = VK_IMAGE_TYPE_2D;
+        ci.extent.width = vulkan_state.swapchain_extent.width;
+        ci.extent.height = vulkan_state.swapchain_extent.height;
+        ci.extent.depth = 1;
+        ci.mipLevels = 1;
+        ci.arrayLayers = 1;
+        ci.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        ci.tiling = VK_IMAGE_TILING_OPTIMAL;
+        ci.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        ci.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        ci.samples = VK_SAMPLE_COUNT_1_BIT;
+        ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        vkCreateImage(vulkan_state.logical_device_handle, &ci, 0, &vulkan_state.wboit_accumulation_image);
+
+        VkMemoryRequirements mem_req = {0};
+        vkGetImageMemoryRequirements(vulkan_state.logical_device_handle, vulkan_state.wboit_accumulation_image, &mem_req);
+
+        VkMemoryAllocateInfo alloc = {0};
+        alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc.allocationSize = mem_req.size;
+        alloc.memoryTypeIndex = findMemoryType(mem_req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        vkAllocateMemory(vulkan_state.logical_device_handle, &alloc, 0, &vulkan_state.wboit_accumulation_memory);
+        vkBindImageMemory(vulkan_state.logical_device_handle, vulkan_state.wboit_accumulation_image, vulkan_state.wboit_accumulation_memory, 0);
+
+        VkImageViewCreateInfo view_ci = {0};
+        view_ci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        view_ci.image = vulkan_state.wboit_accumulation_image;
+        view_ci.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        view_ci.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        view_ci.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        view_ci.subresourceRange.baseMipLevel = 0;
+        view_ci.subresourceRange.levelCount = 1;
+        view_ci.subresourceRange.baseArrayLayer = 0;
+        view_ci.subresourceRange.layerCount = 1;
+
+        vkCreateImageView(vulkan_state.logical_device_handle, &view_ci, 0, &vulkan_state.wboit_accumulation_view);
+    }
+
+    // weighted blended OIT revealage (product of 1 - alpha)
+    {
+        VkImageCreateInfo ci = {0};
+        ci.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        ci.imageType = VK_IMAGE_TYPE_2D;
+        ci.extent.width = vulkan_state.swapchain_extent.width;
+        ci.extent.height = vulkan_state.swapchain_extent.height;
+        ci.extent.depth = 1;
+        ci.mipLevels = 1;
+        ci.arrayLayers = 1;
+        ci.format = VK_FORMAT_R16_SFLOAT;
+        ci.tiling = VK_IMAGE_TILING_OPTIMAL;
+        ci.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        ci.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        ci.samples = VK_SAMPLE_COUNT_1_BIT;
+        ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        vkCreateImage(vulkan_state.logical_device_handle, &ci, 0, &vulkan_state.wboit_revealage_image);
+
+        VkMemoryRequirements mem_req = {0};
+        vkGetImageMemoryRequirements(vulkan_state.logical_device_handle, vulkan_state.wboit_revealage_image, &mem_req);
+
+        VkMemoryAllocateInfo alloc = {0};
+        alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc.allocationSize = mem_req.size;
+        alloc.memoryTypeIndex = findMemoryType(mem_req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        vkAllocateMemory(vulkan_state.logical_device_handle, &alloc, 0, &vulkan_state.wboit_revealage_memory);
+        vkBindImageMemory(vulkan_state.logical_device_handle, vulkan_state.wboit_revealage_image, vulkan_state.wboit_revealage_memory, 0);
+
+        VkImageViewCreateInfo view_ci = {0};
+        view_ci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        view_ci.image = vulkan_state.wboit_revealage_image;
+        view_ci.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        view_ci.format = VK_FORMAT_R16_SFLOAT;
+        view_ci.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        view_ci.subresourceRange.baseMipLevel = 0;
+        view_ci.subresourceRange.levelCount = 1;
+        view_ci.subresourceRange.baseArrayLayer = 0;
+        view_ci.subresourceRange.layerCount = 1;
+
+        vkCreateImageView(vulkan_state.logical_device_handle, &view_ci, 0, &vulkan_state.wboit_revealage_view);
+    }
+
     // reflection color image
     uint32 reflection_width  = reflectionExtent(vulkan_state.swapchain_extent.width);
     uint32 reflection_height = reflectionExtent(vulkan_state.swapchain_extent.height);
@@ -2520,6 +4038,42 @@ void createSwapchainResources(void)
         vkUpdateDescriptorSets(vulkan_state.logical_device_handle, 1, &write, 0, 0);
     }
 
+    // weighted blended OIT accumulation
+    {
+        VkDescriptorImageInfo image_info = {0};
+        image_info.sampler = vulkan_state.pixel_art_sampler;
+        image_info.imageView = vulkan_state.wboit_accumulation_view;
+        image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkWriteDescriptorSet write = {0};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = vulkan_state.wboit_accumulation_descriptor_set;
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &image_info;
+
+        vkUpdateDescriptorSets(vulkan_state.logical_device_handle, 1, &write, 0, 0);
+    }
+
+    // weighted blended OIT revealage
+    {
+        VkDescriptorImageInfo image_info = {0};
+        image_info.sampler = vulkan_state.pixel_art_sampler;
+        image_info.imageView = vulkan_state.wboit_revealage_view;
+        image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkWriteDescriptorSet write = {0};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = vulkan_state.wboit_revealage_descriptor_set;
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &image_info;
+
+        vkUpdateDescriptorSets(vulkan_state.logical_device_handle, 1, &write, 0, 0);
+    }
+
     // reflections
     VkDescriptorImageInfo reflection_desc_info = {0};
     reflection_desc_info.sampler = vulkan_state.linear_clamp_sampler;
@@ -2659,58 +4213,292 @@ void createSwapchainResources(void)
             vulkan_state.reflection_distance_image_view,
         };
 
-        VkFramebufferCreateInfo fb_ci = {0};
-        fb_ci.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-        fb_ci.renderPass = vulkan_state.reflection_render_pass;
-        fb_ci.attachmentCount = 5;
-        fb_ci.pAttachments = reflection_attachments;
-        fb_ci.width = reflection_width;
-        fb_ci.height = reflection_height;
-        fb_ci.layers = 1;
+        VkFramebufferCreateInfo fb_ci = {0};
+        fb_ci.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        fb_ci.renderPass = vulkan_state.reflection_render_pass;
+        fb_ci.attachmentCount = 5;
+        fb_ci.pAttachments = reflection_attachments;
+        fb_ci.width = reflection_width;
+        fb_ci.height = reflection_height;
+        fb_ci.layers = 1;
+
+        vkCreateFramebuffer(vulkan_state.logical_device_handle, &fb_ci, 0, &vulkan_state.reflection_framebuffer);
+    }
+
+    // weighted blended OIT framebuffer
+    {
+        VkImageView wboit_attachments[3] =
+        {
+            vulkan_state.wboit_accumulation_view,
+            vulkan_state.wboit_revealage_view,
+            vulkan_state.depth_image_view,
+        };
+
+        VkFramebufferCreateInfo fb_ci = {0};
+        fb_ci.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        fb_ci.renderPass = vulkan_state.wboit_render_pass;
+        fb_ci.attachmentCount = 3;
+        fb_ci.pAttachments = wboit_attachments;
+        fb_ci.width = vulkan_state.swapchain_extent.width;
+        fb_ci.height = vulkan_state.swapchain_extent.height;
+        fb_ci.layers = 1;
+
+        vkCreateFramebuffer(vulkan_state.logical_device_handle, &fb_ci, 0, &vulkan_state.wboit_framebuffer);
+    }
+}
+
+void resetPipelineStates(VkPipelineColorBlendAttachmentState* blend, VkPipelineDepthStencilStateCreateInfo* depth_stencil, VkPipelineRasterizationStateCreateInfo* raster)
+{
+    // blend: opaque, no blending
+    blend->blendEnable = VK_FALSE;
+    blend->srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    blend->dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+    blend->colorBlendOp = VK_BLEND_OP_ADD;
+    blend->srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    blend->dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    blend->alphaBlendOp = VK_BLEND_OP_ADD;
+    blend->colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    // depth: test + write, less
+    depth_stencil->depthTestEnable = VK_TRUE;
+    depth_stencil->depthWriteEnable = VK_TRUE;
+    depth_stencil->depthCompareOp = VK_COMPARE_OP_LESS;
+    depth_stencil->depthBoundsTestEnable = VK_FALSE;
+
+    // stencil: off
+    depth_stencil->stencilTestEnable = VK_FALSE;
+    depth_stencil->front.failOp = VK_STENCIL_OP_KEEP;
+    depth_stencil->front.passOp = VK_STENCIL_OP_KEEP;
+    depth_stencil->front.depthFailOp = VK_STENCIL_OP_KEEP;
+    depth_stencil->front.compareOp = VK_COMPARE_OP_ALWAYS;
+    depth_stencil->front.compareMask = 0xFF;
+    depth_stencil->front.writeMask = 0x00;
+    depth_stencil->front.reference = 0;
+    depth_stencil->back = depth_stencil->front;
+
+    // rasterization: filled, no cull
+    raster->polygonMode = VK_POLYGON_MODE_FILL;
+    raster->cullMode = VK_CULL_MODE_NONE;
+    raster->frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    raster->lineWidth = 1.0f;
+    raster->depthBiasEnable = VK_FALSE;
+}
+
+// WATER FFT
+
+// records the whole water simulation for one point in time, leaving height and normal in the displacement image. the caller
+// orders whatever reads it next
+void recordWaterFft(VkCommandBuffer command_buffer, float time, float loop_period)
+{
+    // FFT TIME EVOLUTION DISPATCH
+    {
+        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_evolved_pipeline);
+
+        VkDescriptorSet evolved_sets[2] =
+        {
+            vulkan_state.h0_descriptor_set,
+            vulkan_state.fft_buffer_a_descriptor_set,
+        };
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_evolved_pipeline_layout, 0, 2, evolved_sets, 0, 0);
+
+        FFTEvolvedPushConstants pc = {0};
+        pc.texture_size = FFT_SIZE;
+        pc.water_tile_length = water_tile_length;
+        pc.gravity = 9.81f;
+        pc.time = time;
+        pc.loop_period = loop_period;
+
+        vkCmdPushConstants(command_buffer, vulkan_state.fft_evolved_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FFTEvolvedPushConstants), &pc);
+        vkCmdDispatch(command_buffer, FFT_SIZE / 16, FFT_SIZE / 16, 1);
+
+        memoryBarrier(command_buffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+    }
+
+    if (use_shared_memory_fft)
+    {
+        // FFT ROWS: a whole row per workgroup in shared memory
+        {
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_rows_pipeline);
+
+            VkDescriptorSet rows_sets[2] =
+            {
+                vulkan_state.fft_buffer_a_descriptor_set,   // source (read)
+                vulkan_state.fft_rows_descriptor_set,       // destination (write)
+            };
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_rows_pipeline_layout, 0, 2, rows_sets, 0, 0);
+
+            FFTRowsPushConstants pc = {0};
+            pc.texture_size = FFT_SIZE;
+            pc.water_tile_length = water_tile_length;
+
+            vkCmdPushConstants(command_buffer, vulkan_state.fft_rows_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FFTRowsPushConstants), &pc);
+            vkCmdDispatch(command_buffer, FFT_SIZE, 1, 1);
+
+            memoryBarrier(command_buffer,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+        }
+
+        // FFT COLUMNS: same per column, writing height and normal straight to the displacement image
+        {
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_columns_pipeline);
+
+            VkDescriptorSet columns_sets[2] =
+            {
+                vulkan_state.fft_rows_descriptor_set,       // source (read)
+                vulkan_state.displacement_descriptor_set,   // destination (write)
+            };
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_columns_pipeline_layout, 0, 2, columns_sets, 0, 0);
+
+            vkCmdDispatch(command_buffer, FFT_SIZE, 1, 1);
+        }
+    }
+    else
+    {
+        // FFT PASSES (8 horizontal, then 8 vertical)
+        {
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_pass_pipeline);
+
+            int32 log2_fft_size = 8; // log2(256)
+            
+            // tracks which buffer is currently the source
+            bool source_is_a = true;
+
+            for (int32 pass_index = 0; pass_index < 2 * log2_fft_size; pass_index++)
+            {
+                int32 direction = (pass_index < log2_fft_size) ? 0 : 1; // first 8 horizontal, next 8 vertical
+                int32 level = (pass_index % log2_fft_size) + 1;
+
+                VkDescriptorSet pass_sets[2] =
+                {
+                    source_is_a ? vulkan_state.fft_buffer_a_descriptor_set : vulkan_state.fft_buffer_b_descriptor_set, // source
+                    source_is_a ? vulkan_state.fft_buffer_b_descriptor_set : vulkan_state.fft_buffer_a_descriptor_set, // dest
+                };
+
+                vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_pass_pipeline_layout, 0, 2, pass_sets, 0, 0);
+
+                FFTPassPushConstants pc = {0};
+                pc.texture_size = FFT_SIZE;
+                pc.level = level;
+                pc.direction = direction;
+
+                vkCmdPushConstants(command_buffer, vulkan_state.fft_pass_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FFTPassPushConstants), &pc);
+
+                vkCmdDispatch(command_buffer, (FFT_SIZE / 2) / 16, FFT_SIZE / 16, 1);
+
+                memoryBarrier(command_buffer,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+                source_is_a = !source_is_a;
+            }
+        }
+
+        // FFT FINALIZE: real part of fft_buffer_a, normalize
+        {
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_finalize_pipeline);
+            
+            VkDescriptorSet finalize_sets[2] =
+            {
+                vulkan_state.fft_buffer_a_descriptor_set,   // source (read)
+                vulkan_state.displacement_descriptor_set,   // destination (write)
+            };
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_finalize_pipeline_layout, 0, 2, finalize_sets, 0, 0);
+            
+            FFTFinalizePushConstants pc = {0};
+            pc.texture_size = FFT_SIZE;
+            pc.water_tile_length = water_tile_length;
+            
+            vkCmdPushConstants(command_buffer, vulkan_state.fft_finalize_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FFTFinalizePushConstants), &pc);
+            
+            // dispatch one thread per texel
+            vkCmdDispatch(command_buffer, FFT_SIZE / 16, FFT_SIZE / 16, 1);
+        }
+    }
+}
+
+// times the water simulation both ways on the gpu: the shared memory row and column passes against the original per level
+// passes, each run waiting on the last like frames do. results go to the debugger output
+void vulkanFftBenchmark()
+{
+    const int32 run_count = 256;
+    bool default_shared_memory_fft = use_shared_memory_fft;
+
+    VkQueryPoolCreateInfo qp_ci = {0};
+    qp_ci.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    qp_ci.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    qp_ci.queryCount = 4;
+
+    VkQueryPool query_pool = VK_NULL_HANDLE;
+    vkCreateQueryPool(vulkan_state.logical_device_handle, &qp_ci, 0, &query_pool);
+
+    VkCommandBufferAllocateInfo cb_alloc = {0};
+    cb_alloc.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cb_alloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cb_alloc.commandPool = vulkan_state.graphics_command_pool_handle;
+    cb_alloc.commandBufferCount = 1;
+
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    vkAllocateCommandBuffers(vulkan_state.logical_device_handle, &cb_alloc, &command_buffer);
+
+    VkCommandBufferBeginInfo cb_begin = {0};
+    cb_begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    cb_begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkBeginCommandBuffer(command_buffer, &cb_begin);
+    vkCmdResetQueryPool(command_buffer, query_pool, 0, 4);
+
+    for (int32 path = 0; path < 2; path++)
+    {
+        use_shared_memory_fft = path == 0;
 
-        vkCreateFramebuffer(vulkan_state.logical_device_handle, &fb_ci, 0, &vulkan_state.reflection_framebuffer);
+        vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, query_pool, 2 * path);
+        for (int32 run = 0; run < run_count; run++)
+        {
+            recordWaterFft(command_buffer, (float)run / 60.0f, 0.0f);
+
+            memoryBarrier(command_buffer,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+        }
+        vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query_pool, 2 * path + 1);
     }
-}
 
-void resetPipelineStates(VkPipelineColorBlendAttachmentState* blend, VkPipelineDepthStencilStateCreateInfo* depth_stencil, VkPipelineRasterizationStateCreateInfo* raster)
-{
-    // blend: opaque, no blending
-    blend->blendEnable = VK_FALSE;
-    blend->srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
-    blend->dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
-    blend->colorBlendOp = VK_BLEND_OP_ADD;
-    blend->srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-    blend->dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-    blend->alphaBlendOp = VK_BLEND_OP_ADD;
-    blend->colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    vkEndCommandBuffer(command_buffer);
 
-    // depth: test + write, less
-    depth_stencil->depthTestEnable = VK_TRUE;
-    depth_stencil->depthWriteEnable = VK_TRUE;
-    depth_stencil->depthCompareOp = VK_COMPARE_OP_LESS;
-    depth_stencil->depthBoundsTestEnable = VK_FALSE;
+    VkSubmitInfo submit = {0};
+    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &command_buffer;
 
-    // stencil: off
-    depth_stencil->stencilTestEnable = VK_FALSE;
-    depth_stencil->front.failOp = VK_STENCIL_OP_KEEP;
-    depth_stencil->front.passOp = VK_STENCIL_OP_KEEP;
-    depth_stencil->front.depthFailOp = VK_STENCIL_OP_KEEP;
-    depth_stencil->front.compareOp = VK_COMPARE_OP_ALWAYS;
-    depth_stencil->front.compareMask = 0xFF;
-    depth_stencil->front.writeMask = 0x00;
-    depth_stencil->front.reference = 0;
-    depth_stencil->back = depth_stencil->front;
+    vkQueueSubmit(vulkan_state.graphics_queue_handle, 1, &submit, VK_NULL_HANDLE);
+    vkQueueWaitIdle(vulkan_state.graphics_queue_handle);
 
-    // rasterization: filled, no cull
-    raster->polygonMode = VK_POLYGON_MODE_FILL;
-    raster->cullMode = VK_CULL_MODE_NONE;
-    raster->frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-    raster->lineWidth = 1.0f;
-    raster->depthBiasEnable = VK_FALSE;
+    uint64 timestamps[4] = {0};
+    char output[256];
+    if (vkGetQueryPoolResults(vulkan_state.logical_device_handle, query_pool, 0, 4, sizeof(timestamps), timestamps, sizeof(uint64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) == VK_SUCCESS)
+    {
+        double shared_memory_ms = (double)(timestamps[1] - timestamps[0]) * vulkan_state.timestamp_period / 1e6 / run_count;
+        double per_level_ms     = (double)(timestamps[3] - timestamps[2]) * vulkan_state.timestamp_period / 1e6 / run_count;
+        snprintf(output, sizeof(output), "fft benchmark, %d runs each: shared memory %.3f ms, per level passes %.3f ms per run\n", run_count, shared_memory_ms, per_level_ms);
+    }
+    else snprintf(output, sizeof(output), "fft benchmark: timestamps unavailable\n");
+    OutputDebugStringA(output);
+
+    vkFreeCommandBuffers(vulkan_state.logical_device_handle, vulkan_state.graphics_command_pool_handle, 1, &command_buffer);
+    vkDestroyQueryPool(vulkan_state.logical_device_handle, query_pool, 0);
+
+    use_shared_memory_fft = default_shared_memory_fft;
 }
 
 void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo display)
 {
+    // startup timing, reported at the end
+    LARGE_INTEGER ticks_per_second, startup_start;
+    QueryPerformanceFrequency(&ticks_per_second);
+    QueryPerformanceCounter(&startup_start);
+
     vulkan_display = display;
 
     vulkan_state.platform_handles = platform_handles;
@@ -2933,16 +4721,41 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     // we will need to pass the device extensions we want the logical device to use
     const char* device_extensions[] = { "VK_KHR_swapchain" };
 
+    // model draws are grouped by model, so every draw after the first has a non-zero firstInstance. static mesh draws take their draw count from
+    // the cull pass, which needs drawIndirectCount from vulkan 1.2. anything missing falls back to one draw per command
+    VkPhysicalDeviceProperties device_properties = {0};
+    vkGetPhysicalDeviceProperties(vulkan_state.physical_device_handle, &device_properties);
+    bool device_supports_vulkan_12 = device_properties.apiVersion >= VK_API_VERSION_1_2;
+
+    VkPhysicalDeviceVulkan12Features supported_12_features = {0};
+    supported_12_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceFeatures2 supported_features_2 = {0};
+    supported_features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    if (device_supports_vulkan_12) supported_features_2.pNext = &supported_12_features;
+    vkGetPhysicalDeviceFeatures2(vulkan_state.physical_device_handle, &supported_features_2);
+    VkPhysicalDeviceFeatures supported_features = supported_features_2.features;
+
+    vulkan_state.draw_indirect_first_instance = supported_features.drawIndirectFirstInstance == VK_TRUE;
+    vulkan_state.multi_draw_indirect = supported_features.multiDrawIndirect == VK_TRUE;
+    vulkan_state.draw_indirect_count = device_supports_vulkan_12 && supported_12_features.drawIndirectCount == VK_TRUE;
+
     VkPhysicalDeviceFeatures device_features = {0};
+    device_features.drawIndirectFirstInstance = supported_features.drawIndirectFirstInstance;
     device_features.fillModeNonSolid = VK_TRUE;
     device_features.wideLines = VK_TRUE;
     device_features.fragmentStoresAndAtomics = VK_TRUE;
     device_features.independentBlend = VK_TRUE;
     device_features.textureCompressionBC = VK_TRUE;
     device_features.samplerAnisotropy = VK_TRUE;
+    device_features.multiDrawIndirect = supported_features.multiDrawIndirect;
+
+    VkPhysicalDeviceVulkan12Features vulkan_12_features = {0};
+    vulkan_12_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan_12_features.drawIndirectCount = vulkan_state.draw_indirect_count ? VK_TRUE : VK_FALSE;
 
     VkDeviceCreateInfo device_info = {0}; // struct that bundles everthing the driver needs to create the logical device
     device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    if (device_supports_vulkan_12) device_info.pNext = &vulkan_12_features;
     device_info.queueCreateInfoCount = (graphics_present_families_same ? 1u : 2u);
     device_info.pQueueCreateInfos = queue_family_infos;
     device_info.enabledExtensionCount = 1;
@@ -2952,10 +4765,10 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     vkCreateDevice(vulkan_state.physical_device_handle, &device_info, 0, &vulkan_state.logical_device_handle);
 
     // profiling
-    VkPhysicalDeviceProperties device_properties = {0};
-    vkGetPhysicalDeviceProperties(vulkan_state.physical_device_handle, &device_properties);
     vulkan_state.timestamp_period = device_properties.limits.timestampPeriod;
 
+    createPipelineCache(&device_properties);
+
     vulkan_state.timestamp_query_count = 32;
     for (int frame_index = 0; frame_index < 3; frame_index++)
     {
@@ -3317,16 +5130,95 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         vkCreateRenderPass(vulkan_state.logical_device_handle, &rp_ci, 0, &vulkan_state.reflection_render_pass);
     }
 
+    // weighted blended OIT render pass: lasers blend into accumulation and revealage, depth tested against the finished scene
+    {
+        VkAttachmentDescription wboit_attachments[3] = {0};
+
+        // accumulation, cleared to 0
+        wboit_attachments[0].format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        wboit_attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
+        wboit_attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        wboit_attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        wboit_attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        wboit_attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        wboit_attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        wboit_attachments[0].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        // revealage, cleared to 1
+        wboit_attachments[1].format = VK_FORMAT_R16_SFLOAT;
+        wboit_attachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
+        wboit_attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        wboit_attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        wboit_attachments[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        wboit_attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        wboit_attachments[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        wboit_attachments[1].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        // scene depth, read only
+        wboit_attachments[2].format = vulkan_state.depth_format;
+        wboit_attachments[2].samples = VK_SAMPLE_COUNT_1_BIT;
+        wboit_attachments[2].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        wboit_attachments[2].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        wboit_attachments[2].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        wboit_attachments[2].stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
+        wboit_attachments[2].initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        wboit_attachments[2].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+        VkAttachmentReference wboit_color_refs[2] =
+        {
+            { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL },
+            { 1, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL },
+        };
+
+        VkAttachmentReference wboit_depth_ref = {0};
+        wboit_depth_ref.attachment = 2;
+        wboit_depth_ref.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+        VkSubpassDescription wboit_subpass = {0};
+        wboit_subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        wboit_subpass.colorAttachmentCount = 2;
+        wboit_subpass.pColorAttachments = wboit_color_refs;
+        wboit_subpass.pDepthStencilAttachment = &wboit_depth_ref;
+
+        VkSubpassDependency wboit_dependencies[2] = {0};
+
+        // scene depth writes, and last frame's resolve reading these targets
+        wboit_dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+        wboit_dependencies[0].dstSubpass = 0;
+        wboit_dependencies[0].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        wboit_dependencies[0].dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        wboit_dependencies[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        wboit_dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+        wboit_dependencies[1].srcSubpass = 0;
+        wboit_dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+        wboit_dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        wboit_dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        wboit_dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        wboit_dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        VkRenderPassCreateInfo rp_ci = {0};
+        rp_ci.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        rp_ci.attachmentCount = 3;
+        rp_ci.pAttachments = wboit_attachments;
+        rp_ci.subpassCount = 1;
+        rp_ci.pSubpasses = &wboit_subpass;
+        rp_ci.dependencyCount = 2;
+        rp_ci.pDependencies = wboit_dependencies;
+
+        vkCreateRenderPass(vulkan_state.logical_device_handle, &rp_ci, 0, &vulkan_state.wboit_render_pass);
+    }
+
     // SHADOW RENDER PASS
     {
         VkAttachmentDescription shadow_depth_attachment = {0};
         shadow_depth_attachment.format = vulkan_state.depth_format;
         shadow_depth_attachment.samples = VK_SAMPLE_COUNT_1_BIT;
-        shadow_depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        shadow_depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD; // static casters were copied in
         shadow_depth_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
         shadow_depth_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         shadow_depth_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
-        shadow_depth_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        shadow_depth_attachment.initialLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
         shadow_depth_attachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
 
         VkAttachmentReference shadow_depth_reference = {0};
@@ -3341,12 +5233,13 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
 
         VkSubpassDependency shadow_dependencies[2] = {0};
 
+        // the copy from the static map must land before depth testing
         shadow_dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
         shadow_dependencies[0].dstSubpass = 0;
-        shadow_dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        shadow_dependencies[0].srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
         shadow_dependencies[0].dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-        shadow_dependencies[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        shadow_dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        shadow_dependencies[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        shadow_dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
         // depth writes must be visible
         shadow_dependencies[1].srcSubpass = 0;
@@ -3366,6 +5259,20 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         shadow_render_pass_ci.pDependencies = shadow_dependencies;
 
         vkCreateRenderPass(vulkan_state.logical_device_handle, &shadow_render_pass_ci, 0, &vulkan_state.shadow_render_pass);
+
+        // static variant: cleared, and left ready to be copied from
+        shadow_depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        shadow_depth_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        shadow_depth_attachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+        shadow_dependencies[0].srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        shadow_dependencies[0].srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        shadow_dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+        shadow_dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        shadow_dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        vkCreateRenderPass(vulkan_state.logical_device_handle, &shadow_render_pass_ci, 0, &vulkan_state.shadow_static_render_pass);
     }
 
 	VkCommandPoolCreateInfo command_pool_creation_info = {0}; // describes the command pool tied to graphics queue family
@@ -3425,7 +5332,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         shadow_map_image_ci.format = vulkan_state.depth_format;
         shadow_map_image_ci.tiling = VK_IMAGE_TILING_OPTIMAL;
         shadow_map_image_ci.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        shadow_map_image_ci.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        shadow_map_image_ci.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
         shadow_map_image_ci.samples = VK_SAMPLE_COUNT_1_BIT;
         shadow_map_image_ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
@@ -3454,6 +5361,31 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         shadow_map_view_ci.subresourceRange.layerCount = 1;
 
         vkCreateImageView(vulkan_state.logical_device_handle, &shadow_map_view_ci, 0, &vulkan_state.shadow_map_image_view);
+
+        // static shadow map: same shape, only ever a copy source
+        shadow_map_image_ci.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        vkCreateImage(vulkan_state.logical_device_handle, &shadow_map_image_ci, 0, &vulkan_state.shadow_static_image);
+
+        vkGetImageMemoryRequirements(vulkan_state.logical_device_handle, vulkan_state.shadow_static_image, &shadow_map_memory_requirements);
+        shadow_map_alloc.allocationSize = shadow_map_memory_requirements.size;
+        shadow_map_alloc.memoryTypeIndex = findMemoryType(shadow_map_memory_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        vkAllocateMemory(vulkan_state.logical_device_handle, &shadow_map_alloc, 0, &vulkan_state.shadow_static_image_memory);
+        vkBindImageMemory(vulkan_state.logical_device_handle, vulkan_state.shadow_static_image, vulkan_state.shadow_static_image_memory, 0);
+
+        shadow_map_view_ci.image = vulkan_state.shadow_static_image;
+        vkCreateImageView(vulkan_state.logical_device_handle, &shadow_map_view_ci, 0, &vulkan_state.shadow_static_image_view);
+
+        VkFramebufferCreateInfo shadow_static_framebuffer_ci = {0};
+        shadow_static_framebuffer_ci.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        shadow_static_framebuffer_ci.renderPass = vulkan_state.shadow_static_render_pass;
+        shadow_static_framebuffer_ci.attachmentCount = 1;
+        shadow_static_framebuffer_ci.pAttachments = &vulkan_state.shadow_static_image_view;
+        shadow_static_framebuffer_ci.width = SHADOW_MAP_RESOLUTION;
+        shadow_static_framebuffer_ci.height = SHADOW_MAP_RESOLUTION;
+        shadow_static_framebuffer_ci.layers = 1;
+
+        vkCreateFramebuffer(vulkan_state.logical_device_handle, &shadow_static_framebuffer_ci, 0, &vulkan_state.shadow_static_framebuffer);
     }
 
     // h0 spectrum image
@@ -3551,6 +5483,50 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         vkCreateImageView(vulkan_state.logical_device_handle, &view_ci, 0, &vulkan_state.fft_buffer_b_image_view);
     }
 
+    // fft rows image
+    {
+        VkImageCreateInfo image_ci = {0};
+        image_ci.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        image_ci.imageType = VK_IMAGE_TYPE_2D;
+        image_ci.extent.width = FFT_SIZE;
+        image_ci.extent.height = FFT_SIZE;
+        image_ci.extent.depth = 1;
+        image_ci.mipLevels = 1;
+        image_ci.arrayLayers = 1;
+        image_ci.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        image_ci.tiling = VK_IMAGE_TILING_OPTIMAL;
+        image_ci.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        image_ci.usage = VK_IMAGE_USAGE_STORAGE_BIT;
+        image_ci.samples = VK_SAMPLE_COUNT_1_BIT;
+        image_ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        vkCreateImage(vulkan_state.logical_device_handle, &image_ci, 0, &vulkan_state.fft_rows_image);
+
+        VkMemoryRequirements mem_req = {0};
+        vkGetImageMemoryRequirements(vulkan_state.logical_device_handle, vulkan_state.fft_rows_image, &mem_req);
+
+        VkMemoryAllocateInfo alloc = {0};
+        alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc.allocationSize = mem_req.size;
+        alloc.memoryTypeIndex = findMemoryType(mem_req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        vkAllocateMemory(vulkan_state.logical_device_handle, &alloc, 0, &vulkan_state.fft_rows_image_memory);
+        vkBindImageMemory(vulkan_state.logical_device_handle, vulkan_state.fft_rows_image, vulkan_state.fft_rows_image_memory, 0);
+
+        VkImageViewCreateInfo view_ci = {0};
+        view_ci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        view_ci.image = vulkan_state.fft_rows_image;
+        view_ci.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        view_ci.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        view_ci.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        view_ci.subresourceRange.baseMipLevel = 0;
+        view_ci.subresourceRange.levelCount = 1;
+        view_ci.subresourceRange.baseArrayLayer = 0;
+        view_ci.subresourceRange.layerCount = 1;
+
+        vkCreateImageView(vulkan_state.logical_device_handle, &view_ci, 0, &vulkan_state.fft_rows_image_view);
+    }
+
     // water displacement image
     {
         VkImageCreateInfo image_ci = {0};
@@ -3564,7 +5540,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         image_ci.format = VK_FORMAT_R16G16B16A16_SFLOAT;
         image_ci.tiling = VK_IMAGE_TILING_OPTIMAL;
         image_ci.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        image_ci.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        image_ci.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
         image_ci.samples = VK_SAMPLE_COUNT_1_BIT;
         image_ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         
@@ -3593,6 +5569,100 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         view_ci.subresourceRange.layerCount = 1;
         
         vkCreateImageView(vulkan_state.logical_device_handle, &view_ci, 0, &vulkan_state.displacement_image_view);
+
+        view_ci.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        vkCreateImageView(vulkan_state.logical_device_handle, &view_ci, 0, &vulkan_state.displacement_array_image_view);
+    }
+
+    // baked water loop image
+    {
+        VkImageCreateInfo image_ci = {0};
+        image_ci.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        image_ci.imageType = VK_IMAGE_TYPE_2D;
+        image_ci.extent.width = FFT_SIZE;
+        image_ci.extent.height = FFT_SIZE;
+        image_ci.extent.depth = 1;
+        image_ci.mipLevels = 1;
+        image_ci.arrayLayers = WATER_LOOP_FRAME_COUNT;
+        image_ci.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        image_ci.tiling = VK_IMAGE_TILING_OPTIMAL;
+        image_ci.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        image_ci.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        image_ci.samples = VK_SAMPLE_COUNT_1_BIT;
+        image_ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        vkCreateImage(vulkan_state.logical_device_handle, &image_ci, 0, &vulkan_state.water_loop_image);
+
+        VkMemoryRequirements mem_req = {0};
+        vkGetImageMemoryRequirements(vulkan_state.logical_device_handle, vulkan_state.water_loop_image, &mem_req);
+
+        VkMemoryAllocateInfo alloc = {0};
+        alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc.allocationSize = mem_req.size;
+        alloc.memoryTypeIndex = findMemoryType(mem_req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        vkAllocateMemory(vulkan_state.logical_device_handle, &alloc, 0, &vulkan_state.water_loop_image_memory);
+        vkBindImageMemory(vulkan_state.logical_device_handle, vulkan_state.water_loop_image, vulkan_state.water_loop_image_memory, 0);
+
+        VkImageViewCreateInfo view_ci = {0};
+        view_ci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        view_ci.image = vulkan_state.water_loop_image;
+        view_ci.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        view_ci.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        view_ci.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        view_ci.subresourceRange.baseMipLevel = 0;
+        view_ci.subresourceRange.levelCount = 1;
+        view_ci.subresourceRange.baseArrayLayer = 0;
+        view_ci.subresourceRange.layerCount = WATER_LOOP_FRAME_COUNT;
+
+        vkCreateImageView(vulkan_state.logical_device_handle, &view_ci, 0, &vulkan_state.water_loop_image_view);
+    }
+
+    // water history image
+    {
+        VkImageCreateInfo image_ci = {0};
+        image_ci.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        image_ci.imageType = VK_IMAGE_TYPE_2D;
+        image_ci.extent.width = FFT_SIZE;
+        image_ci.extent.height = FFT_SIZE;
+        image_ci.extent.depth = 1;
+        image_ci.mipLevels = 1;
+        image_ci.arrayLayers = 2;
+        image_ci.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        image_ci.tiling = VK_IMAGE_TILING_OPTIMAL;
+        image_ci.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        image_ci.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        image_ci.samples = VK_SAMPLE_COUNT_1_BIT;
+        image_ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        vkCreateImage(vulkan_state.logical_device_handle, &image_ci, 0, &vulkan_state.water_history_image);
+
+        VkMemoryRequirements mem_req = {0};
+        vkGetImageMemoryRequirements(vulkan_state.logical_device_handle, vulkan_state.water_history_image, &mem_req);
+
+        VkMemoryAllocateInfo alloc = {0};
+        alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc.allocationSize = mem_req.size;
+        alloc.memoryTypeIndex = findMemoryType(mem_req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        vkAllocateMemory(vulkan_state.logical_device_handle, &alloc, 0, &vulkan_state.water_history_image_memory);
+        vkBindImageMemory(vulkan_state.logical_device_handle, vulkan_state.water_history_image, vulkan_state.water_history_image_memory, 0);
+
+        VkImageViewCreateInfo view_ci = {0};
+        view_ci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        view_ci.image = vulkan_state.water_history_image;
+        view_ci.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        view_ci.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        view_ci.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        view_ci.subresourceRange.baseMipLevel = 0;
+        view_ci.subresourceRange.levelCount = 1;
+        view_ci.subresourceRange.baseArrayLayer = 0;
+        view_ci.subresourceRange.layerCount = 2;
+
+        vkCreateImageView(vulkan_state.logical_device_handle, &view_ci, 0, &vulkan_state.water_history_image_view);
+
+        vulkan_state.water_history_ticks[0] = -1;
+        vulkan_state.water_history_ticks[1] = -1;
     }
 
     // LOADING SHADER MODULES
@@ -3601,6 +5671,9 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     VkShaderModule fft_evolved_smh = {0};
     VkShaderModule fft_pass_smh = {0};
     VkShaderModule fft_finalize_smh = {0};
+    VkShaderModule fft_rows_smh = {0};
+    VkShaderModule fft_columns_smh = {0};
+    VkShaderModule cull_smh = {0};
     VkShaderModule cube_vert_smh = {0};
     VkShaderModule cube_frag_smh = {0};
     VkShaderModule model_vert_smh = {0};
@@ -3615,6 +5688,8 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     VkShaderModule laser_frag_smh = {0};
     VkShaderModule oit_resolve_vert_smh = {0};
     VkShaderModule oit_resolve_frag_smh = {0};
+    VkShaderModule laser_wboit_frag_smh = {0};
+    VkShaderModule oit_wboit_resolve_frag_smh = {0};
     VkShaderModule outline_select_vert_smh = {0};
     VkShaderModule outline_select_frag_smh = {0};
     VkShaderModule sprite_vert_smh = {0};
@@ -3624,6 +5699,9 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     VkPipelineShaderStageCreateInfo fft_evolved_stage_ci            = loadShaderStage("data/shaders/spirv/fft-evolved.comp.spv",            &fft_evolved_smh,           VK_SHADER_STAGE_COMPUTE_BIT);
     VkPipelineShaderStageCreateInfo fft_pass_stage_ci               = loadShaderStage("data/shaders/spirv/fft-pass.comp.spv",               &fft_pass_smh,              VK_SHADER_STAGE_COMPUTE_BIT);
     VkPipelineShaderStageCreateInfo fft_finalize_stage_ci           = loadShaderStage("data/shaders/spirv/fft-finalize.comp.spv",           &fft_finalize_smh,          VK_SHADER_STAGE_COMPUTE_BIT);
+    VkPipelineShaderStageCreateInfo fft_rows_stage_ci               = loadShaderStage("data/shaders/spirv/fft-rows.comp.spv",               &fft_rows_smh,              VK_SHADER_STAGE_COMPUTE_BIT);
+    VkPipelineShaderStageCreateInfo fft_columns_stage_ci            = loadShaderStage("data/shaders/spirv/fft-columns.comp.spv",            &fft_columns_smh,           VK_SHADER_STAGE_COMPUTE_BIT);
+    VkPipelineShaderStageCreateInfo cull_stage_ci                   = loadShaderStage("data/shaders/spirv/cull.comp.spv",                   &cull_smh,                  VK_SHADER_STAGE_COMPUTE_BIT);
     VkPipelineShaderStageCreateInfo cube_vert_stage_ci 	 	        = loadShaderStage("data/shaders/spirv/cube.vert.spv", 	  	  	        &cube_vert_smh, 	  	    VK_SHADER_STAGE_VERTEX_BIT);
 	VkPipelineShaderStageCreateInfo cube_frag_stage_ci 	 	        = loadShaderStage("data/shaders/spirv/cube.frag.spv", 	  	  	        &cube_frag_smh, 	  		VK_SHADER_STAGE_FRAGMENT_BIT);
 	VkPipelineShaderStageCreateInfo model_vert_stage_ci 	 	    = loadShaderStage("data/shaders/spirv/model.vert.spv",   	  	        &model_vert_smh,   		    VK_SHADER_STAGE_VERTEX_BIT);
@@ -3638,6 +5716,8 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     VkPipelineShaderStageCreateInfo laser_frag_stage_ci             = loadShaderStage("data/shaders/spirv/laser.frag.spv",                  &laser_frag_smh,            VK_SHADER_STAGE_FRAGMENT_BIT);
     VkPipelineShaderStageCreateInfo oit_resolve_vert_stage_ci       = loadShaderStage("data/shaders/spirv/oit-resolve.vert.spv",            &oit_resolve_vert_smh,      VK_SHADER_STAGE_VERTEX_BIT);
     VkPipelineShaderStageCreateInfo oit_resolve_frag_stage_ci       = loadShaderStage("data/shaders/spirv/oit-resolve.frag.spv",            &oit_resolve_frag_smh,      VK_SHADER_STAGE_FRAGMENT_BIT);
+    VkPipelineShaderStageCreateInfo laser_wboit_frag_stage_ci       = loadShaderStage("data/shaders/spirv/laser-wboit.frag.spv",            &laser_wboit_frag_smh,      VK_SHADER_STAGE_FRAGMENT_BIT);
+    VkPipelineShaderStageCreateInfo oit_wboit_resolve_frag_stage_ci = loadShaderStage("data/shaders/spirv/oit-wboit-resolve.frag.spv",      &oit_wboit_resolve_frag_smh, VK_SHADER_STAGE_FRAGMENT_BIT);
     VkPipelineShaderStageCreateInfo outline_select_vert_stage_ci    = loadShaderStage("data/shaders/spirv/outline-select.vert.spv",         &outline_select_vert_smh, 	VK_SHADER_STAGE_VERTEX_BIT);
 	VkPipelineShaderStageCreateInfo outline_select_frag_stage_ci    = loadShaderStage("data/shaders/spirv/outline-select.frag.spv",         &outline_select_frag_smh, 	VK_SHADER_STAGE_FRAGMENT_BIT);
 	VkPipelineShaderStageCreateInfo sprite_vert_stage_ci  	        = loadShaderStage("data/shaders/spirv/sprite.vert.spv",  	  	        &sprite_vert_smh,  		    VK_SHADER_STAGE_VERTEX_BIT);
@@ -3649,6 +5729,8 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     VkPipelineShaderStageCreateInfo water_shader_stages[2]          = { water_vert_stage_ci,            water_frag_stage_ci };
     VkPipelineShaderStageCreateInfo laser_shader_stages[2]          = { laser_vert_stage_ci,            laser_frag_stage_ci };
     VkPipelineShaderStageCreateInfo oit_resolve_shader_stages[2]    = { oit_resolve_vert_stage_ci,      oit_resolve_frag_stage_ci };
+    VkPipelineShaderStageCreateInfo laser_wboit_shader_stages[2]    = { laser_vert_stage_ci,            laser_wboit_frag_stage_ci };
+    VkPipelineShaderStageCreateInfo oit_wboit_resolve_stages[2]     = { oit_resolve_vert_stage_ci,      oit_wboit_resolve_frag_stage_ci };
     VkPipelineShaderStageCreateInfo outline_select_shader_stages[2] = { outline_select_vert_stage_ci,   outline_select_frag_stage_ci }; 
     VkPipelineShaderStageCreateInfo sprite_shader_stages[2]  	    = { sprite_vert_stage_ci,  	        sprite_frag_stage_ci };
     VkPipelineShaderStageCreateInfo shadow_cube_stages[1]           = { shadow_cube_vert_stage_ci };
@@ -3701,7 +5783,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     vertex_bindings_instanced[1].stride = sizeof(CubeInstanceData);
     vertex_bindings_instanced[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 
-    VkVertexInputAttributeDescription vertex_attributes_instanced[9] = {0};
+    VkVertexInputAttributeDescription vertex_attributes_instanced[6] = {0};
 
     vertex_attributes_instanced[0].binding = 0;
     vertex_attributes_instanced[0].location = 0;
@@ -3725,34 +5807,19 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
 
     vertex_attributes_instanced[4].binding = 1;
     vertex_attributes_instanced[4].location = 4;
-    vertex_attributes_instanced[4].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    vertex_attributes_instanced[4].offset = offsetof(CubeInstanceData, model) + 0;
+    vertex_attributes_instanced[4].format = VK_FORMAT_R16G16B16A16_SINT;
+    vertex_attributes_instanced[4].offset = offsetof(CubeInstanceData, position);
 
     vertex_attributes_instanced[5].binding = 1;
     vertex_attributes_instanced[5].location = 5;
-    vertex_attributes_instanced[5].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    vertex_attributes_instanced[5].offset = offsetof(CubeInstanceData, model) + 16;
-
-    vertex_attributes_instanced[6].binding = 1;
-    vertex_attributes_instanced[6].location = 6;
-    vertex_attributes_instanced[6].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    vertex_attributes_instanced[6].offset = offsetof(CubeInstanceData, model) + 32;
-
-    vertex_attributes_instanced[7].binding = 1;
-    vertex_attributes_instanced[7].location = 7;
-    vertex_attributes_instanced[7].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    vertex_attributes_instanced[7].offset = offsetof(CubeInstanceData, model) + 48;
-
-    vertex_attributes_instanced[8].binding = 1;
-    vertex_attributes_instanced[8].location = 8;
-    vertex_attributes_instanced[8].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    vertex_attributes_instanced[8].offset = offsetof(CubeInstanceData, uv_rect);
+    vertex_attributes_instanced[5].format = VK_FORMAT_R16G16B16A16_SNORM;
+    vertex_attributes_instanced[5].offset = offsetof(CubeInstanceData, rotation);
 
     VkPipelineVertexInputStateCreateInfo vertex_input_instanced = {0};
     vertex_input_instanced.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
     vertex_input_instanced.vertexBindingDescriptionCount = 2;
     vertex_input_instanced.pVertexBindingDescriptions = vertex_bindings_instanced;
-    vertex_input_instanced.vertexAttributeDescriptionCount = 9;
+    vertex_input_instanced.vertexAttributeDescriptionCount = 6;
     vertex_input_instanced.pVertexAttributeDescriptions = vertex_attributes_instanced;
 
     // water vertex input (instanced)
@@ -3839,6 +5906,49 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     laser_vertex_input.vertexAttributeDescriptionCount = 6;
     laser_vertex_input.pVertexAttributeDescriptions = laser_attributes;
 
+    // sprite instancing
+    VkVertexInputBindingDescription sprite_bindings[2] = {0};
+    sprite_bindings[0].binding = 0;
+    sprite_bindings[0].stride = sizeof(Vertex);
+    sprite_bindings[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    sprite_bindings[1].binding = 1;
+    sprite_bindings[1].stride = sizeof(SpriteInstanceData);
+    sprite_bindings[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+    VkVertexInputAttributeDescription sprite_attributes[5] = {0};
+
+    sprite_attributes[0].binding = 0;
+    sprite_attributes[0].location = 0;
+    sprite_attributes[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+    sprite_attributes[0].offset = offsetof(Vertex, x);
+
+    sprite_attributes[1].binding = 0;
+    sprite_attributes[1].location = 1;
+    sprite_attributes[1].format = VK_FORMAT_R32G32_SFLOAT;
+    sprite_attributes[1].offset = offsetof(Vertex, u);
+
+    sprite_attributes[2].binding = 1; // coords.xyz + alpha.w
+    sprite_attributes[2].location = 4;
+    sprite_attributes[2].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    sprite_attributes[2].offset = offsetof(SpriteInstanceData, coords);
+
+    sprite_attributes[3].binding = 1; // uv rect
+    sprite_attributes[3].location = 5;
+    sprite_attributes[3].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    sprite_attributes[3].offset = offsetof(SpriteInstanceData, uv_rect);
+
+    sprite_attributes[4].binding = 1; // size
+    sprite_attributes[4].location = 6;
+    sprite_attributes[4].format = VK_FORMAT_R32G32_SFLOAT;
+    sprite_attributes[4].offset = offsetof(SpriteInstanceData, size);
+
+    VkPipelineVertexInputStateCreateInfo sprite_vertex_input = {0};
+    sprite_vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    sprite_vertex_input.vertexBindingDescriptionCount = 2;
+    sprite_vertex_input.pVertexBindingDescriptions = sprite_bindings;
+    sprite_vertex_input.vertexAttributeDescriptionCount = 5;
+    sprite_vertex_input.pVertexAttributeDescriptions = sprite_attributes;
+
     VkPipelineVertexInputStateCreateInfo empty_vertex_input = {0};
     empty_vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 
@@ -4035,7 +6145,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     ssbo_binding.binding = 0;
     ssbo_binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
     ssbo_binding.descriptorCount = 1;
-    ssbo_binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    ssbo_binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_VERTEX_BIT; // vertex for model instances
 
     VkDescriptorSetLayoutCreateInfo ssbo_layout_ci = {0};
     ssbo_layout_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
@@ -4064,9 +6174,9 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     descriptor_pool_sizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptor_pool_sizes[1].descriptorCount = 4;
     descriptor_pool_sizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-    descriptor_pool_sizes[2].descriptorCount = 4 + 1 + 1 + 1 + 1 + 1; // oit head image, h0, fft_buffer_a and b, water displacement TODO: this is silly
+    descriptor_pool_sizes[2].descriptorCount = 4 + 1 + 1 + 1 + 1 + 1 + 1; // oit head image, h0, fft_buffer_a and b, water displacement, fft rows TODO: this is silly
     descriptor_pool_sizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    descriptor_pool_sizes[3].descriptorCount = 8 + 2; // +2 for oit pool and counter
+    descriptor_pool_sizes[3].descriptorCount = 8 + 2 + 5 * 2 + 2; // +2 for oit pool and counter, +5 per frame in flight for culling, +2 for model instances
     
     VkDescriptorPoolCreateInfo descriptor_pool_creation_info = {0};
     descriptor_pool_creation_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -4088,7 +6198,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         binding.binding = 0;
         binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         binding.descriptorCount = 1;
-        binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT; // compute for the cull pass
 
         VkDescriptorSetLayoutCreateInfo layout_ci = {0};
         layout_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
@@ -4245,6 +6355,15 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     oit_counter_alloc_info.descriptorSetCount = 1;
     oit_counter_alloc_info.pSetLayouts = &vulkan_state.ssbo_descriptor_set_layout;
     vkAllocateDescriptorSets(vulkan_state.logical_device_handle, &oit_counter_alloc_info, &vulkan_state.oit_counter_descriptor_set);
+
+    // weighted blended OIT targets, sampled by the resolve
+    VkDescriptorSetAllocateInfo wboit_alloc_info = {0};
+    wboit_alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    wboit_alloc_info.descriptorPool = vulkan_state.descriptor_pool;
+    wboit_alloc_info.descriptorSetCount = 1;
+    wboit_alloc_info.pSetLayouts = &vulkan_state.descriptor_set_layout;
+    vkAllocateDescriptorSets(vulkan_state.logical_device_handle, &wboit_alloc_info, &vulkan_state.wboit_accumulation_descriptor_set);
+    vkAllocateDescriptorSets(vulkan_state.logical_device_handle, &wboit_alloc_info, &vulkan_state.wboit_revealage_descriptor_set);
     
     // below descriptor sets are updated only once, because they don't need to be updated on resize
 
@@ -4321,6 +6440,30 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         vkUpdateDescriptorSets(vulkan_state.logical_device_handle, 1, &write, 0, 0);
     }
 
+    // fft rows storage
+    {
+        VkDescriptorSetAllocateInfo alloc_info = {0};
+        alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        alloc_info.descriptorPool = vulkan_state.descriptor_pool;
+        alloc_info.descriptorSetCount = 1;
+        alloc_info.pSetLayouts = &vulkan_state.storage_image_descriptor_set_layout;
+        vkAllocateDescriptorSets(vulkan_state.logical_device_handle, &alloc_info, &vulkan_state.fft_rows_descriptor_set);
+
+        VkDescriptorImageInfo image_info = {0};
+        image_info.imageView = vulkan_state.fft_rows_image_view;
+        image_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+        VkWriteDescriptorSet write = {0};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = vulkan_state.fft_rows_descriptor_set;
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        write.pImageInfo = &image_info;
+
+        vkUpdateDescriptorSets(vulkan_state.logical_device_handle, 1, &write, 0, 0);
+    }
+
     // fft_buffer_a sampled
     {
         VkDescriptorSetAllocateInfo alloc_info = {0};
@@ -4444,6 +6587,47 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         vkUpdateDescriptorSets(vulkan_state.logical_device_handle, 1, &write, 0, 0);
     }
 
+    // water frames sampled: the live displacement as a one layer array, the baked loop, and the reduced rate history
+    {
+        VkDescriptorSetAllocateInfo alloc_info = {0};
+        alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        alloc_info.descriptorPool = vulkan_state.descriptor_pool;
+        alloc_info.descriptorSetCount = 1;
+        alloc_info.pSetLayouts = &vulkan_state.descriptor_set_layout;
+        vkAllocateDescriptorSets(vulkan_state.logical_device_handle, &alloc_info, &vulkan_state.displacement_array_sampled_descriptor_set);
+
+        VkDescriptorImageInfo image_info = {0};
+        image_info.sampler = vulkan_state.tiling_linear_sampler;
+        image_info.imageView = vulkan_state.displacement_array_image_view;
+        image_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+        VkWriteDescriptorSet write = {0};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = vulkan_state.displacement_array_sampled_descriptor_set;
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &image_info;
+
+        vkUpdateDescriptorSets(vulkan_state.logical_device_handle, 1, &write, 0, 0);
+
+        vkAllocateDescriptorSets(vulkan_state.logical_device_handle, &alloc_info, &vulkan_state.water_loop_sampled_descriptor_set);
+
+        image_info.imageView = vulkan_state.water_loop_image_view;
+        image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        write.dstSet = vulkan_state.water_loop_sampled_descriptor_set;
+
+        vkUpdateDescriptorSets(vulkan_state.logical_device_handle, 1, &write, 0, 0);
+
+        vkAllocateDescriptorSets(vulkan_state.logical_device_handle, &alloc_info, &vulkan_state.water_history_sampled_descriptor_set);
+
+        image_info.imageView = vulkan_state.water_history_image_view;
+        image_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        write.dstSet = vulkan_state.water_history_sampled_descriptor_set;
+
+        vkUpdateDescriptorSets(vulkan_state.logical_device_handle, 1, &write, 0, 0);
+    }
+
 	createSwapchainResources();
 
 	// CUBE (INSTANCED) PIPELINE LAYOUT
@@ -4467,24 +6651,20 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
 
     // MODEL PIPELINE LAYOUT
     {
-        VkPushConstantRange push_constant_range = {0};
-        push_constant_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-        push_constant_range.offset = 0;
-        push_constant_range.size = (uint32)sizeof(ModelPushConstants);
-
-        VkDescriptorSetLayout model_set_layouts[3] =
+        VkDescriptorSetLayout model_set_layouts[4] =
         {
-            vulkan_state.view_constants_set_layout, // per-view constants
-            vulkan_state.descriptor_set_layout,     // water displacement
-            vulkan_state.descriptor_set_layout,     // shadow map
+            vulkan_state.view_constants_set_layout,  // per-view constants
+            vulkan_state.descriptor_set_layout,      // water displacement
+            vulkan_state.descriptor_set_layout,      // shadow map
+            vulkan_state.ssbo_descriptor_set_layout, // model instances
         };
 
         VkPipelineLayoutCreateInfo model_pipeline_layout_ci = {0};
         model_pipeline_layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        model_pipeline_layout_ci.setLayoutCount = 3;
+        model_pipeline_layout_ci.setLayoutCount = 4;
         model_pipeline_layout_ci.pSetLayouts = model_set_layouts;
-        model_pipeline_layout_ci.pushConstantRangeCount = 1;
-        model_pipeline_layout_ci.pPushConstantRanges = &push_constant_range;
+        model_pipeline_layout_ci.pushConstantRangeCount = 0;
+        model_pipeline_layout_ci.pPushConstantRanges = 0;
 
         vkCreatePipelineLayout(vulkan_state.logical_device_handle, &model_pipeline_layout_ci, 0, &vulkan_state.model_pipeline_layout);
     }
@@ -4520,7 +6700,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
             vulkan_state.descriptor_set_layout,         // underwater scene copy
             vulkan_state.descriptor_set_layout,         // scene depth
             vulkan_state.descriptor_set_layout,         // paint texture
-            vulkan_state.descriptor_set_layout,         // displacement texture
+            vulkan_state.descriptor_set_layout,         // water frames (displacement array)
             vulkan_state.descriptor_set_layout,         // reflection texture
             vulkan_state.descriptor_set_layout,         // water grid texture
             vulkan_state.descriptor_set_layout,         // water grid normals texture
@@ -4528,12 +6708,17 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
             vulkan_state.descriptor_set_layout,         // reflection distance
         };
 
+        VkPushConstantRange water_push_constant_range = {0};
+        water_push_constant_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        water_push_constant_range.offset = 0;
+        water_push_constant_range.size = (uint32)sizeof(WaterPushConstants);
+
         VkPipelineLayoutCreateInfo water_pipeline_layout_ci = {0};
         water_pipeline_layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         water_pipeline_layout_ci.setLayoutCount = 10;
         water_pipeline_layout_ci.pSetLayouts = water_set_layouts;
-        water_pipeline_layout_ci.pushConstantRangeCount = 0;
-        water_pipeline_layout_ci.pPushConstantRanges = 0;
+        water_pipeline_layout_ci.pushConstantRangeCount = 1;
+        water_pipeline_layout_ci.pPushConstantRanges = &water_push_constant_range;
 
         vkCreatePipelineLayout(vulkan_state.logical_device_handle, &water_pipeline_layout_ci, 0, &vulkan_state.water_pipeline_layout);
     }
@@ -4600,13 +6785,38 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         vkCreatePipelineLayout(vulkan_state.logical_device_handle, &layout_ci, 0, &vulkan_state.oit_resolve_pipeline_layout);
     }
 
-	// SPRITE PIPELINE LAYOUT
+    // WEIGHTED BLENDED OIT LASER PIPELINE LAYOUT
     {
-        VkPushConstantRange push_constant_range = {0};
-        push_constant_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-        push_constant_range.offset = 0;
-        push_constant_range.size = (uint32)sizeof(SpritePushConstants);
+        VkPipelineLayoutCreateInfo layout_ci = {0};
+        layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layout_ci.setLayoutCount = 1;
+        layout_ci.pSetLayouts = &vulkan_state.view_constants_set_layout;
+        layout_ci.pushConstantRangeCount = 0;
+        layout_ci.pPushConstantRanges = 0;
+
+        vkCreatePipelineLayout(vulkan_state.logical_device_handle, &layout_ci, 0, &vulkan_state.laser_wboit_pipeline_layout);
+    }
+
+    // WEIGHTED BLENDED OIT RESOLVE PIPELINE LAYOUT
+    {
+        VkDescriptorSetLayout wboit_resolve_set_layouts[2] =
+        {
+            vulkan_state.descriptor_set_layout, // accumulation
+            vulkan_state.descriptor_set_layout, // revealage
+        };
+
+        VkPipelineLayoutCreateInfo layout_ci = {0};
+        layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layout_ci.setLayoutCount = 2;
+        layout_ci.pSetLayouts = wboit_resolve_set_layouts;
+        layout_ci.pushConstantRangeCount = 0;
+        layout_ci.pPushConstantRanges = 0;
+
+        vkCreatePipelineLayout(vulkan_state.logical_device_handle, &layout_ci, 0, &vulkan_state.oit_wboit_resolve_pipeline_layout);
+    }
 
+	// SPRITE PIPELINE LAYOUT
+    {
         VkDescriptorSetLayout sprite_set_layouts[2] =
         {
             vulkan_state.view_constants_set_layout, // per-view constants
@@ -4617,25 +6827,26 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         sprite_pipeline_layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         sprite_pipeline_layout_ci.setLayoutCount = 2;
         sprite_pipeline_layout_ci.pSetLayouts = sprite_set_layouts;
-        sprite_pipeline_layout_ci.pushConstantRangeCount = 1;
-        sprite_pipeline_layout_ci.pPushConstantRanges = &push_constant_range;
+        sprite_pipeline_layout_ci.pushConstantRangeCount = 0;
+        sprite_pipeline_layout_ci.pPushConstantRanges = 0;
 
         vkCreatePipelineLayout(vulkan_state.logical_device_handle, &sprite_pipeline_layout_ci, 0, &vulkan_state.sprite_pipeline_layout);
     }
 
     // SHADOW PIPELINE LAYOUT
     {
-        VkPushConstantRange shadow_push_constant_range = {0};
-        shadow_push_constant_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-        shadow_push_constant_range.offset = 0;
-        shadow_push_constant_range.size = sizeof(float) * 16;
+        VkDescriptorSetLayout shadow_set_layouts[2] =
+        {
+            vulkan_state.view_constants_set_layout,
+            vulkan_state.ssbo_descriptor_set_layout, // model instances; cubes don't use it
+        };
 
         VkPipelineLayoutCreateInfo shadow_pipeline_layout_ci = {0};
         shadow_pipeline_layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        shadow_pipeline_layout_ci.setLayoutCount = 1;
-        shadow_pipeline_layout_ci.pSetLayouts = &vulkan_state.view_constants_set_layout;
-        shadow_pipeline_layout_ci.pushConstantRangeCount = 1;
-        shadow_pipeline_layout_ci.pPushConstantRanges = &shadow_push_constant_range;
+        shadow_pipeline_layout_ci.setLayoutCount = 2;
+        shadow_pipeline_layout_ci.pSetLayouts = shadow_set_layouts;
+        shadow_pipeline_layout_ci.pushConstantRangeCount = 0;
+        shadow_pipeline_layout_ci.pPushConstantRanges = 0;
 
         vkCreatePipelineLayout(vulkan_state.logical_device_handle, &shadow_pipeline_layout_ci, 0, &vulkan_state.shadow_pipeline_layout);
     }
@@ -4727,6 +6938,85 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         vkCreatePipelineLayout(vulkan_state.logical_device_handle, &layout_ci, 0, &vulkan_state.fft_finalize_pipeline_layout);
     }
 
+    // FFT ROWS PIPELINE LAYOUT
+    {
+        VkPushConstantRange push_constant_range = {0};
+        push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = (uint32)sizeof(FFTRowsPushConstants);
+
+        VkDescriptorSetLayout rows_set_layouts[2] =
+        {
+            vulkan_state.storage_image_descriptor_set_layout, // read from fft_buffer_a
+            vulkan_state.storage_image_descriptor_set_layout, // write to fft rows
+        };
+
+        VkPipelineLayoutCreateInfo layout_ci = {0};
+        layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layout_ci.setLayoutCount = 2;
+        layout_ci.pSetLayouts = rows_set_layouts;
+        layout_ci.pushConstantRangeCount = 1;
+        layout_ci.pPushConstantRanges = &push_constant_range;
+
+        vkCreatePipelineLayout(vulkan_state.logical_device_handle, &layout_ci, 0, &vulkan_state.fft_rows_pipeline_layout);
+    }
+
+    // FFT COLUMNS PIPELINE LAYOUT
+    {
+        VkDescriptorSetLayout columns_set_layouts[2] =
+        {
+            vulkan_state.storage_image_descriptor_set_layout, // read from fft rows
+            vulkan_state.storage_image_descriptor_set_layout, // write to displacement
+        };
+
+        VkPipelineLayoutCreateInfo layout_ci = {0};
+        layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layout_ci.setLayoutCount = 2;
+        layout_ci.pSetLayouts = columns_set_layouts;
+
+        vkCreatePipelineLayout(vulkan_state.logical_device_handle, &layout_ci, 0, &vulkan_state.fft_columns_pipeline_layout);
+    }
+
+    // CULL PIPELINE LAYOUT
+    {
+        // chunk bounds, cube instances, compacted chunk draws, compacted cube instances, per view counts
+        VkDescriptorSetLayoutBinding cull_bindings[5] = {0};
+        for (uint32 binding_index = 0; binding_index < 5; binding_index++)
+        {
+            cull_bindings[binding_index].binding = binding_index;
+            cull_bindings[binding_index].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            cull_bindings[binding_index].descriptorCount = 1;
+            cull_bindings[binding_index].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo cull_set_layout_ci = {0};
+        cull_set_layout_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        cull_set_layout_ci.bindingCount = 5;
+        cull_set_layout_ci.pBindings = cull_bindings;
+
+        vkCreateDescriptorSetLayout(vulkan_state.logical_device_handle, &cull_set_layout_ci, 0, &vulkan_state.cull_descriptor_set_layout);
+
+        VkPushConstantRange push_constant_range = {0};
+        push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = (uint32)sizeof(CullPushConstants);
+
+        VkDescriptorSetLayout cull_set_layouts[2] =
+        {
+            vulkan_state.view_constants_set_layout,
+            vulkan_state.cull_descriptor_set_layout,
+        };
+
+        VkPipelineLayoutCreateInfo layout_ci = {0};
+        layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layout_ci.setLayoutCount = 2;
+        layout_ci.pSetLayouts = cull_set_layouts;
+        layout_ci.pushConstantRangeCount = 1;
+        layout_ci.pPushConstantRanges = &push_constant_range;
+
+        vkCreatePipelineLayout(vulkan_state.logical_device_handle, &layout_ci, 0, &vulkan_state.cull_pipeline_layout);
+    }
+
     // BASE GRAPHICS PIPELINE INFO
 
    	VkGraphicsPipelineCreateInfo base_graphics_pipeline_creation_info = {0}; // struct that points to all those sub-blocks we just defined; it actually builds the pipeline object
@@ -4747,13 +7037,19 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
 	base_graphics_pipeline_creation_info.basePipelineHandle = VK_NULL_HANDLE; // not deriving from another pipeline.
 	base_graphics_pipeline_creation_info.basePipelineIndex = -1;
 
-    vulkan_state.atlas_2d_asset_index          = getOrLoadAsset((char*)ATLAS_2D_PATH,          VK_FORMAT_R8G8B8A8_SRGB);
-    vulkan_state.atlas_font_asset_index        = getOrLoadAsset((char*)ATLAS_FONT_PATH,        VK_FORMAT_R8G8B8A8_SRGB);
-    vulkan_state.atlas_3d_asset_index          = getOrLoadAsset((char*)ATLAS_3D_PATH,          VK_FORMAT_R8G8B8A8_SRGB);
+    LARGE_INTEGER textures_start, textures_end;
+    QueryPerformanceCounter(&textures_start);
+
+    loadAtlases();
 
     vulkan_state.water_grid_asset_index        = loadDdsArray((char*)WATER_GRID_PATH);
     vulkan_state.water_grid_normal_asset_index = loadDdsArray((char*)WATER_GRID_NORMAL_PATH);
 
+    QueryPerformanceCounter(&textures_end);
+
+    // the definitions below only fill in pipeline_queue. nothing is compiled until startQueuedPipelines
+    PipelineQueue pipeline_queue = {0};
+
 	// define instanced cube pipeline: depth on, blending off
     {
         resetPipelineStates(&color_blend_attachment_state, &depth_stencil_state_creation_info, &rasterization_state_creation_info);
@@ -4770,7 +7066,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         cube_ci.pVertexInputState = &vertex_input_instanced;
         cube_ci.layout = vulkan_state.cube_pipeline_layout;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &cube_ci, 0, &vulkan_state.cube_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &cube_ci, &vulkan_state.cube_pipeline);
     }
 
     // define cube pipeline for reflection
@@ -4800,7 +7096,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         ci.pColorBlendState = &refl_blend_ci;
         ci.pMultisampleState = &reflection_multisample;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &ci, 0, &vulkan_state.cube_reflection_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &ci, &vulkan_state.cube_reflection_pipeline);
     }
 
     // define model pipeline
@@ -4819,7 +7115,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         model_ci.pStages = model_shader_stages;
         model_ci.layout = vulkan_state.model_pipeline_layout;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &model_ci, 0, &vulkan_state.model_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &model_ci, &vulkan_state.model_pipeline);
     }
 
     // define model pipeline for reflection
@@ -4846,7 +7142,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         model_ci.pColorBlendState = &refl_blend_ci;
         model_ci.pMultisampleState = &reflection_multisample;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &model_ci, 0, &vulkan_state.model_reflection_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &model_ci, &vulkan_state.model_reflection_pipeline);
     }
 
     // define overlay outline pipeline (for drawing selection outlines on top of everything)
@@ -4873,7 +7169,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         overlay_outline_ci.renderPass = vulkan_state.overlay_render_pass;
         overlay_outline_ci.pColorBlendState = &overlay_outline_blend_ci;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &overlay_outline_ci, 0, &vulkan_state.editor_outline_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &overlay_outline_ci, &vulkan_state.editor_outline_pipeline);
     }
 
     // define water pipeline (merged depth and real water pass)
@@ -4910,7 +7206,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         water_pipeline_ci.renderPass = vulkan_state.water_render_pass;
         water_pipeline_ci.pColorBlendState = &water_blend_ci;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &water_pipeline_ci, 0, &vulkan_state.water_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &water_pipeline_ci, &vulkan_state.water_pipeline);
     }
 
     // shadow cube pipeline
@@ -4940,7 +7236,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         shadow_cube_ci.layout = vulkan_state.shadow_pipeline_layout;
         shadow_cube_ci.renderPass = vulkan_state.shadow_render_pass;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &shadow_cube_ci, 0, &vulkan_state.shadow_cube_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &shadow_cube_ci, &vulkan_state.shadow_cube_pipeline);
     }
 
     // shadow model pipeline
@@ -4970,7 +7266,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         shadow_model_ci.layout = vulkan_state.shadow_pipeline_layout;
         shadow_model_ci.renderPass = vulkan_state.shadow_render_pass;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &shadow_model_ci, 0, &vulkan_state.shadow_model_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &shadow_model_ci, &vulkan_state.shadow_model_pipeline);
     }
 
     // define outline post pipeline. different enough that we might as well set up an entirely new creation info. sets up state first, then assigns
@@ -5035,7 +7331,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         post_graphics_pipeline_ci.renderPass = vulkan_state.outline_post_render_pass;
         post_graphics_pipeline_ci.subpass = 0;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &post_graphics_pipeline_ci, 0, &vulkan_state.outline_post_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &post_graphics_pipeline_ci, &vulkan_state.outline_post_pipeline);
     }
 
     // define laser pipeline
@@ -5064,7 +7360,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         laser_ci.renderPass = vulkan_state.overlay_render_pass;
         laser_ci.pColorBlendState = &oit_blend_ci;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &laser_ci, 0, &vulkan_state.laser_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &laser_ci, &vulkan_state.laser_pipeline);
     }
 
     // define OIT resolve pipeline
@@ -5118,7 +7414,60 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         resolve_ci.renderPass = vulkan_state.overlay_render_pass;
         resolve_ci.subpass = 0;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &resolve_ci, 0, &vulkan_state.oit_resolve_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &resolve_ci, &vulkan_state.oit_resolve_pipeline);
+
+        // the weighted blended resolve is the same fullscreen triangle and premultiplied blend
+        VkGraphicsPipelineCreateInfo wboit_resolve_ci = resolve_ci;
+        wboit_resolve_ci.pStages = oit_wboit_resolve_stages;
+        wboit_resolve_ci.layout = vulkan_state.oit_wboit_resolve_pipeline_layout;
+
+        queueGraphicsPipeline(&pipeline_queue, &wboit_resolve_ci, &vulkan_state.oit_wboit_resolve_pipeline);
+    }
+
+    // define weighted blended OIT laser pipeline
+    {
+        resetPipelineStates(&color_blend_attachment_state, &depth_stencil_state_creation_info, &rasterization_state_creation_info);
+
+        // accumulation adds up, revealage multiplies by (1 - alpha)
+        VkPipelineColorBlendAttachmentState wboit_blend[2] = {0};
+        wboit_blend[0].blendEnable = VK_TRUE;
+        wboit_blend[0].srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+        wboit_blend[0].dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+        wboit_blend[0].colorBlendOp = VK_BLEND_OP_ADD;
+        wboit_blend[0].srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        wboit_blend[0].dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        wboit_blend[0].alphaBlendOp = VK_BLEND_OP_ADD;
+        wboit_blend[0].colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+        wboit_blend[1].blendEnable = VK_TRUE;
+        wboit_blend[1].srcColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+        wboit_blend[1].dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_COLOR;
+        wboit_blend[1].colorBlendOp = VK_BLEND_OP_ADD;
+        wboit_blend[1].srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+        wboit_blend[1].dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        wboit_blend[1].alphaBlendOp = VK_BLEND_OP_ADD;
+        wboit_blend[1].colorWriteMask = VK_COLOR_COMPONENT_R_BIT;
+
+        VkPipelineColorBlendStateCreateInfo wboit_blend_ci = {0};
+        wboit_blend_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        wboit_blend_ci.attachmentCount = 2;
+        wboit_blend_ci.pAttachments = wboit_blend;
+
+        // the scene depth does the rejection the linked list resolve does by hand
+        depth_stencil_state_creation_info.depthTestEnable = VK_TRUE;
+        depth_stencil_state_creation_info.depthWriteEnable = VK_FALSE;
+        depth_stencil_state_creation_info.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+
+        rasterization_state_creation_info.cullMode = VK_CULL_MODE_BACK_BIT;
+
+        VkGraphicsPipelineCreateInfo laser_wboit_ci = base_graphics_pipeline_creation_info;
+        laser_wboit_ci.pStages = laser_wboit_shader_stages;
+        laser_wboit_ci.pVertexInputState = &laser_vertex_input;
+        laser_wboit_ci.layout = vulkan_state.laser_wboit_pipeline_layout;
+        laser_wboit_ci.renderPass = vulkan_state.wboit_render_pass;
+        laser_wboit_ci.pColorBlendState = &wboit_blend_ci;
+
+        queueGraphicsPipeline(&pipeline_queue, &laser_wboit_ci, &vulkan_state.laser_wboit_pipeline);
     }
 
     // define sprite pipeline (overlay render pass)
@@ -5145,11 +7494,12 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
 
         VkGraphicsPipelineCreateInfo sprite_ci = base_graphics_pipeline_creation_info;
         sprite_ci.pStages = sprite_shader_stages;
+        sprite_ci.pVertexInputState = &sprite_vertex_input;
         sprite_ci.layout = vulkan_state.sprite_pipeline_layout;
         sprite_ci.renderPass = vulkan_state.overlay_render_pass;
         sprite_ci.pColorBlendState = &sprite_blend_ci;
 
-        vkCreateGraphicsPipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &sprite_ci, 0, &vulkan_state.sprite_pipeline);
+        queueGraphicsPipeline(&pipeline_queue, &sprite_ci, &vulkan_state.sprite_pipeline);
     }
 
     // define FFT spectrum compute pipeline
@@ -5159,7 +7509,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         pipeline_ci.stage = fft_spectrum_stage_ci;
         pipeline_ci.layout = vulkan_state.fft_spectrum_pipeline_layout;
 
-        vkCreateComputePipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &pipeline_ci, 0, &vulkan_state.fft_spectrum_pipeline);
+        queueComputePipeline(&pipeline_queue, &pipeline_ci, &vulkan_state.fft_spectrum_pipeline);
     }
 
     // define FFT evolved compute pipeline
@@ -5169,7 +7519,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         pipeline_ci.stage = fft_evolved_stage_ci;
         pipeline_ci.layout = vulkan_state.fft_evolved_pipeline_layout;
 
-        vkCreateComputePipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &pipeline_ci, 0, &vulkan_state.fft_evolved_pipeline);
+        queueComputePipeline(&pipeline_queue, &pipeline_ci, &vulkan_state.fft_evolved_pipeline);
     }
 
     // define FFT pass compute pipeline
@@ -5179,7 +7529,7 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         pipeline_ci.stage = fft_pass_stage_ci;
         pipeline_ci.layout = vulkan_state.fft_pass_pipeline_layout;
 
-        vkCreateComputePipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &pipeline_ci, 0, &vulkan_state.fft_pass_pipeline);
+        queueComputePipeline(&pipeline_queue, &pipeline_ci, &vulkan_state.fft_pass_pipeline);
     }
 
     // define FFT finalize compute pipeline
@@ -5189,26 +7539,167 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         pipeline_ci.stage = fft_finalize_stage_ci;
         pipeline_ci.layout = vulkan_state.fft_finalize_pipeline_layout;
         
-        vkCreateComputePipelines(vulkan_state.logical_device_handle, VK_NULL_HANDLE, 1, &pipeline_ci, 0, &vulkan_state.fft_finalize_pipeline);
+        queueComputePipeline(&pipeline_queue, &pipeline_ci, &vulkan_state.fft_finalize_pipeline);
+    }
+
+    // define FFT rows compute pipeline
+    {
+        VkComputePipelineCreateInfo pipeline_ci = {0};
+        pipeline_ci.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipeline_ci.stage = fft_rows_stage_ci;
+        pipeline_ci.layout = vulkan_state.fft_rows_pipeline_layout;
+
+        queueComputePipeline(&pipeline_queue, &pipeline_ci, &vulkan_state.fft_rows_pipeline);
+    }
+
+    // define FFT columns compute pipeline
+    {
+        VkComputePipelineCreateInfo pipeline_ci = {0};
+        pipeline_ci.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipeline_ci.stage = fft_columns_stage_ci;
+        pipeline_ci.layout = vulkan_state.fft_columns_pipeline_layout;
+
+        queueComputePipeline(&pipeline_queue, &pipeline_ci, &vulkan_state.fft_columns_pipeline);
+    }
+
+    // define cull compute pipeline
+    {
+        VkComputePipelineCreateInfo pipeline_ci = {0};
+        pipeline_ci.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipeline_ci.stage = cull_stage_ci;
+        pipeline_ci.layout = vulkan_state.cull_pipeline_layout;
+
+        queueComputePipeline(&pipeline_queue, &pipeline_ci, &vulkan_state.cull_pipeline);
     }
 
+    // compiles on the workers while the buffers and models below are set up. the water bake further down is the first
+    // thing to use a pipeline
+    LARGE_INTEGER pipelines_start;
+    QueryPerformanceCounter(&pipelines_start);
+    startQueuedPipelines(&pipeline_queue);
+
     for (int in_flight_index = 0; in_flight_index < 2; in_flight_index++)
     {
         createInstanceBuffer(&vulkan_state.cube_instance_buffers[in_flight_index], 
             sizeof(CubeInstanceData) * CUBE_INSTANCE_CAPACITY, 
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, // also read by the cull pass
             &vulkan_state.cube_instance_memories[in_flight_index], 
             &vulkan_state.cube_instance_mappeds[in_flight_index]);
         createInstanceBuffer(&vulkan_state.water_instance_buffers[in_flight_index], 
             sizeof(WaterInstanceData) * WATER_INSTANCE_CAPACITY, 
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
             &vulkan_state.water_instance_memories[in_flight_index], 
             &vulkan_state.water_instance_mappeds[in_flight_index]);
         createInstanceBuffer(&vulkan_state.laser_instance_buffers[in_flight_index],
             sizeof(LaserInstanceData) * LASER_INSTANCE_CAPACITY,
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
             &vulkan_state.laser_instance_memories[in_flight_index],
             &vulkan_state.laser_instance_mappeds[in_flight_index]);
+        createInstanceBuffer(&vulkan_state.sprite_instance_buffers[in_flight_index],
+            sizeof(SpriteInstanceData) * SPRITE_INSTANCE_CAPACITY,
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            &vulkan_state.sprite_instance_memories[in_flight_index],
+            &vulkan_state.sprite_instance_mappeds[in_flight_index]);
+    }
+
+    // model instances and their indirect draws
+    for (int in_flight_index = 0; in_flight_index < 2; in_flight_index++)
+    {
+        createInstanceBuffer(&vulkan_state.model_instance_buffers[in_flight_index],
+            sizeof(ModelInstanceData) * MODEL_INSTANCE_CAPACITY,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            &vulkan_state.model_instance_memories[in_flight_index],
+            &vulkan_state.model_instance_mappeds[in_flight_index]);
+        createInstanceBuffer(&vulkan_state.model_draw_buffers[in_flight_index],
+            sizeof(VkDrawIndexedIndirectCommand) * 64,
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            &vulkan_state.model_draw_memories[in_flight_index],
+            &vulkan_state.model_draw_mappeds[in_flight_index]);
+
+        VkDescriptorSetAllocateInfo descriptor_set_alloc = {0};
+        descriptor_set_alloc.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        descriptor_set_alloc.descriptorPool = vulkan_state.descriptor_pool;
+        descriptor_set_alloc.descriptorSetCount = 1;
+        descriptor_set_alloc.pSetLayouts = &vulkan_state.ssbo_descriptor_set_layout;
+        vkAllocateDescriptorSets(vulkan_state.logical_device_handle, &descriptor_set_alloc, &vulkan_state.model_instance_descriptor_sets[in_flight_index]);
+
+        VkDescriptorBufferInfo buffer_info = {0};
+        buffer_info.buffer = vulkan_state.model_instance_buffers[in_flight_index];
+        buffer_info.offset = 0;
+        buffer_info.range  = VK_WHOLE_SIZE;
+
+        VkWriteDescriptorSet descriptor_write = {0};
+        descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptor_write.dstSet = vulkan_state.model_instance_descriptor_sets[in_flight_index];
+        descriptor_write.dstBinding = 0;
+        descriptor_write.descriptorCount = 1;
+        descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptor_write.pBufferInfo = &buffer_info;
+        vkUpdateDescriptorSets(vulkan_state.logical_device_handle, 1, &descriptor_write, 0, 0);
+    }
+
+    // cull pass buffers
+    for (int in_flight_index = 0; in_flight_index < 2; in_flight_index++)
+    {
+        createInstanceBuffer(&vulkan_state.cull_chunk_buffers[in_flight_index],
+            sizeof(StaticMeshChunk) * MAX_STATIC_MESH_CHUNKS,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            &vulkan_state.cull_chunk_memories[in_flight_index],
+            &vulkan_state.cull_chunk_mappeds[in_flight_index]);
+        createDeviceLocalBuffer(sizeof(VkDrawIndexedIndirectCommand) * MAX_STATIC_MESH_CHUNKS * CULL_VIEW_COUNT,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            &vulkan_state.cull_static_draw_buffers[in_flight_index],
+            &vulkan_state.cull_static_draw_memories[in_flight_index]);
+        createDeviceLocalBuffer(sizeof(CubeInstanceData) * CUBE_INSTANCE_CAPACITY * CULL_VIEW_COUNT,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            &vulkan_state.cull_cube_instance_buffers[in_flight_index],
+            &vulkan_state.cull_cube_instance_memories[in_flight_index]);
+        createDeviceLocalBuffer(sizeof(CullViewCounts) * CULL_VIEW_COUNT,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            &vulkan_state.cull_count_buffers[in_flight_index],
+            &vulkan_state.cull_count_memories[in_flight_index]);
+
+        VkDescriptorSetAllocateInfo descriptor_set_alloc = {0};
+        descriptor_set_alloc.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        descriptor_set_alloc.descriptorPool = vulkan_state.descriptor_pool;
+        descriptor_set_alloc.descriptorSetCount = 1;
+        descriptor_set_alloc.pSetLayouts = &vulkan_state.cull_descriptor_set_layout;
+        vkAllocateDescriptorSets(vulkan_state.logical_device_handle, &descriptor_set_alloc, &vulkan_state.cull_descriptor_sets[in_flight_index]);
+
+        VkBuffer cull_buffers[5] =
+        {
+            vulkan_state.cull_chunk_buffers[in_flight_index],
+            vulkan_state.cube_instance_buffers[in_flight_index],
+            vulkan_state.cull_static_draw_buffers[in_flight_index],
+            vulkan_state.cull_cube_instance_buffers[in_flight_index],
+            vulkan_state.cull_count_buffers[in_flight_index],
+        };
+        VkDescriptorBufferInfo buffer_infos[5] = {0};
+        VkWriteDescriptorSet descriptor_writes[5] = {0};
+        for (uint32 binding_index = 0; binding_index < 5; binding_index++)
+        {
+            buffer_infos[binding_index].buffer = cull_buffers[binding_index];
+            buffer_infos[binding_index].offset = 0;
+            buffer_infos[binding_index].range  = VK_WHOLE_SIZE;
+
+            descriptor_writes[binding_index].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptor_writes[binding_index].dstSet = vulkan_state.cull_descriptor_sets[in_flight_index];
+            descriptor_writes[binding_index].dstBinding = binding_index;
+            descriptor_writes[binding_index].descriptorCount = 1;
+            descriptor_writes[binding_index].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            descriptor_writes[binding_index].pBufferInfo = &buffer_infos[binding_index];
+        }
+        vkUpdateDescriptorSets(vulkan_state.logical_device_handle, 5, descriptor_writes, 0, 0);
     }
 
+    LARGE_INTEGER models_start, models_end;
+    QueryPerformanceCounter(&models_start);
     loadAllEntities();
+    QueryPerformanceCounter(&models_end);
+
+    jobsWait(&pipeline_queue.counter);
+    LARGE_INTEGER pipelines_end = queuedPipelinesFinishedAt(&pipeline_queue, pipelines_start);
+    savePipelineCache();
 
     // PAINT TEXTURE RESOURCES
 
@@ -5345,14 +7836,15 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         cb_begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
         vkBeginCommandBuffer(command_buffer, &cb_begin);
 
-        VkImage images_to_transition[4] =
+        VkImage images_to_transition[5] =
         {
             vulkan_state.h0_image,
             vulkan_state.fft_buffer_a_image,
             vulkan_state.fft_buffer_b_image,
             vulkan_state.displacement_image,
+            vulkan_state.fft_rows_image,
         };
-        for (int image_index = 0; image_index < 4; image_index++)
+        for (int image_index = 0; image_index < 5; image_index++)
         {
             imageBarrier(command_buffer, images_to_transition[image_index],
                 VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
@@ -5361,6 +7853,23 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
                 VK_IMAGE_ASPECT_COLOR_BIT);
         }
 
+        // water history stays in general, it is copied into and sampled
+        {
+            VkImageMemoryBarrier history_barrier = {0};
+            history_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            history_barrier.image = vulkan_state.water_history_image;
+            history_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            history_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            history_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            history_barrier.subresourceRange.levelCount = 1;
+            history_barrier.subresourceRange.layerCount = 2;
+            history_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            history_barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            history_barrier.srcAccessMask = 0;
+            history_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, 0, 0, 0, 1, &history_barrier);
+        }
+
         vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_spectrum_pipeline);
         vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_spectrum_pipeline_layout, 0, 1, &vulkan_state.h0_descriptor_set, 0, 0);
 
@@ -5380,6 +7889,59 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
         vkCmdPushConstants(command_buffer, vulkan_state.fft_spectrum_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FFTSpectrumPushConstants), &pc);
         vkCmdDispatch(command_buffer, FFT_SIZE / 16, FFT_SIZE / 16, 1);
 
+        // bake one loop of the water, frame by frame through the displacement image
+        {
+            memoryBarrier(command_buffer,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+            // full range barrier, same as loadDdsArray
+            VkImageMemoryBarrier loop_barrier = {0};
+            loop_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            loop_barrier.image = vulkan_state.water_loop_image;
+            loop_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            loop_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            loop_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            loop_barrier.subresourceRange.levelCount = 1;
+            loop_barrier.subresourceRange.layerCount = WATER_LOOP_FRAME_COUNT;
+
+            loop_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            loop_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            loop_barrier.srcAccessMask = 0;
+            loop_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, 0, 0, 0, 1, &loop_barrier);
+
+            for (int32 frame_index = 0; frame_index < WATER_LOOP_FRAME_COUNT; frame_index++)
+            {
+                recordWaterFft(command_buffer, water_loop_period * (float)frame_index / (float)WATER_LOOP_FRAME_COUNT, water_loop_period);
+
+                memoryBarrier(command_buffer,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+                VkImageCopy frame_copy = {0};
+                frame_copy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                frame_copy.srcSubresource.layerCount = 1;
+                frame_copy.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                frame_copy.dstSubresource.baseArrayLayer = (uint32)frame_index;
+                frame_copy.dstSubresource.layerCount = 1;
+                frame_copy.extent = (VkExtent3D){ FFT_SIZE, FFT_SIZE, 1 };
+
+                vkCmdCopyImage(command_buffer, vulkan_state.displacement_image, VK_IMAGE_LAYOUT_GENERAL, vulkan_state.water_loop_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &frame_copy);
+
+                // next frame overwrites the displacement image
+                memoryBarrier(command_buffer,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    0, VK_ACCESS_SHADER_WRITE_BIT);
+            }
+
+            loop_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            loop_barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            loop_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            loop_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, 0, 0, 0, 1, &loop_barrier);
+        }
+
         vkEndCommandBuffer(command_buffer);
 
         VkSubmitInfo submit = {0};
@@ -5394,6 +7956,279 @@ void vulkanInitialize(RendererPlatformHandles platform_handles, DisplayInfo disp
     }
 
     vulkan_state.paint_image_first_upload = true;
+
+    LARGE_INTEGER startup_end;
+    QueryPerformanceCounter(&startup_end);
+    double ms_per_tick = 1000.0 / ticks_per_second.QuadPart;
+    char output[256];
+    snprintf(output, sizeof(output), "startup (%s pipeline cache, %d threads): total %.1f ms, pipelines %.1f ms (%d, alongside models), models %.1f ms, textures %.1f ms\n",
+             vulkan_state.pipeline_cache_warm ? "warm" : "cold", jobsThreadCount(),
+             (startup_end.QuadPart - startup_start.QuadPart) * ms_per_tick,
+             (pipelines_end.QuadPart - pipelines_start.QuadPart) * ms_per_tick, pipeline_queue.graphics_count + pipeline_queue.compute_count,
+             (models_end.QuadPart - models_start.QuadPart) * ms_per_tick,
+             (textures_end.QuadPart - textures_start.QuadPart) * ms_per_tick);
+    OutputDebugStringA(output);
+}
+
+// STATIC LEVEL MESH
+
+// static tiles are unit cubes on the integer grid, so rather than drawing one 36-index cube each, the level is meshed once: faces that
+// touch another static tile are dropped, and runs of identical faces in the same plane are merged into one quad. the mesh goes through
+// the cube pipelines with a single identity instance. vertex color carries the atlas origin of each face (b = 1 marks a mesh vertex),
+// and uvs count in tiles, so the fragment shader can repeat the face texture across a merged quad.
+
+// one face of CUBE_VERTICES, after rotating the cube
+typedef struct
+{
+    Vec3 offsets[4]; // corners relative to the tile center. each component is +-0.5
+    Vec2 local_uvs[4]; // 0..1 within the face
+    Vec2 atlas_offset; // where the face sits inside the atlas cell, as a fraction of the cell
+}
+StaticMeshFace;
+
+float* vec3Axis(Vec3* v, int32 axis)
+{
+    return &((float*)v)[axis];
+}
+
+Vec3 rotateByMatrix(float m[16], Vec3 v)
+{
+    return (Vec3){ m[0]*v.x + m[4]*v.y + m[8]*v.z, m[1]*v.x + m[5]*v.y + m[9]*v.z, m[2]*v.x + m[6]*v.y + m[10]*v.z };
+}
+
+// finds which face of a cube with this rotation ends up pointing along normal_sign * normal_axis
+bool getStaticMeshFace(Vec4 rotation, int32 normal_axis, int32 normal_sign, StaticMeshFace* out)
+{
+    float rotation_matrix[16];
+    mat4BuildRotation(rotation_matrix, rotation);
+
+    for (int32 face_index = 0; face_index < 6; face_index++)
+    {
+        const Vertex* face_vertices = &CUBE_VERTICES[4 * face_index];
+        Vec3 normal = rotateByMatrix(rotation_matrix, (Vec3){ face_vertices[0].nx, face_vertices[0].ny, face_vertices[0].nz });
+        if (roundf(*vec3Axis(&normal, normal_axis)) != (float)normal_sign) continue;
+
+        float min_u = 1.0f, min_v = 1.0f;
+        for (int32 corner = 0; corner < 4; corner++)
+        {
+            if (face_vertices[corner].u < min_u) min_u = face_vertices[corner].u;
+            if (face_vertices[corner].v < min_v) min_v = face_vertices[corner].v;
+        }
+        for (int32 corner = 0; corner < 4; corner++)
+        {
+            Vec3 offset = rotateByMatrix(rotation_matrix, (Vec3){ face_vertices[corner].x, face_vertices[corner].y, face_vertices[corner].z });
+            out->offsets[corner] = (Vec3){ roundf(offset.x * 2.0f) * 0.5f, roundf(offset.y * 2.0f) * 0.5f, roundf(offset.z * 2.0f) * 0.5f };
+            out->local_uvs[corner] = (Vec2){ roundf((face_vertices[corner].u - min_u) * 3.0f), roundf((face_vertices[corner].v - min_v) * 2.0f) };
+        }
+        out->atlas_offset = (Vec2){ min_u, min_v };
+        return true;
+    }
+    return false;
+}
+
+bool staticFacesMatch(DrawCommand* a, DrawCommand* b)
+{
+    return a->sprite_id == b->sprite_id && memcmp(&a->rotation, &b->rotation, sizeof(Vec4)) == 0;
+}
+
+// assumes every static command is an integer-positioned CUBE_3D at unit scale, which is all the game emits for static tiles
+void buildStaticLevelMesh(DrawCommand* static_commands, int32 static_command_count)
+{
+    vkDeviceWaitIdle(vulkan_state.logical_device_handle); // nothing in flight may reference the old buffers
+
+    if (vulkan_state.static_mesh_vertex_buffer) vkDestroyBuffer(vulkan_state.logical_device_handle, vulkan_state.static_mesh_vertex_buffer, 0);
+    if (vulkan_state.static_mesh_vertex_memory) vkFreeMemory(vulkan_state.logical_device_handle, vulkan_state.static_mesh_vertex_memory, 0);
+    if (vulkan_state.static_mesh_index_buffer)  vkDestroyBuffer(vulkan_state.logical_device_handle, vulkan_state.static_mesh_index_buffer, 0);
+    if (vulkan_state.static_mesh_index_memory)  vkFreeMemory(vulkan_state.logical_device_handle, vulkan_state.static_mesh_index_memory, 0);
+    vulkan_state.static_mesh_vertex_buffer = VK_NULL_HANDLE;
+    vulkan_state.static_mesh_vertex_memory = VK_NULL_HANDLE;
+    vulkan_state.static_mesh_index_buffer = VK_NULL_HANDLE;
+    vulkan_state.static_mesh_index_memory = VK_NULL_HANDLE;
+    vulkan_state.static_mesh_index_count = 0;
+    vulkan_state.static_mesh_chunk_count = 0;
+    vulkan_state.static_mesh_origin = vulkan_state.level_aabb_min;
+    vulkan_state.shadow_static_valid = false; // the cached static depth was drawn from the old buffers
+
+    if (static_command_count == 0) return;
+
+    // size of one cell in atlas uv space. all cube cells are the same size
+    Vec4 first_cell = sprite_uv_table[static_commands[0].sprite_id];
+    float cell_width = first_cell.z - first_cell.x;
+    float cell_height = first_cell.w - first_cell.y;
+    if (!vulkan_state.static_mesh_instance_buffer)
+    {
+        CubeInstanceData identity_instance = packCubeInstance((Vec3){0}, (Vec3){0}, (Vec4){ 0, 0, 0, 1 }, 0);
+        uploadBufferToLocalDevice(&identity_instance, sizeof(identity_instance), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, &vulkan_state.static_mesh_instance_buffer, &vulkan_state.static_mesh_instance_memory);
+    }
+
+    // occupancy grid over the bounds of the static tiles, holding command indices
+    int32 grid_min[3] = { INT32_MAX, INT32_MAX, INT32_MAX };
+    int32 grid_max[3] = { INT32_MIN, INT32_MIN, INT32_MIN };
+    for (int32 command_index = 0; command_index < static_command_count; command_index++)
+    {
+        for (int32 axis = 0; axis < 3; axis++)
+        {
+            int32 c = (int32)roundf(*vec3Axis(&static_commands[command_index].coords, axis));
+            if (c < grid_min[axis]) grid_min[axis] = c;
+            if (c > grid_max[axis]) grid_max[axis] = c;
+        }
+    }
+    int32 grid_dim[3] = { grid_max[0] - grid_min[0] + 1, grid_max[1] - grid_min[1] + 1, grid_max[2] - grid_min[2] + 1 };
+    int32 grid_size = grid_dim[0] * grid_dim[1] * grid_dim[2];
+
+    int32* grid = malloc(sizeof(int32) * grid_size);
+    int32* mask = malloc(sizeof(int32) * grid_size); // one slice at a time; a slice is never bigger than the grid
+    for (int32 cell_index = 0; cell_index < grid_size; cell_index++) grid[cell_index] = -1;
+    for (int32 command_index = 0; command_index < static_command_count; command_index++)
+    {
+        int32 cell[3];
+        for (int32 axis = 0; axis < 3; axis++) cell[axis] = (int32)roundf(*vec3Axis(&static_commands[command_index].coords, axis)) - grid_min[axis];
+        grid[(cell[1] * grid_dim[2] + cell[2]) * grid_dim[0] + cell[0]] = command_index;
+    }
+
+    int32 max_quad_count = 6 * static_command_count;
+    Vertex* vertices = malloc(sizeof(Vertex) * 4 * max_quad_count);
+    uint32* indices = malloc(sizeof(uint32) * 6 * max_quad_count);
+    int32 quad_count = 0;
+
+    // the mesh is cut into columns so the cull pass can drop whole columns per view. faces only merge within a column,
+    // but hidden face removal still looks at the whole grid
+    int32 chunk_size = STATIC_MESH_CHUNK_SIZE;
+    while (((grid_dim[0] + chunk_size - 1) / chunk_size) * ((grid_dim[2] + chunk_size - 1) / chunk_size) > MAX_STATIC_MESH_CHUNKS) chunk_size *= 2;
+    vulkan_state.static_mesh_chunk_count = 0;
+
+    for (int32 chunk_z = 0; chunk_z < grid_dim[2]; chunk_z += chunk_size) for (int32 chunk_x = 0; chunk_x < grid_dim[0]; chunk_x += chunk_size)
+    {
+        int32 lo[3] = { chunk_x, 0, chunk_z };
+        int32 hi[3] = { chunk_x + chunk_size, grid_dim[1], chunk_z + chunk_size };
+        if (hi[0] > grid_dim[0]) hi[0] = grid_dim[0];
+        if (hi[2] > grid_dim[2]) hi[2] = grid_dim[2];
+        int32 chunk_first_quad = quad_count;
+
+        for (int32 normal_axis = 0; normal_axis < 3; normal_axis++) for (int32 normal_sign = -1; normal_sign <= 1; normal_sign += 2)
+        {
+            int32 axis_a = (normal_axis + 1) % 3;
+            int32 axis_b = (normal_axis + 2) % 3;
+            int32 span_a = hi[axis_a] - lo[axis_a];
+
+            for (int32 slice = lo[normal_axis]; slice < hi[normal_axis]; slice++)
+            {
+                // visible faces in this slice: a static tile with no static tile in front of it
+                for (int32 b = lo[axis_b]; b < hi[axis_b]; b++) for (int32 a = lo[axis_a]; a < hi[axis_a]; a++)
+                {
+                    int32 cell[3];
+                    cell[normal_axis] = slice;
+                    cell[axis_a] = a;
+                    cell[axis_b] = b;
+                    int32 command_index = grid[(cell[1] * grid_dim[2] + cell[2]) * grid_dim[0] + cell[0]];
+
+                    cell[normal_axis] += normal_sign;
+                    bool covered = cell[normal_axis] >= 0 && cell[normal_axis] < grid_dim[normal_axis] && grid[(cell[1] * grid_dim[2] + cell[2]) * grid_dim[0] + cell[0]] >= 0;
+
+                    mask[(b - lo[axis_b]) * span_a + (a - lo[axis_a])] = covered ? -1 : command_index;
+                }
+
+                // greedy merge: grow each face along a as far as it matches, then along b while the whole row matches
+                for (int32 b = 0; b < hi[axis_b] - lo[axis_b]; b++) for (int32 a = 0; a < span_a; a++)
+                {
+                    int32 command_index = mask[b * span_a + a];
+                    if (command_index < 0) continue;
+                    DrawCommand* command = &static_commands[command_index];
+
+                    int32 width = 1;
+                    while (a + width < span_a)
+                    {
+                        int32 next = mask[b * span_a + a + width];
+                        if (next < 0 || !staticFacesMatch(&static_commands[next], command)) break;
+                        width++;
+                    }
+                    int32 height = 1;
+                    while (b + height < hi[axis_b] - lo[axis_b])
+                    {
+                        bool row_matches = true;
+                        for (int32 k = 0; k < width && row_matches; k++)
+                        {
+                            int32 next = mask[(b + height) * span_a + a + k];
+                            if (next < 0 || !staticFacesMatch(&static_commands[next], command)) row_matches = false;
+                        }
+                        if (!row_matches) break;
+                        height++;
+                    }
+                    for (int32 clear_b = b; clear_b < b + height; clear_b++) for (int32 clear_a = a; clear_a < a + width; clear_a++) mask[clear_b * span_a + clear_a] = -1;
+
+                    StaticMeshFace face;
+                    if (!getStaticMeshFace(command->rotation, normal_axis, normal_sign, &face)) continue;
+
+                    // local uv as a function of position along a and b, taken from the single-tile face
+                    Vec2 uv_origin = {0}, uv_step_a = {0}, uv_step_b = {0};
+                    for (int32 corner = 0; corner < 4; corner++)
+                    {
+                        bool far_a = *vec3Axis(&face.offsets[corner], axis_a) > 0.0f;
+                        bool far_b = *vec3Axis(&face.offsets[corner], axis_b) > 0.0f;
+                        if (!far_a && !far_b) uv_origin = face.local_uvs[corner];
+                        if ( far_a && !far_b) uv_step_a = face.local_uvs[corner];
+                        if (!far_a &&  far_b) uv_step_b = face.local_uvs[corner];
+                    }
+                    uv_step_a = (Vec2){ uv_step_a.x - uv_origin.x, uv_step_a.y - uv_origin.y };
+                    uv_step_b = (Vec2){ uv_step_b.x - uv_origin.x, uv_step_b.y - uv_origin.y };
+
+                    Vec4 cell_uv = sprite_uv_table[command->sprite_id];
+                    float atlas_u = cell_uv.x + face.atlas_offset.x * cell_width;
+                    float atlas_v = cell_uv.y + face.atlas_offset.y * cell_height;
+
+                    Vec3 start_center = command->coords; // tile at (a, b) is the one this command belongs to
+                    uint32 first_vertex = (uint32)quad_count * 4;
+                    for (int32 corner = 0; corner < 4; corner++)
+                    {
+                        // corners keep CUBE_VERTICES' order, so winding is unchanged; the far ones just move to the far end of the run
+                        Vec3 position = { start_center.x + face.offsets[corner].x, start_center.y + face.offsets[corner].y, start_center.z + face.offsets[corner].z };
+                        float far_a = *vec3Axis(&face.offsets[corner], axis_a) > 0.0f ? 1.0f : 0.0f;
+                        float far_b = *vec3Axis(&face.offsets[corner], axis_b) > 0.0f ? 1.0f : 0.0f;
+                        *vec3Axis(&position, axis_a) += far_a * (float)(width - 1);
+                        *vec3Axis(&position, axis_b) += far_b * (float)(height - 1);
+
+                        Vertex* vertex = &vertices[first_vertex + corner];
+                        vertex->x = position.x - vulkan_state.static_mesh_origin.x;
+                        vertex->y = position.y - vulkan_state.static_mesh_origin.y;
+                        vertex->z = position.z - vulkan_state.static_mesh_origin.z;
+                        vertex->u = uv_origin.x + far_a * (float)width * uv_step_a.x + far_b * (float)height * uv_step_b.x;
+                        vertex->v = uv_origin.y + far_a * (float)width * uv_step_a.y + far_b * (float)height * uv_step_b.y;
+                        vertex->nx = normal_axis == 0 ? (float)normal_sign : 0.0f;
+                        vertex->ny = normal_axis == 1 ? (float)normal_sign : 0.0f;
+                        vertex->nz = normal_axis == 2 ? (float)normal_sign : 0.0f;
+                        vertex->r = atlas_u;
+                        vertex->g = atlas_v;
+                        vertex->b = 1.0f;
+                    }
+                    uint32* quad_indices = &indices[quad_count * 6];
+                    quad_indices[0] = first_vertex + 0; quad_indices[1] = first_vertex + 1; quad_indices[2] = first_vertex + 2;
+                    quad_indices[3] = first_vertex + 0; quad_indices[4] = first_vertex + 2; quad_indices[5] = first_vertex + 3;
+                    quad_count++;
+                }
+            }
+        }
+
+        if (quad_count == chunk_first_quad) continue;
+
+        // bounds of the column in world space. tiles are unit cubes centered on integer coordinates
+        StaticMeshChunk* chunk = &vulkan_state.static_mesh_chunks[vulkan_state.static_mesh_chunk_count++];
+        chunk->aabb_min = (Vec4){ (float)(grid_min[0] + lo[0]) - 0.5f, (float)(grid_min[1] + lo[1]) - 0.5f, (float)(grid_min[2] + lo[2]) - 0.5f, 0.0f };
+        chunk->aabb_max = (Vec4){ (float)(grid_min[0] + hi[0]) - 0.5f, (float)(grid_min[1] + hi[1]) - 0.5f, (float)(grid_min[2] + hi[2]) - 0.5f, 0.0f };
+        chunk->first_index = (uint32)chunk_first_quad * 6;
+        chunk->index_count = (uint32)(quad_count - chunk_first_quad) * 6;
+    }
+
+    if (quad_count > 0)
+    {
+        uploadBufferToLocalDevice(vertices, sizeof(Vertex) * 4 * quad_count, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, &vulkan_state.static_mesh_vertex_buffer, &vulkan_state.static_mesh_vertex_memory);
+        uploadBufferToLocalDevice(indices, sizeof(uint32) * 6 * quad_count, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, &vulkan_state.static_mesh_index_buffer, &vulkan_state.static_mesh_index_memory);
+        vulkan_state.static_mesh_index_count = (uint32)quad_count * 6;
+    }
+
+    free(grid);
+    free(mask);
+    free(vertices);
+    free(indices);
 }
 
 void vulkanSubmitFrame(DrawCommand* draw_commands, int32 draw_command_count, RendererInfo vulkan_info)
@@ -5406,7 +8241,14 @@ void vulkanSubmitFrame(DrawCommand* draw_commands, int32 draw_command_count, Ren
     vulkan_state.level_aabb_max = vulkan_info.level_aabb_max;
     vulkan_state.time = vulkan_info.time;
     vulkan_state.water_plane_y = vulkan_info.water_plane_y;
+    if (vulkan_state.shader_mode != vulkan_info.shader_mode || vulkan_state.water_mode != vulkan_info.water_mode)
+    {
+        // averages from one mode say nothing about the other
+        memset(vulkan_state.region_time_total_ms, 0, sizeof(vulkan_state.region_time_total_ms));
+        vulkan_state.region_time_frame_count = 0;
+    }
     vulkan_state.shader_mode = vulkan_info.shader_mode;
+    vulkan_state.water_mode = vulkan_info.water_mode;
     vulkan_state.water_paint_texture = vulkan_info.water_paint_texture;
     vulkan_state.sun_direction = vulkan_info.sun_direction;
 
@@ -5417,7 +8259,16 @@ void vulkanSubmitFrame(DrawCommand* draw_commands, int32 draw_command_count, Ren
     model_editor_outline_instance_count = 0;
     water_instance_count = 0;
 
-    for (int asset_index = 0; asset_index < draw_command_count; asset_index++)
+    // static tile cubes lead the draw list. they are drawn from the level mesh, which only needs rebuilding when they
+    // change, or when the level origin its vertices are relative to moves
+    if (vulkan_info.static_draw_version != vulkan_state.static_mesh_version
+        || memcmp(&vulkan_state.static_mesh_origin, &vulkan_state.level_aabb_min, sizeof(Vec3)) != 0)
+    {
+        buildStaticLevelMesh(draw_commands, vulkan_info.static_draw_command_count);
+        vulkan_state.static_mesh_version = vulkan_info.static_draw_version;
+    }
+
+    for (int asset_index = vulkan_info.static_draw_command_count; asset_index < draw_command_count; asset_index++)
     {
         DrawCommand* command = &draw_commands[asset_index];
         SpriteId sprite_id = command->sprite_id;
@@ -5425,14 +8276,11 @@ void vulkanSubmitFrame(DrawCommand* draw_commands, int32 draw_command_count, Ren
 
         if (type == CUBE_3D)
         {
-            Vec4 uv_rect = spriteUV(sprite_id, type, ATLAS_3D_WIDTH, ATLAS_3D_HEIGHT);
-
             Cube* cube = &cube_instances[cube_instance_count++];
             cube->asset_index = (uint32)vulkan_state.atlas_3d_asset_index;
             cube->coords      = command->coords;
-            cube->scale       = command->scale;
             cube->rotation    = command->rotation;
-            cube->uv          = uv_rect;
+            cube->atlas_cell  = (uint16)spriteIndexInAtlas(sprite_id, type);
         }
         else if (type == MODEL_3D)
         {
@@ -5469,29 +8317,16 @@ void vulkanSubmitFrame(DrawCommand* draw_commands, int32 draw_command_count, Ren
         }
         else if (type == SPRITE_2D)
         {
-            int32 atlas_asset_index;
-            int32 atlas_width;
-            int32 atlas_height;
+            if (sprite_instance_count == SPRITE_INSTANCE_CAPACITY - 1) continue; // full, so drop the rest
 
-            if (spriteIsFont(sprite_id))
-            {
-                atlas_asset_index = vulkan_state.atlas_font_asset_index;
-                atlas_width  = ATLAS_FONT_WIDTH;
-                atlas_height = ATLAS_FONT_HEIGHT;
-            }
-            else
-            {
-                atlas_asset_index = vulkan_state.atlas_2d_asset_index;
-                atlas_width  = ATLAS_2D_WIDTH;
-                atlas_height = ATLAS_2D_HEIGHT;
-            }
+            int32 atlas_asset_index = spriteIsFont(sprite_id) ? vulkan_state.atlas_font_asset_index : vulkan_state.atlas_2d_asset_index;
 
             Sprite* sprite = &sprite_instances[sprite_instance_count++];
             sprite->asset_index = (uint32)atlas_asset_index;
             sprite->coords      = command->coords;
             sprite->size        = command->scale;
             sprite->alpha       = command->color.w;
-            sprite->uv          = spriteUV(sprite_id, type, atlas_width, atlas_height);
+            sprite->uv          = sprite_uv_table[sprite_id];
         }
     }
 
@@ -5500,18 +8335,69 @@ void vulkanSubmitFrame(DrawCommand* draw_commands, int32 draw_command_count, Ren
     for (uint32 instance_index = 0; instance_index < cube_instance_count; instance_index++)
     {
         Cube* cube = &cube_instances[instance_index];
-        //mat4BuildBasicTRS(cube_gpu_instances[instance_index].model, cube->coords); // assumption that all cubes aren't rotated and are at unit scale
-        mat4BuildTRS(cube_gpu_instances[instance_index].model, cube->coords, cube->rotation, cube->scale);
-        cube_gpu_instances[instance_index].uv_rect = cube->uv;
+        cube_gpu_instances[instance_index] = packCubeInstance(cube->coords, vulkan_state.level_aabb_min, cube->rotation, cube->atlas_cell);
     }
 
+    // fill model instance buffer, grouped by model so each model in use is one indirect draw
+    {
+        ModelInstanceData* model_gpu_instances = (ModelInstanceData*)vulkan_state.model_instance_mappeds[vulkan_state.current_frame];
+        VkDrawIndexedIndirectCommand* model_draws = (VkDrawIndexedIndirectCommand*)vulkan_state.model_draw_mappeds[vulkan_state.current_frame];
+
+        uint32 instances_per_model[64] = {0};
+        for (uint32 model_instance_index = 0; model_instance_index < model_instance_count; model_instance_index++)
+        {
+            int32 slot = (int32)model_instances[model_instance_index].model_id - MODEL_3D_VOID;
+            if (vulkan_state.model_mesh_infos[slot].index_count == 0) continue;
+            instances_per_model[slot]++;
+        }
+
+        uint32 next_instance[64] = {0};
+        uint32 first_instance = 0;
+        model_draw_count = 0;
+        for (int32 slot = 0; slot < 64; slot++)
+        {
+            if (instances_per_model[slot] == 0) continue;
+            ModelMeshInfo* info = &vulkan_state.model_mesh_infos[slot];
+
+            VkDrawIndexedIndirectCommand* draw = &model_draw_commands[model_draw_count++];
+            draw->indexCount    = info->index_count;
+            draw->instanceCount = instances_per_model[slot];
+            draw->firstIndex    = info->index_offset;
+            draw->vertexOffset  = (int32)info->vertex_offset;
+            draw->firstInstance = first_instance;
+
+            next_instance[slot] = first_instance;
+            first_instance += instances_per_model[slot];
+        }
+        memcpy(model_draws, model_draw_commands, sizeof(VkDrawIndexedIndirectCommand) * model_draw_count);
+
+        for (uint32 model_instance_index = 0; model_instance_index < model_instance_count; model_instance_index++)
+        {
+            Model* model = &model_instances[model_instance_index];
+            int32 slot = (int32)model->model_id - MODEL_3D_VOID;
+            if (vulkan_state.model_mesh_infos[slot].index_count == 0) continue;
+
+            // lanes are laid out in draw order so the batch writes straight to each instance's slot
+            uint32 destination = next_instance[slot]++;
+            setTransformLane(&transform_lanes, (int32)destination, model->coords, model->rotation, model->scale);
+            model_gpu_instances[destination].color = model->color;
+        }
+        transform_lanes.count = (int32)first_instance;
+        buildTransformLanes(&transform_lanes, model_gpu_instances[0].model, sizeof(ModelInstanceData));
+    }
+
+    // chunk bounds for the cull pass
+    memcpy(vulkan_state.cull_chunk_mappeds[vulkan_state.current_frame], vulkan_state.static_mesh_chunks, sizeof(StaticMeshChunk) * vulkan_state.static_mesh_chunk_count);
+
     // fill water instance buffer
     WaterInstanceData* water_gpu_instances = (WaterInstanceData*)vulkan_state.water_instance_mappeds[vulkan_state.current_frame];
+    transform_lanes.count = (int32)water_instance_count;
     for (uint32 instance_index = 0; instance_index < water_instance_count; instance_index++)
     {
         Water* water = &water_instances[instance_index];
-        mat4BuildTRS(water_gpu_instances[instance_index].model, water->coords, (Vec4){ 0, 0, 0, 1 }, water->scale);
+        setTransformLane(&transform_lanes, (int32)instance_index, water->coords, (Vec4){ 0, 0, 0, 1 }, water->scale);
     }
+    buildTransformLanes(&transform_lanes, water_gpu_instances[0].model, sizeof(WaterInstanceData));
 
     // fill laser instance buffer
     LaserInstanceData* laser_gpu_instances = (LaserInstanceData*)vulkan_state.laser_instance_mappeds[vulkan_state.current_frame];
@@ -5528,6 +8414,19 @@ void vulkanSubmitFrame(DrawCommand* draw_commands, int32 draw_command_count, Ren
         instance->end_clip_plane = laser->end_clip_plane;
     }
 
+    // fill sprite instance buffer, in submission order so the overlay keeps its layering
+    SpriteInstanceData* sprite_gpu_instances = (SpriteInstanceData*)vulkan_state.sprite_instance_mappeds[vulkan_state.current_frame];
+    for (uint32 sprite_index = 0; sprite_index < sprite_instance_count; sprite_index++)
+    {
+        Sprite* sprite = &sprite_instances[sprite_index];
+        SpriteInstanceData* instance = &sprite_gpu_instances[sprite_index];
+
+        instance->coords = sprite->coords;
+        instance->alpha = sprite->alpha;
+        instance->uv_rect = sprite->uv;
+        instance->size = (Vec2){ sprite->size.x, sprite->size.y };
+    }
+
     // fill laser lights buffer for reflection
     LaserLightsBuffer* laser_lights = (LaserLightsBuffer*)vulkan_state.laser_lights_mappeds[vulkan_state.current_frame];
     int32 light_count = (int32)laser_instance_count;
@@ -5567,6 +8466,133 @@ void vulkanSubmitFrame(DrawCommand* draw_commands, int32 draw_command_count, Ren
     }
 }
 
+// static level mesh, then instanced (moving) cubes. pipeline and descriptor sets are bound by the caller
+// CULL PASS
+
+// one thread per static mesh chunk and per cube, for each view. survivors are compacted into per view draw lists that
+// drawCubes consumes through indirect draws, so the cpu never learns what was visible
+void dispatchCulling(VkCommandBuffer command_buffer)
+{
+    uint32 frame = vulkan_state.current_frame;
+
+    // reset counts. the cube draw is a single instanced draw whose instance count the shader accumulates
+    CullViewCounts initial_counts[CULL_VIEW_COUNT] = {0};
+    for (uint32 view_index = 0; view_index < CULL_VIEW_COUNT; view_index++) initial_counts[view_index].cube_draw.indexCount = vulkan_state.cube_index_count;
+    vkCmdUpdateBuffer(command_buffer, vulkan_state.cull_count_buffers[frame], 0, sizeof(initial_counts), initial_counts);
+
+    // without drawIndirectCount every chunk slot gets drawn, so slots the shader doesn't fill must be empty draws
+    if (!vulkan_state.draw_indirect_count) vkCmdFillBuffer(command_buffer, vulkan_state.cull_static_draw_buffers[frame], 0, VK_WHOLE_SIZE, 0);
+
+    memoryBarrier(command_buffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+    uint32 cube_count = cube_instance_count < CUBE_INSTANCE_CAPACITY ? cube_instance_count : CUBE_INSTANCE_CAPACITY;
+    uint32 item_count = vulkan_state.static_mesh_chunk_count + cube_count;
+
+    if (item_count > 0)
+    {
+        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.cull_pipeline);
+
+        for (uint32 view_index = 0; view_index < CULL_VIEW_COUNT; view_index++)
+        {
+            VkDescriptorSet cull_descriptor_sets[2] = { vulkan_state.view_constants_descriptor_sets[frame], vulkan_state.cull_descriptor_sets[frame] };
+            uint32 view_constants_offset = (view_index == CULL_VIEW_REFLECTION ? VIEW_REFLECTION : VIEW_MAIN) * vulkan_state.view_constants_stride;
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.cull_pipeline_layout, 0, 2, cull_descriptor_sets, 1, &view_constants_offset);
+
+            CullPushConstants push_constants = {0};
+            push_constants.view            = view_index;
+            push_constants.use_light_view  = view_index == CULL_VIEW_SHADOW;
+            push_constants.chunk_count     = vulkan_state.static_mesh_chunk_count;
+            push_constants.cube_count      = cube_count;
+            push_constants.max_chunk_count = MAX_STATIC_MESH_CHUNKS;
+            push_constants.cube_capacity   = CUBE_INSTANCE_CAPACITY;
+            vkCmdPushConstants(command_buffer, vulkan_state.cull_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &push_constants);
+
+            vkCmdDispatch(command_buffer, (item_count + 63) / 64, 1, 1);
+        }
+    }
+
+    memoryBarrier(command_buffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+}
+
+// draws what the cull pass kept for this view
+void drawStaticMesh(VkCommandBuffer command_buffer, uint32 cull_view)
+{
+    uint32 frame = vulkan_state.current_frame;
+    VkDeviceSize counts_offset = sizeof(CullViewCounts) * cull_view;
+
+    if (vulkan_state.static_mesh_chunk_count > 0)
+    {
+        VkBuffer mesh_buffers[2] = { vulkan_state.static_mesh_vertex_buffer, vulkan_state.static_mesh_instance_buffer };
+        VkDeviceSize mesh_offsets[2] = { 0, 0 };
+        vkCmdBindVertexBuffers(command_buffer, 0, 2, mesh_buffers, mesh_offsets);
+        vkCmdBindIndexBuffer(command_buffer, vulkan_state.static_mesh_index_buffer, 0, VK_INDEX_TYPE_UINT32);
+        VkDeviceSize draws_offset = sizeof(VkDrawIndexedIndirectCommand) * MAX_STATIC_MESH_CHUNKS * cull_view;
+        if (vulkan_state.draw_indirect_count)
+        {
+            vkCmdDrawIndexedIndirectCount(command_buffer,
+                vulkan_state.cull_static_draw_buffers[frame], draws_offset,
+                vulkan_state.cull_count_buffers[frame], counts_offset + offsetof(CullViewCounts, static_draw_count),
+                vulkan_state.static_mesh_chunk_count, sizeof(VkDrawIndexedIndirectCommand));
+        }
+        else if (vulkan_state.multi_draw_indirect)
+        {
+            vkCmdDrawIndexedIndirect(command_buffer, vulkan_state.cull_static_draw_buffers[frame], draws_offset, vulkan_state.static_mesh_chunk_count, sizeof(VkDrawIndexedIndirectCommand));
+        }
+        else
+        {
+            for (uint32 chunk_index = 0; chunk_index < vulkan_state.static_mesh_chunk_count; chunk_index++)
+            {
+                vkCmdDrawIndexedIndirect(command_buffer, vulkan_state.cull_static_draw_buffers[frame], draws_offset + sizeof(VkDrawIndexedIndirectCommand) * chunk_index, 1, sizeof(VkDrawIndexedIndirectCommand));
+            }
+        }
+    }
+}
+
+void drawDynamicCubes(VkCommandBuffer command_buffer, uint32 cull_view)
+{
+    uint32 frame = vulkan_state.current_frame;
+    VkDeviceSize counts_offset = sizeof(CullViewCounts) * cull_view;
+
+    if (cube_instance_count > 0)
+    {
+        VkBuffer cube_buffers[2] = { vulkan_state.cube_vertex_buffer, vulkan_state.cull_cube_instance_buffers[frame] };
+        VkDeviceSize cube_offsets[2] = { 0, sizeof(CubeInstanceData) * CUBE_INSTANCE_CAPACITY * cull_view };
+        vkCmdBindVertexBuffers(command_buffer, 0, 2, cube_buffers, cube_offsets);
+        vkCmdBindIndexBuffer(command_buffer, vulkan_state.cube_index_buffer, 0, VK_INDEX_TYPE_UINT32);
+        vkCmdDrawIndexedIndirect(command_buffer, vulkan_state.cull_count_buffers[frame], counts_offset + offsetof(CullViewCounts, cube_draw), 1, sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
+
+void drawCubes(VkCommandBuffer command_buffer, uint32 cull_view)
+{
+    drawStaticMesh(command_buffer, cull_view);
+    drawDynamicCubes(command_buffer, cull_view);
+}
+
+// every model instance this frame, one indirect draw per model in use. instance data comes from the model instance ssbo
+void drawModels(VkCommandBuffer command_buffer)
+{
+    VkDeviceSize vertex_offset = 0;
+    vkCmdBindVertexBuffers(command_buffer, 0, 1, &vulkan_state.model_mega_vertex_buffer, &vertex_offset);
+    vkCmdBindIndexBuffer(command_buffer, vulkan_state.model_mega_index_buffer, 0, VK_INDEX_TYPE_UINT32);
+    if (vulkan_state.draw_indirect_first_instance && vulkan_state.multi_draw_indirect)
+    {
+        vkCmdDrawIndexedIndirect(command_buffer, vulkan_state.model_draw_buffers[vulkan_state.current_frame], 0, model_draw_count, sizeof(VkDrawIndexedIndirectCommand));
+        return;
+    }
+
+    // direct draws take any firstInstance, and need no multiDrawIndirect
+    for (uint32 draw_index = 0; draw_index < model_draw_count; draw_index++)
+    {
+        VkDrawIndexedIndirectCommand* draw = &model_draw_commands[draw_index];
+        vkCmdDrawIndexed(command_buffer, draw->indexCount, draw->instanceCount, draw->firstIndex, draw->vertexOffset, draw->firstInstance);
+    }
+}
+
 void vulkanDraw(bool do_profiling_output)
 {
     uint32 swapchain_image_index = 0;
@@ -5609,99 +8635,55 @@ void vulkanDraw(bool do_profiling_output)
 
     vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, current_pool, query_index++);
 
-    // FFT TIME EVOLUTION DISPATCH
+    // WATER FFT
+    if (vulkan_state.water_mode == WATER_MODE_EVERY_FRAME)
     {
-        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_evolved_pipeline);
-
-        VkDescriptorSet evolved_sets[2] =
-        {
-            vulkan_state.h0_descriptor_set,
-            vulkan_state.fft_buffer_a_descriptor_set,
-        };
-        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_evolved_pipeline_layout, 0, 2, evolved_sets, 0, 0);
-
-        FFTEvolvedPushConstants pc = {0};
-        pc.texture_size = FFT_SIZE;
-        pc.water_tile_length = water_tile_length;
-        pc.gravity = 9.81f;
-        pc.time = vulkan_state.time;
-
-        vkCmdPushConstants(command_buffer, vulkan_state.fft_evolved_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FFTEvolvedPushConstants), &pc);
-        vkCmdDispatch(command_buffer, FFT_SIZE / 16, FFT_SIZE / 16, 1);
+        recordWaterFft(command_buffer, vulkan_state.time, 0.0f);
 
         memoryBarrier(command_buffer,
-            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
             VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
     }
-
-    // FFT PASSES (8 horizontal, then 8 vertical)
+    else if (vulkan_state.water_mode == WATER_MODE_REDUCED_RATE)
     {
-        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_pass_pipeline);
-
-        int32 log2_fft_size = 8; // log2(256)
-        
-        // tracks which buffer is currently the source
-        bool source_is_a = true;
-
-        for (int32 pass_index = 0; pass_index < 2 * log2_fft_size; pass_index++)
+        // the water is a closed form function of time, so the update after now can be simulated ahead and blended towards.
+        // usually only that one is new; both are after a hitch, on the first frame, or on switching to this mode
+        int32 current_tick = (int32)floorf(vulkan_state.time * water_update_rate);
+        for (int32 tick = current_tick; tick <= current_tick + 1; tick++)
         {
-            int32 direction = (pass_index < log2_fft_size) ? 0 : 1; // first 8 horizontal, next 8 vertical
-            int32 level = (pass_index % log2_fft_size) + 1;
-
-            VkDescriptorSet pass_sets[2] =
-            {
-                source_is_a ? vulkan_state.fft_buffer_a_descriptor_set : vulkan_state.fft_buffer_b_descriptor_set, // source
-                source_is_a ? vulkan_state.fft_buffer_b_descriptor_set : vulkan_state.fft_buffer_a_descriptor_set, // dest
-            };
+            int32 layer = tick & 1;
+            if (vulkan_state.water_history_ticks[layer] == tick) continue;
 
-            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_pass_pipeline_layout, 0, 2, pass_sets, 0, 0);
+            recordWaterFft(command_buffer, (float)tick / water_update_rate, 0.0f);
 
-            FFTPassPushConstants pc = {0};
-            pc.texture_size = FFT_SIZE;
-            pc.level = level;
-            pc.direction = direction;
+            // earlier frames may still be sampling the layer being replaced
+            memoryBarrier(command_buffer,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
 
-            vkCmdPushConstants(command_buffer, vulkan_state.fft_pass_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FFTPassPushConstants), &pc);
+            VkImageCopy history_copy = {0};
+            history_copy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            history_copy.srcSubresource.layerCount = 1;
+            history_copy.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            history_copy.dstSubresource.baseArrayLayer = (uint32)layer;
+            history_copy.dstSubresource.layerCount = 1;
+            history_copy.extent = (VkExtent3D){ FFT_SIZE, FFT_SIZE, 1 };
 
-            vkCmdDispatch(command_buffer, (FFT_SIZE / 2) / 16, FFT_SIZE / 16, 1);
+            vkCmdCopyImage(command_buffer, vulkan_state.displacement_image, VK_IMAGE_LAYOUT_GENERAL, vulkan_state.water_history_image, VK_IMAGE_LAYOUT_GENERAL, 1, &history_copy);
 
             memoryBarrier(command_buffer,
-                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
-            source_is_a = !source_is_a;
-        }
-    }
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
 
-    // FFT FINALIZE: real part of fft_buffer_a, normalize
-    {
-        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_finalize_pipeline);
-        
-        VkDescriptorSet finalize_sets[2] =
-        {
-            vulkan_state.fft_buffer_a_descriptor_set,   // source (read)
-            vulkan_state.displacement_descriptor_set,   // destination (write)
-        };
-        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkan_state.fft_finalize_pipeline_layout, 0, 2, finalize_sets, 0, 0);
-        
-        FFTFinalizePushConstants pc = {0};
-        pc.texture_size = FFT_SIZE;
-        pc.water_tile_length = water_tile_length;
-        
-        vkCmdPushConstants(command_buffer, vulkan_state.fft_finalize_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FFTFinalizePushConstants), &pc);
-        
-        // dispatch one thread per texel
-        vkCmdDispatch(command_buffer, FFT_SIZE / 16, FFT_SIZE / 16, 1);
-        
-        memoryBarrier(command_buffer,
-            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
-            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+            vulkan_state.water_history_ticks[layer] = tick;
+        }
     }
 
     vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, current_pool, query_index++);
     vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, current_pool, query_index++);
 
-    // upload paint texture if dirty
-    if (vulkan_state.water_paint_texture && vulkan_state.water_paint_texture->dirty)
+    // upload paint texture if the game has painted since the last upload
+    if (vulkan_state.water_paint_texture && vulkan_state.water_paint_texture->generation != vulkan_state.paint_uploaded_generation)
     {
         // TODO: slow... will want to either expose this mapped memory to game, and handle like that, or only write affected pixels on any given frame
         int32 paint_texture_width  = (int32)roundf(vulkan_state.level_aabb_max.x - vulkan_state.level_aabb_min.x) * WATER_PAINT_RESOLUTION;
@@ -5755,7 +8737,7 @@ void vulkanDraw(bool do_profiling_output)
             VK_IMAGE_ASPECT_COLOR_BIT);
 
         vulkan_state.paint_image_first_upload = false;
-        vulkan_state.water_paint_texture->dirty = false;
+        vulkan_state.paint_uploaded_generation = vulkan_state.water_paint_texture->generation;
     }
 
     VkClearValue clear_values[3];
@@ -5815,6 +8797,9 @@ void vulkanDraw(bool do_profiling_output)
     float reflected_view_matrix[16];
     mat4BuildReflectedView(reflected_view_matrix, vulkan_state.camera.coords, vulkan_state.camera.rotation, vulkan_state.water_plane_y);
 
+    float light_view_projection[16];
+    mat4BuildDirectionalLight(light_view_projection, vulkan_state.sun_direction, vulkan_state.level_aabb_min, vulkan_state.level_aabb_max);
+
     // fill view constants for this frame
     {
         char* view_constants_base = (char*)vulkan_state.scene_ubo_mappeds[vulkan_state.current_frame];
@@ -5839,9 +8824,6 @@ void vulkanDraw(bool do_profiling_output)
         mat4Multiply(main_view_projection, projection_matrix, view_matrix);
         mat4Inverse(main_inverse_view_projection, main_view_projection);
 
-        float light_view_projection[16];
-        mat4BuildDirectionalLight(light_view_projection, vulkan_state.sun_direction, vulkan_state.level_aabb_min, vulkan_state.level_aabb_max);
-
         memcpy(main_view_constants->view,            view_matrix,                  sizeof(float) * 16);
         memcpy(main_view_constants->proj,            projection_matrix,            sizeof(float) * 16);
         memcpy(main_view_constants->view_proj,       main_view_projection,         sizeof(float) * 16);
@@ -5856,6 +8838,7 @@ void vulkanDraw(bool do_profiling_output)
         main_view_constants->time                      = vulkan_state.time;
         main_view_constants->water_tile_length         = water_tile_length;
         main_view_constants->focal_length              = focal_length;
+        main_view_constants->atlas_3d_cell             = atlas_3d_cell;
 
         // reflection camera: same globals, reflected view + real water plane
         float reflection_view_projection[16];
@@ -5876,6 +8859,8 @@ void vulkanDraw(bool do_profiling_output)
         memcpy(sprite_view_constants->view_proj, orthographic_matrix, sizeof(float) * 16);
     }
 
+    dispatchCulling(command_buffer);
+
     // RENDER PASSES
 
     VkRenderPassBeginInfo render_pass_begin_info = {0};
@@ -5892,20 +8877,6 @@ void vulkanDraw(bool do_profiling_output)
 
     // SHADOW PASS
     {
-        VkClearValue shadow_clear = {0};
-        shadow_clear.depthStencil.depth = 1.0f;
-
-        VkRenderPassBeginInfo shadow_rp_begin = {0};
-        shadow_rp_begin.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        shadow_rp_begin.renderPass = vulkan_state.shadow_render_pass;
-        shadow_rp_begin.framebuffer = vulkan_state.shadow_framebuffer;
-        shadow_rp_begin.renderArea.offset = (VkOffset2D){ 0, 0 };
-        shadow_rp_begin.renderArea.extent = (VkExtent2D){ SHADOW_MAP_RESOLUTION, SHADOW_MAP_RESOLUTION };
-        shadow_rp_begin.clearValueCount = 1;
-        shadow_rp_begin.pClearValues = &shadow_clear;
-
-        vkCmdBeginRenderPass(command_buffer, &shadow_rp_begin, VK_SUBPASS_CONTENTS_INLINE);
-
         // full shadow map
         VkViewport shadow_viewport = {0};
         shadow_viewport.x = 0.0f;
@@ -5919,48 +8890,94 @@ void vulkanDraw(bool do_profiling_output)
         shadow_scissor.extent.width  = SHADOW_MAP_RESOLUTION;
         shadow_scissor.extent.height = SHADOW_MAP_RESOLUTION;
 
+        uint32 shadow_view_constants_offset = VIEW_MAIN * vulkan_state.view_constants_stride;
+
+        // static casters only change with the level mesh or the light, so their depth is kept and rendered again only then
+        if (!vulkan_state.shadow_static_valid
+            || vulkan_state.shadow_static_mesh_version != vulkan_state.static_mesh_version
+            || memcmp(vulkan_state.shadow_static_light_view_proj, light_view_projection, sizeof(float) * 16) != 0)
+        {
+            VkClearValue shadow_clear = {0};
+            shadow_clear.depthStencil.depth = 1.0f;
+
+            VkRenderPassBeginInfo shadow_static_rp_begin = {0};
+            shadow_static_rp_begin.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            shadow_static_rp_begin.renderPass = vulkan_state.shadow_static_render_pass;
+            shadow_static_rp_begin.framebuffer = vulkan_state.shadow_static_framebuffer;
+            shadow_static_rp_begin.renderArea.offset = (VkOffset2D){ 0, 0 };
+            shadow_static_rp_begin.renderArea.extent = (VkExtent2D){ SHADOW_MAP_RESOLUTION, SHADOW_MAP_RESOLUTION };
+            shadow_static_rp_begin.clearValueCount = 1;
+            shadow_static_rp_begin.pClearValues = &shadow_clear;
+
+            vkCmdBeginRenderPass(command_buffer, &shadow_static_rp_begin, VK_SUBPASS_CONTENTS_INLINE);
+
+            vkCmdSetViewport(command_buffer, 0, 1, &shadow_viewport);
+            vkCmdSetScissor(command_buffer, 0, 1, &shadow_scissor);
+
+            if (vulkan_state.static_mesh_chunk_count > 0)
+            {
+                vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.shadow_cube_pipeline);
+                vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.shadow_pipeline_layout, 0, 1, &vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame], 1, &shadow_view_constants_offset);
+                drawStaticMesh(command_buffer, CULL_VIEW_SHADOW);
+            }
+
+            vkCmdEndRenderPass(command_buffer);
+
+            vulkan_state.shadow_static_valid = true;
+            vulkan_state.shadow_static_mesh_version = vulkan_state.static_mesh_version;
+            memcpy(vulkan_state.shadow_static_light_view_proj, light_view_projection, sizeof(float) * 16);
+        }
+
+        // start this frame's shadow map from the static depth. last frame's contents are not needed, only its reads finished
+        imageBarrier(command_buffer, vulkan_state.shadow_map_image,
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_IMAGE_ASPECT_DEPTH_BIT);
+
+        VkImageCopy shadow_copy = {0};
+        shadow_copy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+        shadow_copy.srcSubresource.layerCount = 1;
+        shadow_copy.dstSubresource.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+        shadow_copy.dstSubresource.layerCount = 1;
+        shadow_copy.extent = (VkExtent3D){ SHADOW_MAP_RESOLUTION, SHADOW_MAP_RESOLUTION, 1 };
+
+        vkCmdCopyImage(command_buffer, vulkan_state.shadow_static_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, vulkan_state.shadow_map_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &shadow_copy);
+
+        // dynamic casters on top
+        VkRenderPassBeginInfo shadow_rp_begin = {0};
+        shadow_rp_begin.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        shadow_rp_begin.renderPass = vulkan_state.shadow_render_pass;
+        shadow_rp_begin.framebuffer = vulkan_state.shadow_framebuffer;
+        shadow_rp_begin.renderArea.offset = (VkOffset2D){ 0, 0 };
+        shadow_rp_begin.renderArea.extent = (VkExtent2D){ SHADOW_MAP_RESOLUTION, SHADOW_MAP_RESOLUTION };
+
+        vkCmdBeginRenderPass(command_buffer, &shadow_rp_begin, VK_SUBPASS_CONTENTS_INLINE);
+
         vkCmdSetViewport(command_buffer, 0, 1, &shadow_viewport);
         vkCmdSetScissor(command_buffer, 0, 1, &shadow_scissor);
 
-        uint32 shadow_view_constants_offset = VIEW_MAIN * vulkan_state.view_constants_stride;
-
         // cube casters
         if (cube_instance_count > 0)
         {
             vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.shadow_cube_pipeline);
             vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.shadow_pipeline_layout, 0, 1, &vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame], 1, &shadow_view_constants_offset);
-
-            VkBuffer cube_buffers[2] = { vulkan_state.cube_vertex_buffer, vulkan_state.cube_instance_buffers[vulkan_state.current_frame] };
-            VkDeviceSize cube_offsets[2] = { 0, 0 };
-            vkCmdBindVertexBuffers(command_buffer, 0, 2, cube_buffers, cube_offsets);
-            vkCmdBindIndexBuffer(command_buffer, vulkan_state.cube_index_buffer, 0, VK_INDEX_TYPE_UINT32);
-
-            vkCmdDrawIndexed(command_buffer, vulkan_state.cube_index_count, cube_instance_count, 0, 0, 0);
+            drawDynamicCubes(command_buffer, CULL_VIEW_SHADOW);
         }
 
         // model casters
-        if (model_instance_count > 0)
+        if (model_draw_count > 0)
         {
             vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.shadow_model_pipeline);
-            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.shadow_pipeline_layout, 0, 1, &vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame], 1, &shadow_view_constants_offset);
 
-            for (uint32 model_instance_index = 0; model_instance_index < model_instance_count; model_instance_index++)
+            VkDescriptorSet shadow_descriptor_sets[2] =
             {
-                Model* model = &model_instances[model_instance_index];
-                LoadedModel* model_data = &vulkan_state.loaded_models[model->model_id - MODEL_3D_VOID];
-                if (model_data->index_count == 0) continue;
-
-                float model_matrix[16];
-                mat4BuildTRS(model_matrix, model->coords, model->rotation, model->scale);
-
-                vkCmdPushConstants(command_buffer, vulkan_state.shadow_pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(float) * 16, model_matrix);
-
-                VkDeviceSize vertex_offset = 0;
-                vkCmdBindVertexBuffers(command_buffer, 0, 1, &model_data->vertex_buffer, &vertex_offset);
-                vkCmdBindIndexBuffer(command_buffer, model_data->index_buffer, 0, VK_INDEX_TYPE_UINT32);
+                vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame],
+                vulkan_state.model_instance_descriptor_sets[vulkan_state.current_frame],
+            };
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.shadow_pipeline_layout, 0, 2, shadow_descriptor_sets, 1, &shadow_view_constants_offset);
 
-                vkCmdDrawIndexed(command_buffer, model_data->index_count, 1, 0, 0, 0);
-            }
+            drawModels(command_buffer);
         }
 
         vkCmdEndRenderPass(command_buffer);
@@ -6012,15 +9029,10 @@ void vulkanDraw(bool do_profiling_output)
         vkCmdSetScissor(command_buffer, 0, 1, &reflection_scissor);
 
         // cubes
-        if (cube_instance_count > 0)
+        if (cube_instance_count > 0 || vulkan_state.static_mesh_chunk_count > 0)
         {
             vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.cube_reflection_pipeline);
 
-            VkBuffer cube_buffers[2] = { vulkan_state.cube_vertex_buffer, vulkan_state.cube_instance_buffers[vulkan_state.current_frame] };
-            VkDeviceSize cube_offsets[2] = { 0, 0 };
-            vkCmdBindVertexBuffers(command_buffer, 0, 2, cube_buffers, cube_offsets);
-            vkCmdBindIndexBuffer(command_buffer, vulkan_state.cube_index_buffer, 0, VK_INDEX_TYPE_UINT32);
-
             VkDescriptorSet cube_descriptor_sets[4] =
             {
                 vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame],
@@ -6032,42 +9044,25 @@ void vulkanDraw(bool do_profiling_output)
             uint32 cube_view_constants_offset = VIEW_REFLECTION * vulkan_state.view_constants_stride;
             vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.cube_pipeline_layout, 0, 4, cube_descriptor_sets, 1, &cube_view_constants_offset);
 
-            vkCmdDrawIndexed(command_buffer, vulkan_state.cube_index_count, cube_instance_count, 0, 0, 0);
+            drawCubes(command_buffer, CULL_VIEW_REFLECTION);
         }
 
         // models
-        if (model_instance_count > 0)
+        if (model_draw_count > 0)
         {
             vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.model_reflection_pipeline);
 
-            VkDescriptorSet model_descriptor_sets[3] =
+            VkDescriptorSet model_descriptor_sets[4] =
             {
                 vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame],
                 vulkan_state.displacement_sampled_descriptor_set,
                 vulkan_state.shadow_map_descriptor_set,
+                vulkan_state.model_instance_descriptor_sets[vulkan_state.current_frame],
             };
             uint32 model_view_constants_offset = VIEW_REFLECTION * vulkan_state.view_constants_stride;
-            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.model_pipeline_layout, 0, 3, model_descriptor_sets, 1, &model_view_constants_offset);
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.model_pipeline_layout, 0, 4, model_descriptor_sets, 1, &model_view_constants_offset);
 
-            for (uint32 model_instance_index = 0; model_instance_index < model_instance_count; model_instance_index++)
-            {
-                Model* model = &model_instances[model_instance_index];
-                LoadedModel* model_data = &vulkan_state.loaded_models[model->model_id - MODEL_3D_VOID];
-                if (model_data->index_count == 0) continue;
-
-                VkDeviceSize vertex_offset = 0;
-                float model_matrix[16];
-                mat4BuildTRS(model_matrix, model->coords, model->rotation, model->scale);
-
-                ModelPushConstants model_push_constants = {0};
-                memcpy(model_push_constants.model, model_matrix, sizeof(model_push_constants.model));
-                model_push_constants.color = model->color;
-
-                vkCmdBindVertexBuffers(command_buffer, 0, 1, &model_data->vertex_buffer, &vertex_offset);
-                vkCmdBindIndexBuffer(command_buffer, model_data->index_buffer, 0, VK_INDEX_TYPE_UINT32);
-                vkCmdPushConstants(command_buffer, vulkan_state.model_pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(ModelPushConstants), &model_push_constants);
-                vkCmdDrawIndexed(command_buffer, model_data->index_count, 1, 0, 0, 0);
-            }
+            drawModels(command_buffer);
         }
 
         vkCmdEndRenderPass(command_buffer);
@@ -6083,15 +9078,10 @@ void vulkanDraw(bool do_profiling_output)
     vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 
     // cubes
-    if (cube_instance_count > 0)
+    if (cube_instance_count > 0 || vulkan_state.static_mesh_chunk_count > 0)
     {
         vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.cube_pipeline);
 
-        VkBuffer cube_buffers[2] = { vulkan_state.cube_vertex_buffer, vulkan_state.cube_instance_buffers[vulkan_state.current_frame] };
-        VkDeviceSize cube_offsets[2] = { 0, 0 };
-        vkCmdBindVertexBuffers(command_buffer, 0, 2, cube_buffers, cube_offsets);
-        vkCmdBindIndexBuffer(command_buffer, vulkan_state.cube_index_buffer, 0, VK_INDEX_TYPE_UINT32);
-
         VkDescriptorSet cube_descriptor_sets[4] =
         {
             vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame],
@@ -6102,42 +9092,25 @@ void vulkanDraw(bool do_profiling_output)
         uint32 cube_view_constants_offset = VIEW_MAIN * vulkan_state.view_constants_stride;
         vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.cube_pipeline_layout, 0, 4, cube_descriptor_sets, 1, &cube_view_constants_offset);
 
-        vkCmdDrawIndexed(command_buffer, vulkan_state.cube_index_count, cube_instance_count, 0, 0, 0);
+        drawCubes(command_buffer, CULL_VIEW_MAIN);
     }
 
     // models
-    if (model_instance_count > 0)
+    if (model_draw_count > 0)
     {
         vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.model_pipeline);
 
-        VkDescriptorSet model_descriptor_sets[3] =
+        VkDescriptorSet model_descriptor_sets[4] =
         {
             vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame],
             vulkan_state.displacement_sampled_descriptor_set,
             vulkan_state.shadow_map_descriptor_set,
+            vulkan_state.model_instance_descriptor_sets[vulkan_state.current_frame],
         };
         uint32 model_view_constants_offset = VIEW_MAIN * vulkan_state.view_constants_stride;
-        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.model_pipeline_layout, 0, 3, model_descriptor_sets, 1, &model_view_constants_offset);
-
-        for (uint32 model_instance_index = 0; model_instance_index < model_instance_count; model_instance_index++)
-        {
-            Model* model = &model_instances[model_instance_index];
-            LoadedModel* model_data = &vulkan_state.loaded_models[model->model_id - MODEL_3D_VOID];
-            if (model_data->index_count == 0) continue;
-
-            VkDeviceSize vertex_offset = 0;
-            float model_matrix[16];
-            mat4BuildTRS(model_matrix, model->coords, model->rotation, model->scale);
-
-            ModelPushConstants model_push_constants = {0};
-            memcpy(model_push_constants.model, model_matrix, sizeof(model_push_constants.model));
-            model_push_constants.color = model->color;
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.model_pipeline_layout, 0, 4, model_descriptor_sets, 1, &model_view_constants_offset);
 
-            vkCmdBindVertexBuffers(command_buffer, 0, 1, &model_data->vertex_buffer, &vertex_offset);
-            vkCmdBindIndexBuffer(command_buffer, model_data->index_buffer, 0, VK_INDEX_TYPE_UINT32);
-            vkCmdPushConstants(command_buffer, vulkan_state.model_pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(ModelPushConstants), &model_push_constants);
-            vkCmdDrawIndexed(command_buffer, model_data->index_count, 1, 0, 0, 0);
-        }
+        drawModels(command_buffer);
     }
 
     vkCmdEndRenderPass(command_buffer);
@@ -6273,13 +9246,17 @@ void vulkanDraw(bool do_profiling_output)
 
             vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.water_pipeline);
 
+            VkDescriptorSet water_frames_descriptor_set = vulkan_state.displacement_array_sampled_descriptor_set;
+            if (vulkan_state.water_mode == WATER_MODE_BAKED_LOOP) water_frames_descriptor_set = vulkan_state.water_loop_sampled_descriptor_set;
+            else if (vulkan_state.water_mode == WATER_MODE_REDUCED_RATE) water_frames_descriptor_set = vulkan_state.water_history_sampled_descriptor_set;
+
             VkDescriptorSet water_descriptor_sets[10] =
             {
                 vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame],
                 vulkan_state.scene_copy_descriptor_set,
                 vulkan_state.depth_descriptor_set,
                 vulkan_state.paint_descriptor_set,
-                vulkan_state.displacement_sampled_descriptor_set,
+                water_frames_descriptor_set,
                 vulkan_state.reflection_descriptor_set,
                 vulkan_state.descriptor_sets[vulkan_state.water_grid_asset_index],
                 vulkan_state.descriptor_sets[vulkan_state.water_grid_normal_asset_index],
@@ -6289,12 +9266,31 @@ void vulkanDraw(bool do_profiling_output)
             uint32 water_view_constants_offset = VIEW_MAIN * vulkan_state.view_constants_stride;
             vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.water_pipeline_layout, 0, 10, water_descriptor_sets, 1, &water_view_constants_offset);
 
-            VkBuffer water_buffers[2] = { water_data->vertex_buffer, vulkan_state.water_instance_buffers[vulkan_state.current_frame] };
+            WaterPushConstants water_pc = {0};
+            if (vulkan_state.water_mode == WATER_MODE_BAKED_LOOP)
+            {
+                float loop_frame = fmodf(vulkan_state.time, water_loop_period) / water_loop_period * (float)WATER_LOOP_FRAME_COUNT;
+                water_pc.frame_a = (int32)loop_frame % WATER_LOOP_FRAME_COUNT;
+                water_pc.frame_b = (water_pc.frame_a + 1) % WATER_LOOP_FRAME_COUNT;
+                water_pc.frame_blend = loop_frame - floorf(loop_frame);
+            }
+            else if (vulkan_state.water_mode == WATER_MODE_REDUCED_RATE)
+            {
+                float tick_time = vulkan_state.time * water_update_rate;
+                int32 current_tick = (int32)floorf(tick_time);
+                water_pc.frame_a = current_tick & 1;
+                water_pc.frame_b = (current_tick + 1) & 1;
+                water_pc.frame_blend = tick_time - (float)current_tick;
+            }
+            vkCmdPushConstants(command_buffer, vulkan_state.water_pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(WaterPushConstants), &water_pc);
+
+            ModelMeshInfo* water_mesh = &vulkan_state.model_mesh_infos[MODEL_3D_WATER - MODEL_3D_VOID];
+            VkBuffer water_buffers[2] = { vulkan_state.model_mega_vertex_buffer, vulkan_state.water_instance_buffers[vulkan_state.current_frame] };
             VkDeviceSize water_offsets[2] = { 0, 0 };
             vkCmdBindVertexBuffers(command_buffer, 0, 2, water_buffers, water_offsets);
-            vkCmdBindIndexBuffer(command_buffer, water_data->index_buffer, 0, VK_INDEX_TYPE_UINT32);
+            vkCmdBindIndexBuffer(command_buffer, vulkan_state.model_mega_index_buffer, 0, VK_INDEX_TYPE_UINT32);
 
-            vkCmdDrawIndexed(command_buffer, water_data->index_count, water_instance_count, 0, 0, 0);
+            vkCmdDrawIndexed(command_buffer, water_mesh->index_count, water_instance_count, water_mesh->index_offset, (int32)water_mesh->vertex_offset, 0);
 
             vkCmdEndRenderPass(command_buffer);
         }
@@ -6305,8 +9301,51 @@ void vulkanDraw(bool do_profiling_output)
 
     // OVERLAY PASS (editor outlines + lasers + sprites)
 
-    // clear oit resources 
+    LoadedModel* laser_mesh = &vulkan_state.laser_cylinder_model;
+    bool draw_lasers = laser_mesh->index_count > 0 && laser_instance_count > 0 && vulkan_state.shader_mode != SHADER_MODE_OUTLINE_TEST;
+    bool weighted_blended_oit = vulkan_state.shader_mode == SHADER_MODE_WEIGHTED_BLENDED_OIT;
+
+    if (weighted_blended_oit)
+    {
+        // lasers accumulate into their own targets first, the overlay pass composites them
+        if (draw_lasers)
+        {
+            VkClearValue wboit_clear_values[3] = {0};
+            wboit_clear_values[0].color = (VkClearColorValue){{ 0.0f, 0.0f, 0.0f, 0.0f }};
+            wboit_clear_values[1].color = (VkClearColorValue){{ 1.0f, 0.0f, 0.0f, 0.0f }};
+
+            VkRenderPassBeginInfo wboit_rp_begin = {0};
+            wboit_rp_begin.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            wboit_rp_begin.renderPass = vulkan_state.wboit_render_pass;
+            wboit_rp_begin.framebuffer = vulkan_state.wboit_framebuffer;
+            wboit_rp_begin.renderArea.offset = (VkOffset2D){0, 0};
+            wboit_rp_begin.renderArea.extent = vulkan_state.swapchain_extent;
+            wboit_rp_begin.clearValueCount = 3;
+            wboit_rp_begin.pClearValues = wboit_clear_values;
+
+            vkCmdBeginRenderPass(command_buffer, &wboit_rp_begin, VK_SUBPASS_CONTENTS_INLINE);
+
+            vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+            vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.laser_wboit_pipeline);
+
+            uint32 laser_view_constants_offset = VIEW_MAIN * vulkan_state.view_constants_stride;
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.laser_wboit_pipeline_layout, 0, 1, &vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame], 1, &laser_view_constants_offset);
+
+            VkBuffer laser_vertex_buffers[2] = { laser_mesh->vertex_buffer, vulkan_state.laser_instance_buffers[vulkan_state.current_frame] };
+            VkDeviceSize laser_vertex_offsets[2] = { 0, 0 };
+            vkCmdBindVertexBuffers(command_buffer, 0, 2, laser_vertex_buffers, laser_vertex_offsets);
+            vkCmdBindIndexBuffer(command_buffer, laser_mesh->index_buffer, 0, VK_INDEX_TYPE_UINT32);
+
+            vkCmdDrawIndexed(command_buffer, laser_mesh->index_count, laser_instance_count, 0, 0, 0);
+
+            vkCmdEndRenderPass(command_buffer);
+        }
+    }
+    else
     {
+        // clear oit resources
         imageBarrier(command_buffer, vulkan_state.oit_head_image,
             VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
@@ -6361,12 +9400,30 @@ void vulkanDraw(bool do_profiling_output)
     {
         Model* model = &model_editor_outline_instances[model_outline_index];
 
-        LoadedModel* model_data = model->model_id == SPRITEID_ASSET_COUNT ? &vulkan_state.dummy_cube_model : &vulkan_state.loaded_models[model->model_id - MODEL_3D_VOID];
-        if (model_data->index_count == 0) continue;
+        // loaded models only live in the mega buffer; the dummy cube keeps its own
+        VkBuffer outline_vertex_buffer = vulkan_state.model_mega_vertex_buffer;
+        VkBuffer outline_index_buffer = vulkan_state.model_mega_index_buffer;
+        uint32 outline_index_count = 0;
+        uint32 outline_first_index = 0;
+        int32 outline_vertex_offset = 0;
+        if (model->model_id == SPRITEID_ASSET_COUNT)
+        {
+            outline_vertex_buffer = vulkan_state.dummy_cube_model.vertex_buffer;
+            outline_index_buffer = vulkan_state.dummy_cube_model.index_buffer;
+            outline_index_count = vulkan_state.dummy_cube_model.index_count;
+        }
+        else
+        {
+            ModelMeshInfo* mesh_info = &vulkan_state.model_mesh_infos[model->model_id - MODEL_3D_VOID];
+            outline_index_count = mesh_info->index_count;
+            outline_first_index = mesh_info->index_offset;
+            outline_vertex_offset = (int32)mesh_info->vertex_offset;
+        }
+        if (outline_index_count == 0) continue;
 
         VkDeviceSize vertex_offset = 0;
-        vkCmdBindVertexBuffers(command_buffer, 0, 1, &model_data->vertex_buffer, &vertex_offset);
-        vkCmdBindIndexBuffer(command_buffer, model_data->index_buffer, 0, VK_INDEX_TYPE_UINT32);
+        vkCmdBindVertexBuffers(command_buffer, 0, 1, &outline_vertex_buffer, &vertex_offset);
+        vkCmdBindIndexBuffer(command_buffer, outline_index_buffer, 0, VK_INDEX_TYPE_UINT32);
 
         float model_matrix[16];
         mat4BuildTRS(model_matrix, model->coords, model->rotation, model->scale);
@@ -6375,12 +9432,11 @@ void vulkanDraw(bool do_profiling_output)
         memcpy(outline_push_constants.model, model_matrix, sizeof(outline_push_constants.model));
 
         vkCmdPushConstants(command_buffer, vulkan_state.editor_outline_pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(OutlinePushConstants), &outline_push_constants);
-        vkCmdDrawIndexed(command_buffer, model_data->index_count, 1, 0, 0, 0);
+        vkCmdDrawIndexed(command_buffer, outline_index_count, 1, outline_first_index, outline_vertex_offset, 0);
     }
 
     // LASER PASS
-    LoadedModel* laser_mesh = &vulkan_state.laser_cylinder_model;
-    if (laser_mesh->index_count > 0 && laser_instance_count > 0 && vulkan_state.shader_mode != SHADER_MODE_OUTLINE_TEST)
+    if (!weighted_blended_oit && draw_lasers)
     {
         vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.laser_pipeline);
 
@@ -6402,65 +9458,74 @@ void vulkanDraw(bool do_profiling_output)
         vkCmdDrawIndexed(command_buffer, laser_mesh->index_count, laser_instance_count, 0, 0, 0);
     }
 
-    VkMemoryBarrier oit_barrier = {0};
-    oit_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
-    oit_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-    oit_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-    vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_DEPENDENCY_BY_REGION_BIT, 1, &oit_barrier, 0, 0, 0, 0);
+    if (weighted_blended_oit)
+    {
+        // weighted blended resolve: one fetch from each target, whatever the laser count
+        if (draw_lasers)
+        {
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.oit_wboit_resolve_pipeline);
+
+            VkDescriptorSet wboit_sets[2] =
+            {
+                vulkan_state.wboit_accumulation_descriptor_set,
+                vulkan_state.wboit_revealage_descriptor_set,
+            };
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.oit_wboit_resolve_pipeline_layout, 0, 2, wboit_sets, 0, 0);
 
-    // OIT resolve pass
+            vkCmdDraw(command_buffer, 3, 1, 0, 0);
+        }
+    }
+    else
     {
-        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.oit_resolve_pipeline);
+        VkMemoryBarrier oit_barrier = {0};
+        oit_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        oit_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        oit_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_DEPENDENCY_BY_REGION_BIT, 1, &oit_barrier, 0, 0, 0, 0);
 
-        VkDescriptorSet oit_sets[4] = 
+        // OIT resolve pass
         {
-            vulkan_state.oit_head_storage_descriptor_set,
-            vulkan_state.oit_fragment_pool_descriptor_set,
-            vulkan_state.oit_counter_descriptor_set,
-            vulkan_state.depth_descriptor_set,
-        };
-        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.oit_resolve_pipeline_layout, 0, 4, oit_sets, 0, 0);
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.oit_resolve_pipeline);
+
+            VkDescriptorSet oit_sets[4] = 
+            {
+                vulkan_state.oit_head_storage_descriptor_set,
+                vulkan_state.oit_fragment_pool_descriptor_set,
+                vulkan_state.oit_counter_descriptor_set,
+                vulkan_state.depth_descriptor_set,
+            };
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.oit_resolve_pipeline_layout, 0, 4, oit_sets, 0, 0);
 
-        float oit_depth_threshold = 0.5f;
-        vkCmdPushConstants(command_buffer, vulkan_state.oit_resolve_pipeline_layout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(float), &oit_depth_threshold);
+            float oit_depth_threshold = 0.5f;
+            vkCmdPushConstants(command_buffer, vulkan_state.oit_resolve_pipeline_layout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(float), &oit_depth_threshold);
 
-        vkCmdDraw(command_buffer, 3, 1, 0, 0);
+            vkCmdDraw(command_buffer, 3, 1, 0, 0);
+        }
     }
 
-    // sprites
+    // sprites, one instanced draw per run of sprites sharing an atlas. runs stay in submission order so text still lands on
+    // top of whatever was submitted before it
     vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.sprite_pipeline);
 
-    VkDeviceSize sprite_vertex_offset = 0;
-    vkCmdBindVertexBuffers(command_buffer, 0, 1, &vulkan_state.sprite_vertex_buffer, &sprite_vertex_offset);
+    VkBuffer sprite_vertex_buffers[2] = { vulkan_state.sprite_vertex_buffer, vulkan_state.sprite_instance_buffers[vulkan_state.current_frame] };
+    VkDeviceSize sprite_vertex_offsets[2] = { 0, 0 };
+    vkCmdBindVertexBuffers(command_buffer, 0, 2, sprite_vertex_buffers, sprite_vertex_offsets);
     vkCmdBindIndexBuffer(command_buffer, vulkan_state.sprite_index_buffer, 0, VK_INDEX_TYPE_UINT32);
 
     uint32 sprite_view_constants_offset = VIEW_SPRITE * vulkan_state.view_constants_stride;
     vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.sprite_pipeline_layout, 0, 1, &vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame], 1, &sprite_view_constants_offset);
 
-    int32 last_sprite_asset = -1;
-
-    for (uint32 sprite_instance_index = 0; sprite_instance_index < sprite_instance_count; sprite_instance_index++)
+    uint32 sprite_run_start = 0;
+    while (sprite_run_start < sprite_instance_count)
     {
-        Sprite* sprite = &sprite_instances[sprite_instance_index];
-
-        if ((int32)sprite->asset_index != last_sprite_asset)
-        {
-            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.sprite_pipeline_layout, 1, 1, &vulkan_state.descriptor_sets[sprite->asset_index], 0, 0);
-            last_sprite_asset = (int32)sprite->asset_index;
-        }
-
-        float model_matrix[16];
-        Vec4 identity_quaternion = { 0.0f, 0.0f, 0.0f, 1.0f };
-        mat4BuildTRS(model_matrix, sprite->coords, identity_quaternion, sprite->size);
-
-        SpritePushConstants sprite_push_constants = {0};
-        memcpy(sprite_push_constants.model, model_matrix, sizeof(sprite_push_constants.model));
-        sprite_push_constants.uv_rect = sprite->uv;
-        sprite_push_constants.color = (Vec4){ 0.0f, 0.0f, 0.0f, sprite->alpha };
+        uint32 run_asset_index = sprite_instances[sprite_run_start].asset_index;
+        uint32 sprite_run_end = sprite_run_start + 1;
+        while (sprite_run_end < sprite_instance_count && sprite_instances[sprite_run_end].asset_index == run_asset_index) sprite_run_end++;
 
-        vkCmdPushConstants(command_buffer, vulkan_state.sprite_pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(SpritePushConstants), &sprite_push_constants);
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.sprite_pipeline_layout, 1, 1, &vulkan_state.descriptor_sets[run_asset_index], 0, 0);
+        vkCmdDrawIndexed(command_buffer, vulkan_state.sprite_index_count, sprite_run_end - sprite_run_start, 0, 0, sprite_run_start);
 
-        vkCmdDrawIndexed(command_buffer, vulkan_state.sprite_index_count, 1, 0, 0, 0);
+        sprite_run_start = sprite_run_end;
     }
 
     // debug quad
@@ -6468,10 +9533,6 @@ void vulkanDraw(bool do_profiling_output)
     {
         vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.sprite_pipeline);
 
-        VkDeviceSize debug_vertex_offset = 0;
-        vkCmdBindVertexBuffers(command_buffer, 0, 1, &vulkan_state.sprite_vertex_buffer, &debug_vertex_offset);
-        vkCmdBindIndexBuffer(command_buffer, vulkan_state.sprite_index_buffer, 0, VK_INDEX_TYPE_UINT32);
-
         uint32 debug_view_constants_offset = VIEW_SPRITE * vulkan_state.view_constants_stride;
         vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkan_state.sprite_pipeline_layout, 0, 1, &vulkan_state.view_constants_descriptor_sets[vulkan_state.current_frame], 1, &debug_view_constants_offset);
 
@@ -6480,25 +9541,15 @@ void vulkanDraw(bool do_profiling_output)
 
         float debug_size = 300.0f;
         float debug_margin = 10.0f;
-        Vec3 debug_coords =
-        {
-            (float)vulkan_state.swapchain_extent.width  - debug_margin - debug_size * 0.5f,
-            (float)vulkan_state.swapchain_extent.height - debug_margin - debug_size * 0.5f,
-            0.0f,
-        };
-        Vec3 debug_scale = { debug_size, debug_size, 1.0f };
-
-        float debug_model[16];
-        Vec4 identity_quaternion = { 0.0f, 0.0f, 0.0f, 1.0f };
-        mat4BuildTRS(debug_model, debug_coords, identity_quaternion, debug_scale);
 
-        SpritePushConstants debug_pc = {0};
-        memcpy(debug_pc.model, debug_model, sizeof(debug_pc.model));
-        debug_pc.uv_rect = (Vec4){ 0.0f, 0.0f, 1.0f, 1.0f };
-        debug_pc.color   = (Vec4){ 0.0f, 0.0f, 0.0f, 1.0f }; // opaque
+        // written into the slot after this frame's sprites, which vulkanSubmitFrame always leaves free
+        SpriteInstanceData* debug_instance = &((SpriteInstanceData*)vulkan_state.sprite_instance_mappeds[vulkan_state.current_frame])[sprite_instance_count];
+        debug_instance->coords = (Vec3){ (float)vulkan_state.swapchain_extent.width  - debug_margin - debug_size * 0.5f, (float)vulkan_state.swapchain_extent.height - debug_margin - debug_size * 0.5f, 0.0f };
+        debug_instance->alpha = 1.0f; // opaque
+        debug_instance->uv_rect = (Vec4){ 0.0f, 0.0f, 1.0f, 1.0f };
+        debug_instance->size = (Vec2){ debug_size, debug_size };
 
-        vkCmdPushConstants(command_buffer, vulkan_state.sprite_pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(SpritePushConstants), &debug_pc);
-        vkCmdDrawIndexed(command_buffer, vulkan_state.sprite_index_count, 1, 0, 0, 0);
+        vkCmdDrawIndexed(command_buffer, vulkan_state.sprite_index_count, 1, 0, 0, sprite_instance_count);
     }
     */
 
@@ -6563,22 +9614,40 @@ void vulkanDraw(bool do_profiling_output)
     uint32 read_pool_index = (vulkan_state.timestamp_frame_index + 1) % 3;
     if (vulkan_state.timestamp_pool_valid[read_pool_index])
     {
-        if (do_profiling_output)
+        // every frame is read, so the output is a per frame average of each region rather than one noisy frame
+        uint32 count = vulkan_state.timestamp_query_counts[read_pool_index];
+        uint64* t = vulkan_state.timestamp_results[read_pool_index];
+        if (vkGetQueryPoolResults(vulkan_state.logical_device_handle, vulkan_state.timestamp_query_pools[read_pool_index], 0, count, sizeof(uint64) * count, t, sizeof(uint64), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS)
+        {
+            for (uint32 i = 0; i + 1 < count && i / 2 < 16; i += 2) vulkan_state.region_time_total_ms[i/2] += (double)(t[i+1] - t[i]) * vulkan_state.timestamp_period / 1e6;
+            vulkan_state.region_time_frame_count++;
+        }
+
+        if (do_profiling_output && vulkan_state.region_time_frame_count > 0)
         {
-            uint32 count = vulkan_state.timestamp_query_counts[read_pool_index];
-            vkGetQueryPoolResults(vulkan_state.logical_device_handle, vulkan_state.timestamp_query_pools[read_pool_index], 0, count, sizeof(uint64) * count, vulkan_state.timestamp_results[read_pool_index], sizeof(uint64), VK_QUERY_RESULT_64_BIT);
-            uint64* t = vulkan_state.timestamp_results[read_pool_index];
             char* region_names[] = { "fft", "setup", "shadow", "reflection", "scene", "outline", "scene copy", "water", "overlay" };
+            uint32 region_count = sizeof(region_names) / sizeof(region_names[0]);
+            if (count / 2 < region_count) region_count = count / 2;
 
             OutputDebugStringA("RENDERER:\n");
-            for (uint32 i = 0; i + 1 < count; i += 2)
+            for (uint32 region = 0; region < region_count; region++)
+            {
+                char line[128];
+                snprintf(line, sizeof(line), "%s: %.3f ms\n", region_names[region], vulkan_state.region_time_total_ms[region] / vulkan_state.region_time_frame_count);
+                OutputDebugStringA(line);
+            }
+
             {
-                double ns = (double)(t[i+1] - t[i]) * vulkan_state.timestamp_period;
-                double ms = ns / 1e6;
                 char line[128];
-                snprintf(line, sizeof(line), "%s: %.3f ms\n", region_names[i/2], ms);
+                const char* water_mode_names[WATER_MODE_COUNT] = { "baked loop", "live, reduced rate", "live, every frame" };
+                snprintf(line, sizeof(line), "averaged over %u frames. lasers: %u (%s). water: %s\n", vulkan_state.region_time_frame_count, laser_instance_count,
+                         vulkan_state.shader_mode == SHADER_MODE_WEIGHTED_BLENDED_OIT ? "weighted blended oit" : "linked list oit",
+                         water_mode_names[vulkan_state.water_mode]);
                 OutputDebugStringA(line);
             }
+            memset(vulkan_state.region_time_total_ms, 0, sizeof(vulkan_state.region_time_total_ms));
+            vulkan_state.region_time_frame_count = 0;
+
             OutputDebugStringA("\n");
         }
     }
@@ -6633,6 +9702,16 @@ void vulkanResize(uint32 width, uint32 height)
     vkDestroyBuffer(vulkan_state.logical_device_handle, vulkan_state.oit_counter_buffer, 0);
     vkFreeMemory(vulkan_state.logical_device_handle, vulkan_state.oit_counter_memory, 0);
 
+    vkDestroyFramebuffer(vulkan_state.logical_device_handle, vulkan_state.wboit_framebuffer, 0);
+
+    vkDestroyImageView(vulkan_state.logical_device_handle, vulkan_state.wboit_accumulation_view, 0);
+    vkDestroyImage(vulkan_state.logical_device_handle, vulkan_state.wboit_accumulation_image, 0);
+    vkFreeMemory(vulkan_state.logical_device_handle, vulkan_state.wboit_accumulation_memory, 0);
+
+    vkDestroyImageView(vulkan_state.logical_device_handle, vulkan_state.wboit_revealage_view, 0);
+    vkDestroyImage(vulkan_state.logical_device_handle, vulkan_state.wboit_revealage_image, 0);
+    vkFreeMemory(vulkan_state.logical_device_handle, vulkan_state.wboit_revealage_memory, 0);
+
     // destroy reflection resources
     vkDestroyFramebuffer(vulkan_state.logical_device_handle, vulkan_state.reflection_framebuffer, 0);
 
@@ -31,6 +31,236 @@ void pushTextChar(Input *in, uint32 codepoint)
     }
 }
 
+// RENDER THREAD
+
+// per tick snapshots go through a triple buffer: the simulation writes one slot, the newest finished snapshot waits in another, and
+// the render thread reads the third. a fourth slot lets the render thread hold on to the snapshot before the newest, to interpolate
+// between the two. publishing and taking are each a single exchange of the ready slot, so neither side ever waits on the other.
+// the draw list goes through its own triple buffer of scenes the same way; only the newest scene is drawn, so it needs no fourth.
+#define RENDER_SNAPSHOT_SLOT_COUNT 4
+#define RENDER_SCENE_SLOT_COUNT 3
+#define RENDER_SNAPSHOT_FRESH 0x100 // set on a ready slot when it holds something the render thread hasn't taken yet
+
+RenderSnapshot render_snapshots[RENDER_SNAPSHOT_SLOT_COUNT] = {0};
+int32 render_write_slot = 0; // simulation thread only
+volatile LONG render_ready_slot = 1;
+int32 render_latest_slot = 2; // render thread only
+int32 render_previous_slot = 3; // render thread only
+
+RenderScene render_scenes[RENDER_SCENE_SLOT_COUNT] = {0};
+int32 render_write_scene = 0; // simulation thread only
+volatile LONG render_ready_scene = 1;
+int32 render_read_scene = 2; // render thread only
+
+// the paint texture is too big to copy every tick, so there is one copy for the render thread, refreshed only when the game has
+// painted since. the render thread holds it shared while drawing; a publish that finds it busy leaves it for the next tick
+WaterPaintTexture render_paint_texture = {0};
+SRWLOCK render_paint_lock = SRWLOCK_INIT;
+
+volatile LONG render_pending_size = 0; // MAKELONG(width, height) of a resize the render thread hasn't applied yet, 0 if none
+
+double platformSeconds()
+{
+    LARGE_INTEGER ticks_per_second, now;
+    QueryPerformanceFrequency(&ticks_per_second);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)ticks_per_second.QuadPart;
+}
+
+// sleeps until wake_time, in platformSeconds
+void sleepUntil(HANDLE timer, double wake_time)
+{
+    double sleep_seconds = wake_time - platformSeconds();
+    if (timer && sleep_seconds > 0.0)
+    {
+        LARGE_INTEGER due;
+        due.QuadPart = -(LONGLONG)(sleep_seconds * 1e7);
+        SetWaitableTimer(timer, &due, 0, 0, 0, FALSE);
+        WaitForSingleObject(timer, INFINITE);
+    }
+}
+
+// fps cap. sleeps off whatever is left of target_frame_seconds since work_start
+void sleepUntilFrameEnd(HANDLE frame_timer, LARGE_INTEGER work_start)
+{
+    LARGE_INTEGER ticks_per_second;
+    QueryPerformanceFrequency(&ticks_per_second);
+    sleepUntil(frame_timer, (double)work_start.QuadPart / (double)ticks_per_second.QuadPart + target_frame_seconds);
+}
+
+// called by the simulation thread once per tick. the draw list and transforms are copied, so the game can start on the next tick
+// straight away. the scene goes first, so a render thread that takes a snapshot is never left with an older scene than it
+void renderPublishSnapshot(DrawCommand* draw_commands, int32 draw_command_count, RendererInfo renderer_info, bool do_profiling_output)
+{
+    const WaterPaintTexture* live_paint_texture = renderer_info.water_paint_texture;
+    if (live_paint_texture && render_paint_texture.generation != live_paint_texture->generation && TryAcquireSRWLockExclusive(&render_paint_lock))
+    {
+        memcpy(&render_paint_texture, live_paint_texture, sizeof(WaterPaintTexture));
+        ReleaseSRWLockExclusive(&render_paint_lock);
+    }
+
+    RenderScene* scene = &render_scenes[render_write_scene];
+    memcpy(scene->draw_commands, draw_commands, draw_command_count * sizeof(DrawCommand));
+    scene->draw_command_count = draw_command_count;
+    scene->renderer_info = renderer_info;
+    scene->renderer_info.water_paint_texture = live_paint_texture ? &render_paint_texture : 0;
+    scene->do_profiling_output = do_profiling_output;
+
+    LONG old_ready_scene = InterlockedExchange(&render_ready_scene, render_write_scene | RENDER_SNAPSHOT_FRESH);
+    render_write_scene = old_ready_scene & ~RENDER_SNAPSHOT_FRESH;
+
+    RenderSnapshot* snapshot = &render_snapshots[render_write_slot];
+    snapshot->transform_count = 0;
+    for (int32 command_index = 0; command_index < draw_command_count && snapshot->transform_count < MAX_INTERPOLATED_DRAWS; command_index++)
+    {
+        DrawCommand* command = &draw_commands[command_index];
+        if (command->interpolation_id <= 0) continue;
+
+        InterpolatedTransform* transform = &snapshot->transforms[snapshot->transform_count++];
+        transform->interpolation_id = command->interpolation_id;
+        transform->coords = command->coords;
+        transform->scale = command->scale;
+        transform->rotation = command->rotation;
+        transform->start_clip_plane = command->start_clip_plane;
+        transform->end_clip_plane = command->end_clip_plane;
+    }
+    snapshot->camera = renderer_info.camera;
+    snapshot->time = renderer_info.time;
+    snapshot->continuity_generation = renderer_info.continuity_generation;
+    snapshot->publish_time = platformSeconds();
+
+    LONG old_ready_slot = InterlockedExchange(&render_ready_slot, render_write_slot | RENDER_SNAPSHOT_FRESH);
+    render_write_slot = old_ready_slot & ~RENDER_SNAPSHOT_FRESH;
+}
+
+DWORD WINAPI renderThreadMain(LPVOID parameter)
+{
+    (void)parameter;
+    static DrawCommand interpolated_draw_commands[MAX_DRAW_COMMANDS];
+    int32 snapshots_taken = 0;
+    HANDLE frame_timer = CreateWaitableTimerExW(0, 0, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+    while (true)
+    {
+        LARGE_INTEGER work_start;
+        QueryPerformanceCounter(&work_start);
+
+        LONG pending_size = InterlockedExchange(&render_pending_size, 0);
+        if (pending_size != 0) vulkanResize(LOWORD(pending_size), HIWORD(pending_size));
+
+        // reload all models changed on disk
+        vulkanReloadChangedModels();
+
+        // take the newest snapshot if there is one, then the newest scene. the oldest slot we hold goes back to the simulation
+        bool do_profiling_output = false;
+        if (render_ready_slot & RENDER_SNAPSHOT_FRESH)
+        {
+            LONG taken_slot = InterlockedExchange(&render_ready_slot, render_previous_slot);
+            render_previous_slot = render_latest_slot;
+            render_latest_slot = taken_slot & ~RENDER_SNAPSHOT_FRESH;
+            snapshots_taken++;
+        }
+        if (render_ready_scene & RENDER_SNAPSHOT_FRESH)
+        {
+            LONG taken_scene = InterlockedExchange(&render_ready_scene, render_read_scene);
+            render_read_scene = taken_scene & ~RENDER_SNAPSHOT_FRESH;
+            do_profiling_output = render_scenes[render_read_scene].do_profiling_output;
+        }
+        if (snapshots_taken == 0)
+        {
+            Sleep(1);
+            continue;
+        }
+
+        // draw one tick behind the simulation: at the moment the newest snapshot arrives we are showing the one before it,
+        // and we reach the newest just as the next one is due
+        RenderSnapshot* latest = &render_snapshots[render_latest_slot];
+        RenderSnapshot* previous = 0;
+        float t = 1.0f;
+        if (snapshots_taken > 1)
+        {
+            previous = &render_snapshots[render_previous_slot];
+            double interval = latest->publish_time - previous->publish_time;
+            if (interval > 0.0) t = (float)((platformSeconds() - latest->publish_time) / interval);
+            if (t < 0.0f) t = 0.0f;
+            if (t > 1.0f) t = 1.0f;
+        }
+
+        RendererInfo renderer_info;
+        int32 draw_command_count = gameInterpolateSnapshots(previous, latest, &render_scenes[render_read_scene], t, interpolated_draw_commands, &renderer_info);
+
+        LARGE_INTEGER t_before_submit, t_after_submit, t_after_draw;
+        QueryPerformanceCounter(&t_before_submit);
+        vulkanSubmitFrame(interpolated_draw_commands, draw_command_count, renderer_info);
+        QueryPerformanceCounter(&t_after_submit);
+        AcquireSRWLockShared(&render_paint_lock); // vulkanDraw uploads the paint texture when it has changed
+        vulkanDraw(do_profiling_output);
+        ReleaseSRWLockShared(&render_paint_lock);
+        QueryPerformanceCounter(&t_after_draw);
+
+        if (do_profiling_output)
+        {
+            LARGE_INTEGER ticks_per_second;
+            QueryPerformanceFrequency(&ticks_per_second);
+            double submit_ms = 1000.0 * (double)(t_after_submit.QuadPart - t_before_submit.QuadPart) / (double)ticks_per_second.QuadPart;
+            double draw_ms   = 1000.0 * (double)(t_after_draw.QuadPart   - t_after_submit.QuadPart)  / (double)ticks_per_second.QuadPart;
+
+            char overview[256];
+            snprintf(overview, sizeof(overview), "RENDER:\nsubmit: %.2f ms; draw: %.2f ms; total: %.2f ms\n\n", submit_ms, draw_ms, submit_ms + draw_ms);
+            OutputDebugStringA(overview);
+        }
+
+        sleepUntilFrameEnd(frame_timer, work_start);
+    }
+}
+
+// SIMULATION THREAD
+
+// the window thread gathers input into simulation_input between ticks; each tick takes it and clears the per tick parts
+Input simulation_input = {0};
+SRWLOCK simulation_input_lock = SRWLOCK_INIT;
+volatile LONG simulation_result = GAME_GAMEPLAY; // the last tick's GameResult, for the window thread's cursor handling
+volatile LONG simulation_pending_size = 0; // same as render_pending_size, for gameRedraw
+
+const double MAX_SIMULATION_LAG = 0.1; // further behind than this, ticks are dropped rather than caught up, like gameFrame's delta clamp
+
+// runs the game at a fixed GAME_TICK_SECONDS, independent of how fast the window or the render thread go, and publishes a render
+// snapshot every tick. ticks are scheduled from when the last one was due rather than when it finished, so the rate doesn't drift
+DWORD WINAPI simulationThreadMain(LPVOID parameter)
+{
+    (void)parameter;
+    HANDLE tick_timer = CreateWaitableTimerExW(0, 0, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    double next_tick_time = platformSeconds();
+
+    while (true)
+    {
+        LONG pending_size = InterlockedExchange(&simulation_pending_size, 0);
+        if (pending_size != 0)
+        {
+            DisplayInfo resized_display = display_info;
+            resized_display.client_width = LOWORD(pending_size);
+            resized_display.client_height = HIWORD(pending_size);
+            gameRedraw(resized_display);
+        }
+
+        AcquireSRWLockExclusive(&simulation_input_lock);
+        Input tick_input = simulation_input;
+        simulation_input.mouse_dx = 0;
+        simulation_input.mouse_dy = 0;
+        simulation_input.mouse_scroll_this_frame = 0;
+        simulation_input.text.count = 0;
+        ReleaseSRWLockExclusive(&simulation_input_lock);
+
+        GameResult game_result = gameFrame(GAME_TICK_SECONDS, &tick_input);
+        InterlockedExchange(&simulation_result, (LONG)game_result);
+        if (game_result == GAME_QUIT) return 0;
+
+        next_tick_time += GAME_TICK_SECONDS;
+        if (platformSeconds() - next_tick_time > MAX_SIMULATION_LAG) next_tick_time = platformSeconds();
+        sleepUntil(tick_timer, next_tick_time);
+    }
+}
+
 LRESULT CALLBACK windowMessageProcessor(
     HWND window_handle, 
     UINT message_id,
@@ -66,8 +296,8 @@ LRESULT CALLBACK windowMessageProcessor(
             {
                 display_info.client_width = LOWORD(lParam);
                 display_info.client_height = HIWORD(lParam);
-                vulkanResize(LOWORD(lParam), HIWORD(lParam));
-                gameRedraw(display_info);
+                InterlockedExchange(&render_pending_size, (LONG)lParam); // applied by the render thread, which owns the swapchain
+                InterlockedExchange(&simulation_pending_size, (LONG)lParam); // and by the simulation thread, which owns the game
             }
             return 0;
         }
@@ -165,6 +395,372 @@ uint64 pollKeys()
     return held;
 }
 
+// JOBS
+
+#define MAX_JOB_THREADS 32
+#define JOB_DEQUE_CAPACITY 4096 // per thread. power of two
+#define JOB_SPIN_COUNT 2000 // how many empty polls before an idle worker, or a thread in jobsWait, goes to sleep
+
+typedef struct Job
+{
+    JobFunction* function;
+    void* data;
+    JobCounter* counter;
+}
+Job;
+
+// locked ring deque: owner pushes / pops at the bottom, thieves take from the top. deliberately not a lock free
+// (chase-lev) deque: an uncontended srw lock is cheap next to the jobs this runs, and much simpler to get right
+typedef struct JobDeque
+{
+    SRWLOCK lock;
+    Job jobs[JOB_DEQUE_CAPACITY];
+    int64 top;
+    int64 bottom;
+}
+JobDeque;
+
+JobDeque job_deques[MAX_JOB_THREADS] = {0};
+int32 job_thread_count = 1;
+volatile LONG jobs_queued = 0; // pushed but not yet taken, across all deques
+volatile LONG jobs_sleeping = 0;
+SRWLOCK jobs_sleep_lock = SRWLOCK_INIT;
+CONDITION_VARIABLE jobs_wake_condition = CONDITION_VARIABLE_INIT;
+volatile LONG jobs_waiting = 0; // threads asleep in jobsWait
+CONDITION_VARIABLE jobs_waiting_condition = CONDITION_VARIABLE_INIT; // a counter reached zero, or a job was queued
+__declspec(thread) int32 job_thread_index = 0; // main thread, and any thread the job system didn't start, use deque 0
+
+bool jobDequePush(JobDeque* deque, Job job)
+{
+    bool pushed = false;
+    AcquireSRWLockExclusive(&deque->lock);
+    if (deque->bottom - deque->top < JOB_DEQUE_CAPACITY)
+    {
+        deque->jobs[deque->bottom & (JOB_DEQUE_CAPACITY - 1)] = job;
+        deque->bottom++;
+        pushed = true;
+    }
+    ReleaseSRWLockExclusive(&deque->lock);
+    return pushed;
+}
+
+bool jobDequePop(JobDeque* deque, Job* job)
+{
+    bool popped = false;
+    AcquireSRWLockExclusive(&deque->lock);
+    if (deque->bottom > deque->top)
+    {
+        deque->bottom--;
+        *job = deque->jobs[deque->bottom & (JOB_DEQUE_CAPACITY - 1)];
+        popped = true;
+    }
+    ReleaseSRWLockExclusive(&deque->lock);
+    return popped;
+}
+
+bool jobDequeSteal(JobDeque* deque, Job* job)
+{
+    bool stolen = false;
+    AcquireSRWLockExclusive(&deque->lock);
+    if (deque->bottom > deque->top)
+    {
+        *job = deque->jobs[deque->top & (JOB_DEQUE_CAPACITY - 1)];
+        deque->top++;
+        stolen = true;
+    }
+    ReleaseSRWLockExclusive(&deque->lock);
+    return stolen;
+}
+
+// own deque first (newest job, still warm in cache), then the oldest job of the others
+bool takeJob(Job* job)
+{
+    if (jobs_queued == 0) return false;
+    bool taken = jobDequePop(&job_deques[job_thread_index], job);
+    for (int32 offset = 1; !taken && offset < job_thread_count; offset++)
+    {
+        taken = jobDequeSteal(&job_deques[(job_thread_index + offset) % job_thread_count], job);
+    }
+    if (taken) InterlockedDecrement(&jobs_queued);
+    return taken;
+}
+
+// taking the lock orders the wake after any waiter's final check, same as for sleeping workers
+void wakeJobWaiters()
+{
+    AcquireSRWLockExclusive(&jobs_sleep_lock);
+    ReleaseSRWLockExclusive(&jobs_sleep_lock);
+    WakeAllConditionVariable(&jobs_waiting_condition);
+}
+
+void runJob(Job job)
+{
+    job.function(job.data);
+    if (InterlockedDecrement(&job.counter->pending) == 0 && jobs_waiting > 0) wakeJobWaiters();
+}
+
+DWORD WINAPI jobWorkerMain(LPVOID parameter)
+{
+    job_thread_index = (int32)(intptr_t)parameter;
+    int32 idle_polls = 0;
+    while (true)
+    {
+        Job job;
+        if (takeJob(&job))
+        {
+            runJob(job);
+            idle_polls = 0;
+            continue;
+        }
+        if (++idle_polls < JOB_SPIN_COUNT)
+        {
+            YieldProcessor();
+            continue;
+        }
+
+        // sleeping is counted before the final check, so a push either sees the sleeper or the sleeper sees the push
+        AcquireSRWLockExclusive(&jobs_sleep_lock);
+        InterlockedIncrement(&jobs_sleeping);
+        while (jobs_queued == 0) SleepConditionVariableSRW(&jobs_wake_condition, &jobs_sleep_lock, INFINITE, 0);
+        InterlockedDecrement(&jobs_sleeping);
+        ReleaseSRWLockExclusive(&jobs_sleep_lock);
+        idle_polls = 0;
+    }
+}
+
+void jobsInitialize(int32 worker_count)
+{
+    if (worker_count <= 0)
+    {
+        SYSTEM_INFO system_info;
+        GetSystemInfo(&system_info);
+        worker_count = (int32)system_info.dwNumberOfProcessors - 1;
+    }
+    if (worker_count > MAX_JOB_THREADS - 1) worker_count = MAX_JOB_THREADS - 1;
+
+    for (int32 thread_index = 0; thread_index < MAX_JOB_THREADS; thread_index++) InitializeSRWLock(&job_deques[thread_index].lock);
+    job_thread_count = worker_count + 1;
+    for (int32 thread_index = 1; thread_index < job_thread_count; thread_index++)
+    {
+        HANDLE thread = CreateThread(0, 0, jobWorkerMain, (LPVOID)(intptr_t)thread_index, 0, 0);
+        CloseHandle(thread);
+    }
+}
+
+void jobsRun(JobFunction* function, void* data, JobCounter* counter)
+{
+    InterlockedIncrement(&counter->pending);
+    Job job = { function, data, counter };
+    if (!jobDequePush(&job_deques[job_thread_index], job))
+    {
+        runJob(job); // deque full: just do it now
+        return;
+    }
+    InterlockedIncrement(&jobs_queued);
+    if (jobs_sleeping > 0)
+    {
+        AcquireSRWLockExclusive(&jobs_sleep_lock);
+        ReleaseSRWLockExclusive(&jobs_sleep_lock);
+        WakeConditionVariable(&jobs_wake_condition);
+    }
+    if (jobs_waiting > 0) wakeJobWaiters(); // they help with it
+}
+
+void jobsRunBatch(JobFunction* function, void* data, int32 data_stride, int32 count, JobCounter* counter)
+{
+    for (int32 job_index = 0; job_index < count; job_index++) jobsRun(function, (uint8*)data + (int64)job_index * data_stride, counter);
+}
+
+// runs queued jobs while the counter is pending. when there are none to take, the rest are running on other threads: spin
+// for a while, then sleep until a counter reaches zero or more jobs are queued
+void jobsWait(JobCounter* counter)
+{
+    int32 idle_polls = 0;
+    while (counter->pending > 0)
+    {
+        Job job;
+        if (takeJob(&job))
+        {
+            runJob(job);
+            idle_polls = 0;
+            continue;
+        }
+        if (++idle_polls < JOB_SPIN_COUNT)
+        {
+            YieldProcessor();
+            continue;
+        }
+
+        // waiting is counted before the final check, so a finishing job either sees the waiter or the waiter sees it finished
+        AcquireSRWLockExclusive(&jobs_sleep_lock);
+        InterlockedIncrement(&jobs_waiting);
+        while (counter->pending > 0 && jobs_queued == 0) SleepConditionVariableSRW(&jobs_waiting_condition, &jobs_sleep_lock, INFINITE, 0);
+        InterlockedDecrement(&jobs_waiting);
+        ReleaseSRWLockExclusive(&jobs_sleep_lock);
+        idle_polls = 0;
+    }
+}
+
+int32 jobsThreadCount()
+{
+    return job_thread_count;
+}
+
+// scheduling overhead microbenchmark. results go to the debugger output
+
+typedef struct BenchmarkParent
+{
+    int32 child_count;
+}
+BenchmarkParent;
+
+volatile LONG benchmark_sink = 0;
+
+void benchmarkEmptyJob(void* data)
+{
+    (void)data;
+    InterlockedIncrement(&benchmark_sink);
+}
+
+void benchmarkParentJob(void* data)
+{
+    BenchmarkParent* parent = (BenchmarkParent*)data;
+    JobCounter children = {0};
+    for (int32 child_index = 0; child_index < parent->child_count; child_index++) jobsRun(benchmarkEmptyJob, 0, &children);
+    jobsWait(&children);
+}
+
+void jobsBenchmark()
+{
+    LARGE_INTEGER ticks_per_second, start, end;
+    QueryPerformanceFrequency(&ticks_per_second);
+    char output[256];
+
+    const int32 flat_job_count = 100000;
+    const int32 parent_count = 1000;
+    const int32 children_per_parent = 100;
+    const int32 repeats = 5;
+
+    for (int32 repeat = 0; repeat < repeats; repeat++)
+    {
+        // baseline: the same work, called directly
+        QueryPerformanceCounter(&start);
+        for (int32 job_index = 0; job_index < flat_job_count; job_index++) benchmarkEmptyJob(0);
+        QueryPerformanceCounter(&end);
+        double direct_ns = (double)(end.QuadPart - start.QuadPart) * 1e9 / ticks_per_second.QuadPart / flat_job_count;
+
+        // flat: main thread spawns waves of jobs, waiting on each wave (waves fit in a deque, so nothing runs inline)
+        JobCounter flat_counter = {0};
+        QueryPerformanceCounter(&start);
+        for (int32 job_index = 0; job_index < flat_job_count; job_index++)
+        {
+            jobsRun(benchmarkEmptyJob, 0, &flat_counter);
+            if (flat_counter.pending >= JOB_DEQUE_CAPACITY / 2) jobsWait(&flat_counter);
+        }
+        jobsWait(&flat_counter);
+        QueryPerformanceCounter(&end);
+        double flat_ns = (double)(end.QuadPart - start.QuadPart) * 1e9 / ticks_per_second.QuadPart / flat_job_count;
+
+        // nested: parents spawn children and wait on them from inside a job, so work spreads by stealing
+        static BenchmarkParent parents[1000];
+        for (int32 parent_index = 0; parent_index < parent_count; parent_index++) parents[parent_index].child_count = children_per_parent;
+        JobCounter parent_counter = {0};
+        QueryPerformanceCounter(&start);
+        jobsRunBatch(benchmarkParentJob, parents, sizeof(BenchmarkParent), parent_count, &parent_counter);
+        jobsWait(&parent_counter);
+        QueryPerformanceCounter(&end);
+        double nested_ns = (double)(end.QuadPart - start.QuadPart) * 1e9 / ticks_per_second.QuadPart / (parent_count * (children_per_parent + 1));
+
+        snprintf(output, sizeof(output), "jobs benchmark (%d threads), run %d: direct %.1f ns/call, flat %.1f ns/job, nested %.1f ns/job\n",
+                 job_thread_count, repeat, direct_ns, flat_ns, nested_ns);
+        OutputDebugStringA(output);
+    }
+}
+
+// launches the game with -startup-exit, which only initializes the renderer, and times each run from process start to
+// exit. the first run has its pipeline cache deleted, the rest start from the cache it saved. the os file cache and the
+// driver's own shader cache stay warm throughout, so cold here means cold for this game's cache only. each run's phase
+// breakdown is in its own debug output
+void startupBenchmark()
+{
+    wchar_t executable_path[MAX_PATH];
+    GetModuleFileNameW(0, executable_path, MAX_PATH);
+    wchar_t child_command_line[MAX_PATH + 32];
+    swprintf(child_command_line, MAX_PATH + 32, L"\"%ls\" -startup-exit", executable_path);
+
+    LARGE_INTEGER ticks_per_second, start, end;
+    QueryPerformanceFrequency(&ticks_per_second);
+    char output[256];
+
+    const int32 warm_runs = 3;
+    double cold_ms = 0.0;
+    double warm_total_ms = 0.0;
+
+    vulkanDiscardPipelineCache();
+    for (int32 run = 0; run <= warm_runs; run++)
+    {
+        STARTUPINFOW startup_info = { .cb = sizeof(startup_info) };
+        PROCESS_INFORMATION process_info = {0};
+
+        QueryPerformanceCounter(&start);
+        if (!CreateProcessW(0, child_command_line, 0, 0, FALSE, 0, 0, 0, &startup_info, &process_info))
+        {
+            OutputDebugStringA("startup benchmark: could not launch the game\n");
+            return;
+        }
+        WaitForSingleObject(process_info.hProcess, INFINITE);
+        QueryPerformanceCounter(&end);
+        CloseHandle(process_info.hThread);
+        CloseHandle(process_info.hProcess);
+
+        double run_ms = (double)(end.QuadPart - start.QuadPart) * 1000.0 / ticks_per_second.QuadPart;
+        if (run == 0) cold_ms = run_ms;
+        else warm_total_ms += run_ms;
+
+        snprintf(output, sizeof(output), "startup benchmark, run %d (%s): %.1f ms\n", run, run == 0 ? "cold" : "warm", run_ms);
+        OutputDebugStringA(output);
+    }
+
+    snprintf(output, sizeof(output), "startup benchmark: cold %.1f ms, warm %.1f ms (average of %d)\n", cold_ms, warm_total_ms / warm_runs, warm_runs);
+    OutputDebugStringA(output);
+}
+
+// replays every shipped level with seeded input, checking the falling pass's column gate against the full scan. results go to the debugger output
+void fallGatingCheck()
+{
+    const int32 tick_count = 20000;
+    const uint32 seed = 0x2545F491;
+
+    WIN32_FIND_DATAA find_data;
+    HANDLE find_handle = FindFirstFileA("data/levels/*", &find_data);
+    if (find_handle == INVALID_HANDLE_VALUE)
+    {
+        OutputDebugStringA("fall gating check: no levels found\n");
+        return;
+    }
+
+    char output[256];
+    int32 level_count = 0;
+    int32 total_mismatches = 0;
+    do
+    {
+        if (!(find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) || find_data.cFileName[0] == '.') continue;
+        int32 mismatches = gameFallGatingCheck(find_data.cFileName, tick_count, seed);
+        if (mismatches > 0)
+        {
+            snprintf(output, sizeof(output), "fall gating check: %s: %d mismatches\n", find_data.cFileName, mismatches);
+            OutputDebugStringA(output);
+        }
+        total_mismatches += mismatches;
+        level_count++;
+    }
+    while (FindNextFileA(find_handle, &find_data));
+    FindClose(find_handle);
+
+    snprintf(output, sizeof(output), "fall gating check: %d levels, %d ticks each, %d mismatches\n", level_count, tick_count, total_mismatches);
+    OutputDebugStringA(output);
+}
+
 int CALLBACK WinMain(
 	HINSTANCE module_handle,
 	HINSTANCE _,
@@ -228,6 +824,62 @@ int CALLBACK WinMain(
     display_info.client_width = client_rect.right - client_rect.left;
     display_info.client_height = client_rect.bottom - client_rect.top;
 
+    jobsInitialize(0);
+
+    // profiling: measure job scheduling overhead instead of running the game
+    if (strcmp(command_line, "-job-benchmark") == 0)
+    {
+        jobsBenchmark();
+        return 0;
+    }
+
+    // profiling: batch instance transforms against the scalar matrix builders
+    if (strcmp(command_line, "-transform-benchmark") == 0)
+    {
+        transformBenchmark();
+        return 0;
+    }
+
+    // profiling: cold and warm startup, each in a fresh process that exits once the renderer is up
+    if (strcmp(command_line, "-startup-benchmark") == 0)
+    {
+        startupBenchmark();
+        return 0;
+    }
+    if (strcmp(command_line, "-startup-exit") == 0)
+    {
+        vulkanInitialize(platform_handles, display_info);
+        return 0;
+    }
+
+    // profiling: the shared memory water fft against the original per level passes
+    if (strcmp(command_line, "-fft-benchmark") == 0)
+    {
+        vulkanInitialize(platform_handles, display_info);
+        vulkanFftBenchmark();
+        return 0;
+    }
+
+    // correctness: the gated falling pass against the full scan, over every shipped level
+    if (strcmp(command_line, "-fall-gating-check") == 0)
+    {
+        gameInitialize(0, display_info);
+        fallGatingCheck();
+        return 0;
+    }
+
+    // bake models and atlases ahead of time, rather than on first load
+    if (strcmp(command_line, "-bake-models") == 0)
+    {
+        bakeModelBlobs();
+        return 0;
+    }
+    if (strcmp(command_line, "-bake-textures") == 0)
+    {
+        bakeTextureAtlases();
+        return 0;
+    }
+
     vulkanInitialize(platform_handles, display_info);
 
     LARGE_INTEGER ticks_per_second;
@@ -252,6 +904,13 @@ int CALLBACK WinMain(
 
     gameInitialize(file_path, display_info); 
 
+    // from here on, this thread only gathers input and handles the window. the simulation thread owns the game, and only the
+    // render thread touches vulkan
+    HANDLE render_thread = CreateThread(0, 0, renderThreadMain, 0, 0, 0);
+    CloseHandle(render_thread);
+    HANDLE simulation_thread = CreateThread(0, 0, simulationThreadMain, 0, 0, 0);
+    CloseHandle(simulation_thread);
+
     ShowWindow(window_handle, initial_show_state);
 
     while (running)
@@ -275,10 +934,18 @@ int CALLBACK WinMain(
         double delta_time = (current_tick.QuadPart - last_tick.QuadPart) * seconds_per_tick;
         last_tick = current_tick;
 
-        // do gameplay tick
+        // hand this frame's input to the simulation thread, adding to whatever its next tick hasn't taken yet
         input.keys_held = pollKeys();
 
-        GameResult game_result = gameFrame(delta_time, &input); 
+        AcquireSRWLockExclusive(&simulation_input_lock);
+        simulation_input.keys_held = input.keys_held;
+        simulation_input.mouse_dx += input.mouse_dx;
+        simulation_input.mouse_dy += input.mouse_dy;
+        simulation_input.mouse_scroll_this_frame += input.mouse_scroll_this_frame;
+        for (int32 char_index = 0; char_index < input.text.count; char_index++) pushTextChar(&simulation_input, input.text.codepoints[char_index]);
+        ReleaseSRWLockExclusive(&simulation_input_lock);
+
+        GameResult game_result = (GameResult)simulation_result;
 
         if (game_result == GAME_QUIT) return 0;
 
@@ -328,18 +995,7 @@ int CALLBACK WinMain(
         }
 
         // fps cap
-        LARGE_INTEGER frame_now;
-        QueryPerformanceCounter(&frame_now);
-        double frame_elapsed = (frame_now.QuadPart - work_start.QuadPart) * seconds_per_tick;
-        double sleep_seconds = target_frame_seconds - frame_elapsed;
-
-        if (frame_timer && sleep_seconds > 0.0)
-        {
-            LARGE_INTEGER due;
-            due.QuadPart = -(LONGLONG)(sleep_seconds * 1e7);
-            SetWaitableTimer(frame_timer, &due, 0, 0, 0, FALSE);
-            WaitForSingleObject(frame_timer, INFINITE);
-        }
+        sleepUntilFrameEnd(frame_timer, work_start);
     }
 
     return (int)queued_message.wParam;
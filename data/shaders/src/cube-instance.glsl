@@ -0,0 +1,50 @@
+// decoding for the packed CubeInstanceData in renderer_cereus.c. the constant mirrors CUBE_POSITION_UNITS_PER_TILE.
+// positions are relative to ViewConstants.level_aabb_min, since levels sit further from the world origin than int16 reaches
+// the 3d atlas layout comes from the loaded atlas, as ViewConstants.atlas_3d_cell
+
+const float CUBE_POSITION_UNITS_PER_TILE = 128.0;
+
+// same layout as the vertex attributes, for the cull pass which reads instances from a storage buffer
+struct CubeInstance
+{
+    uint position_xy;
+    uint position_z_atlas_cell;
+    uint rotation_xy;
+    uint rotation_zw;
+};
+
+vec3 cubeInstancePosition(CubeInstance instance, vec3 origin)
+{
+    ivec3 units = ivec3(bitfieldExtract(int(instance.position_xy), 0, 16),
+                        bitfieldExtract(int(instance.position_xy), 16, 16),
+                        bitfieldExtract(int(instance.position_z_atlas_cell), 0, 16));
+    return origin + vec3(units) / CUBE_POSITION_UNITS_PER_TILE;
+}
+
+vec4 cubeInstanceRotation(CubeInstance instance)
+{
+    return vec4(unpackSnorm2x16(instance.rotation_xy), unpackSnorm2x16(instance.rotation_zw));
+}
+
+// unit scale, so this is just the rotation and translation. snorm rounding leaves the quaternion slightly off unit
+// length, which is normalized away here
+mat4 cubeInstanceModel(vec3 position, vec4 rotation)
+{
+    vec4 q = normalize(rotation);
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    return mat4(vec4(1.0 - 2.0 * (yy + zz), 2.0 * (xy + wz), 2.0 * (xz - wy), 0.0),
+                vec4(2.0 * (xy - wz), 1.0 - 2.0 * (xx + zz), 2.0 * (yz + wx), 0.0),
+                vec4(2.0 * (xz + wy), 2.0 * (yz - wx), 1.0 - 2.0 * (xx + yy), 0.0),
+                vec4(position, 1.0));
+}
+
+// xy: atlas origin of the cell, zw: its size. atlas_3d_cell is xy: uv size of a cell, z: cells per row
+vec4 cubeAtlasRegion(uint atlas_cell, vec4 atlas_3d_cell)
+{
+    uint cells_per_row = uint(atlas_3d_cell.z);
+    vec2 origin = vec2(float(atlas_cell % cells_per_row), float(atlas_cell / cells_per_row)) * atlas_3d_cell.xy;
+    return vec4(origin, atlas_3d_cell.xy);
+}
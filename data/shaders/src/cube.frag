@@ -27,6 +27,8 @@ layout(set = 3, binding = 0) uniform sampler2DShadow shadow_map;
 layout(location = 0) in vec2 uv;
 layout(location = 1) in vec3 normal;
 layout(location = 2) in vec3 frag_world_pos;
+layout(location = 3) flat in vec4 uv_region;
+layout(location = 4) flat in float repeat_uv;
 
 layout(location = 0) out vec4 out_color;
 layout(location = 1) out vec4 out_normal;
@@ -36,7 +38,10 @@ void main()
 {
     if (view_constants.discard_below_water_plane && frag_world_pos.y < view_constants.water_plane_y) discard;
 
-    vec4 tex = texture(input_texture, uv);
+    // explicit gradients, so the jump where a repeating uv wraps doesn't pick a tiny mip
+    vec2 region_uv = repeat_uv > 0.5 ? fract(uv) : uv;
+    vec2 atlas_uv = uv_region.xy + region_uv * uv_region.zw;
+    vec4 tex = textureGrad(input_texture, atlas_uv, dFdx(uv) * uv_region.zw, dFdy(uv) * uv_region.zw);
 
     vec3 N = normalize(normal);
     vec3 L = normalize(-view_constants.light_direction.xyz);
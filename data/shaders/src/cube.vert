@@ -1,18 +1,19 @@
 #version 450
 
+#include "cube-instance.glsl"
+
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec2 input_uv;
 layout(location = 2) in vec3 input_normal;
-// ignore color in location 3
-layout(location = 4) in vec4 model_col0;
-layout(location = 5) in vec4 model_col1;
-layout(location = 6) in vec4 model_col2;
-layout(location = 7) in vec4 model_col3;
-layout(location = 8) in vec4 instance_uv_rect;
+layout(location = 3) in vec3 input_color; // only set by the static level mesh: rg = atlas origin of the face, b = 1
+layout(location = 4) in ivec4 instance_position_atlas_cell; // xyz: fixed point position, w: atlas cell
+layout(location = 5) in vec4 instance_rotation;
 
-layout(location = 0) out vec2 uv;
+layout(location = 0) out vec2 uv; // in units of the texture region. for the level mesh, one unit per tile, repeating
 layout(location = 1) out vec3 normal;
 layout(location = 2) out vec3 frag_world_pos;
+layout(location = 3) flat out vec4 uv_region; // xy: atlas origin, zw: size
+layout(location = 4) flat out float repeat_uv;
 
 layout(set = 0, binding = 0) uniform ViewConstants 
 {
@@ -29,15 +30,28 @@ layout(set = 0, binding = 0) uniform ViewConstants
     float time;
     float water_tile_length;
     float focal_length;
+    vec4 atlas_3d_cell; // xy: uv size of one cube cell, z: cells per row
 }
 view_constants;
 
 void main()
 {
-    mat4 instance_model = mat4(model_col0, model_col1, model_col2, model_col3);
+    vec3 instance_position = view_constants.level_aabb_min.xyz + vec3(instance_position_atlas_cell.xyz) / CUBE_POSITION_UNITS_PER_TILE;
+    mat4 instance_model = cubeInstanceModel(instance_position, instance_rotation);
     vec4 world_pos = instance_model * vec4(position, 1.0);
     gl_Position = view_constants.proj * view_constants.view * world_pos;
-    uv = instance_uv_rect.xy + input_uv * (instance_uv_rect.zw - instance_uv_rect.xy);
+    if (input_color.b > 0.5)
+    {
+        // level mesh face. a face is a third of a cell wide and half a cell high
+        uv_region = vec4(input_color.rg, view_constants.atlas_3d_cell.xy / vec2(3.0, 2.0));
+        repeat_uv = 1.0;
+    }
+    else
+    {
+        uv_region = cubeAtlasRegion(uint(instance_position_atlas_cell.w) & 0xFFFFu, view_constants.atlas_3d_cell);
+        repeat_uv = 0.0;
+    }
+    uv = input_uv;
     normal = vec3(instance_model * vec4(input_normal, 0.0));
     frag_world_pos = world_pos.xyz;
 }
@@ -0,0 +1,43 @@
+// radix-2 stockham inverse fft over one 256 point line held in shared memory. each of the 128 invocations owns one
+// butterfly per level, and the result comes out in natural order so no bit reversal is needed. every line carries
+// two complex signals side by side (xy and zw)
+
+#define FFT_SIZE 256
+
+shared vec4 fft_line[2][FFT_SIZE];
+
+const float PI = 3.14159265358979;
+
+vec2 complex_multiply(vec2 a, vec2 b)
+{
+    return vec2(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+// fft_line[0] must be filled before calling. returns the half the result ended up in
+int stockham_inverse(uint butterfly_index)
+{
+    memoryBarrierShared();
+    barrier();
+
+    int source = 0;
+    for (uint span = 1u; span < FFT_SIZE; span <<= 1u)
+    {
+        uint k = butterfly_index & (span - 1u);
+
+        float angle = PI * float(k) / float(span);
+        vec2 twiddle = vec2(cos(angle), sin(angle));
+
+        vec4 a = fft_line[source][butterfly_index];
+        vec4 b = fft_line[source][butterfly_index + FFT_SIZE / 2];
+        b = vec4(complex_multiply(b.xy, twiddle), complex_multiply(b.zw, twiddle));
+
+        uint dest_index = (butterfly_index << 1u) - k;
+        fft_line[1 - source][dest_index]        = a + b;
+        fft_line[1 - source][dest_index + span] = a - b;
+
+        memoryBarrierShared();
+        barrier();
+        source = 1 - source;
+    }
+    return source;
+}
@@ -0,0 +1,40 @@
+#include "laser-clip-plane.glsl"
+
+const float beam_radius = 0.40;
+const float core_radius = 0.05;
+const float glow_start = 1.2; // glow strength right at core edge
+const float falloff_exponent = 0.5; // shape only
+const float core_boost = 0.6; // rgb added inside core
+
+// beam color and glow at this fragment, shared by the linked list and weighted blended laser passes
+vec4 shadeLaser(vec3 world_pos, mat4 inverse_intersection, vec3 camera_position, vec4 start_clip_plane, vec4 end_clip_plane, vec4 instance_color, float half_length, out bool is_outline)
+{
+    vec3 frag_model    = (inverse_intersection * vec4(world_pos, 1.0)).xyz;
+    vec3 ray_origin    = (inverse_intersection * vec4(camera_position, 1.0)).xyz;
+    vec3 ray_direction = frag_model - ray_origin;
+
+    float t_closest = -(ray_origin.x * ray_direction.x + ray_origin.y * ray_direction.y) /
+                       (ray_direction.x * ray_direction.x + ray_direction.y * ray_direction.y);
+
+    vec3 closest_3d = ray_origin + t_closest * ray_direction;
+    if (closest_3d.z < -half_length) t_closest = (-half_length - ray_origin.z) / ray_direction.z;
+    if (closest_3d.z >  half_length) t_closest = ( half_length - ray_origin.z) / ray_direction.z;
+
+    t_closest = clipPlane(start_clip_plane, ray_origin, ray_direction, frag_model, t_closest);
+    t_closest = clipPlane(end_clip_plane,   ray_origin, ray_direction, frag_model, t_closest);
+
+    float closest_distance = length(ray_origin.xy + t_closest * ray_direction.xy);
+
+    float r = clamp((closest_distance - core_radius) / (beam_radius - core_radius), 0.0, 1.0);
+    float glow = glow_start * (1.0 - smoothstep(0.0, 1.0, pow(r, falloff_exponent)));
+
+    float distance_per_pixel = max(length(dFdx(closest_distance)), length(dFdy(closest_distance)));
+    is_outline = closest_distance > core_radius - 0.5 * distance_per_pixel && closest_distance < core_radius + 2.0 * distance_per_pixel;
+
+    if (closest_distance < core_radius)
+    {
+        is_outline = false;
+        return vec4(instance_color.rgb + core_boost, 1.0);
+    }
+    return vec4(instance_color.rgb, glow);
+}
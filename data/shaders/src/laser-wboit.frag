@@ -0,0 +1,54 @@
+#version 450
+
+#include "laser-shading.glsl"
+#include "linearize-depth.glsl"
+
+layout(set = 0, binding = 0) uniform ViewConstants
+{
+    mat4 view;
+    mat4 proj;
+    mat4 view_proj;
+    mat4 inv_view_proj;
+    mat4 light_view_proj;
+    vec4 camera_position;
+    vec4 light_direction;
+    vec4 level_aabb_min;
+    float water_plane_y;
+    bool discard_below_water_plane;
+    float time;
+    float water_tile_length;
+    float focal_length;
+}
+view_constants;
+
+layout(location = 0)      in vec3 world_pos;
+layout(location = 1) flat in mat4 inverse_intersection;
+layout(location = 5) flat in vec4 start_clip_plane;
+layout(location = 6) flat in vec4 end_clip_plane;
+layout(location = 7) flat in vec4 instance_color;
+layout(location = 8) flat in float half_length;
+
+layout(location = 0) out vec4 out_accumulation;
+layout(location = 1) out float out_revealage;
+
+// weighted blended OIT: no list, no sort, the scene depth is tested by the pass's read-only depth attachment
+void main()
+{
+    bool is_outline;
+    vec4 laser_color = shadeLaser(world_pos, inverse_intersection, view_constants.camera_position.xyz, start_clip_plane, end_clip_plane, instance_color, half_length, is_outline);
+
+    if (laser_color.a < 0.01) discard;
+
+    // same 8 bit clamp the linked list packs into, so both paths composite the same colors
+    laser_color = clamp(laser_color, 0.0, 1.0);
+
+    // there's no depth grouping to let a white core beat an outline, so an outline is just an opaque black fragment
+    if (is_outline) laser_color = vec4(0.0, 0.0, 0.0, 1.0);
+
+    // nearer fragments get more weight, which stands in for the sort
+    float view_depth = linearizeDepth(gl_FragCoord.z);
+    float weight = laser_color.a * clamp(10.0 / (1e-5 + pow(view_depth / 5.0, 2.0) + pow(view_depth / 200.0, 6.0)), 1e-2, 3e3);
+
+    out_accumulation = vec4(laser_color.rgb * laser_color.a, laser_color.a) * weight;
+    out_revealage = laser_color.a;
+}
@@ -1,6 +1,6 @@
 #version 450
 
-#include "laser-clip-plane.glsl"
+#include "laser-shading.glsl"
 
 layout(set = 0, binding = 0) uniform ViewConstants
 {
@@ -31,46 +31,10 @@ layout(set = 1, binding = 0, r32ui) uniform coherent uimage2D head_image;
 layout(set = 2, binding = 0) buffer FragmentPool { uvec4 fragments[]; };
 layout(set = 3, binding = 0) buffer AtomicCounter { uint counter; };
 
-const float beam_radius = 0.40;
-const float core_radius = 0.05;
-const float glow_start = 1.2; // glow strength right at core edge
-const float falloff_exponent = 0.5; // shape only
-const float core_boost = 0.6; // rgb added inside core
-
 void main()
 {
-    vec3 frag_model    = (inverse_intersection * vec4(world_pos, 1.0)).xyz;
-    vec3 ray_origin    = (inverse_intersection * vec4(view_constants.camera_position.xyz, 1.0)).xyz;
-    vec3 ray_direction = frag_model - ray_origin;
-
-    float t_closest = -(ray_origin.x * ray_direction.x + ray_origin.y * ray_direction.y) /
-                       (ray_direction.x * ray_direction.x + ray_direction.y * ray_direction.y);
-
-    vec3 closest_3d = ray_origin + t_closest * ray_direction;
-    if (closest_3d.z < -half_length) t_closest = (-half_length - ray_origin.z) / ray_direction.z;
-    if (closest_3d.z >  half_length) t_closest = ( half_length - ray_origin.z) / ray_direction.z;
-
-    t_closest = clipPlane(start_clip_plane, ray_origin, ray_direction, frag_model, t_closest);
-    t_closest = clipPlane(end_clip_plane,   ray_origin, ray_direction, frag_model, t_closest);
-
-    float closest_distance = length(ray_origin.xy + t_closest * ray_direction.xy);
-
-    float r = clamp((closest_distance - core_radius) / (beam_radius - core_radius), 0.0, 1.0);
-    float glow = glow_start * (1.0 - smoothstep(0.0, 1.0, pow(r, falloff_exponent)));
-
-    float distance_per_pixel = max(length(dFdx(closest_distance)), length(dFdy(closest_distance)));
-    bool is_outline = closest_distance > core_radius - 0.5 * distance_per_pixel && closest_distance < core_radius + 2.0 * distance_per_pixel;
-
-    vec4 laser_color;
-    if (closest_distance < core_radius)
-    {
-        laser_color = vec4(instance_color.rgb + core_boost, 1.0);
-        is_outline  = false;
-    }
-    else
-    {
-        laser_color = vec4(instance_color.rgb, glow);
-    }
+    bool is_outline;
+    vec4 laser_color = shadeLaser(world_pos, inverse_intersection, view_constants.camera_position.xyz, start_clip_plane, end_clip_plane, instance_color, half_length, is_outline);
 
     if (laser_color.a < 0.01) discard;
 
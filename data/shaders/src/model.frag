@@ -26,18 +26,12 @@ layout(set = 2, binding = 0) uniform sampler2DShadow shadow_map;
 layout(location = 0) in vec3 normal;
 layout(location = 1) in vec3 color;
 layout(location = 2) in vec3 frag_world_pos;
+layout(location = 3) flat in vec3 tint;
 
 layout(location = 0) out vec4 out_color;
 layout(location = 1) out vec4 out_normal;
 layout(location = 2) out vec4 out_reflection_distance;
 
-layout(push_constant) uniform PushConstants
-{
-    mat4 model;
-    vec4 tint;
-} 
-pc;
-
 void main()
 {
     if (view_constants.discard_below_water_plane && frag_world_pos.y < view_constants.water_plane_y) discard;
@@ -52,7 +46,7 @@ void main()
     float lighting = mix(0.2, 1.0, direct);
 
     float tint_amount = 0.3;
-    out_color  = vec4(color * lighting + (pc.tint.xyz * tint_amount), 1.0);
+    out_color  = vec4(color * lighting + (tint * tint_amount), 1.0);
     out_normal = vec4(N, 0.0);
     out_reflection_distance = vec4(length((view_constants.view * vec4(frag_world_pos, 1.0)).xyz), 0.0, 0.0, 0.0);
 }
@@ -8,6 +8,7 @@ layout(location = 3) in vec3 input_color;
 layout(location = 0) out vec3 normal;
 layout(location = 1) out vec3 color;
 layout(location = 2) out vec3 frag_world_pos;
+layout(location = 3) flat out vec3 tint;
 
 layout(set = 0, binding = 0) uniform ViewConstants 
 {
@@ -27,18 +28,24 @@ layout(set = 0, binding = 0) uniform ViewConstants
 }
 view_constants;
 
-layout(push_constant) uniform PushConstants
+struct ModelInstance
 {
     mat4 model;
     vec4 color;
-} 
-pc;
+};
+
+layout(std430, set = 3, binding = 0) readonly buffer ModelInstances
+{
+    ModelInstance instances[];
+};
 
 void main()
 {
-    vec4 world_pos = pc.model * vec4(position, 1.0);
+    ModelInstance instance = instances[gl_InstanceIndex]; // includes the draw's first instance
+    vec4 world_pos = instance.model * vec4(position, 1.0);
     gl_Position = view_constants.proj * view_constants.view * world_pos;
-    normal = mat3(pc.model) * input_normal;
+    normal = mat3(instance.model) * input_normal;
     color = input_color;
+    tint = instance.color.xyz;
 	frag_world_pos = world_pos.xyz;
 }
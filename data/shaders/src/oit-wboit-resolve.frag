@@ -0,0 +1,22 @@
+#version 450
+
+layout(set = 0, binding = 0) uniform sampler2D accumulation_image;
+layout(set = 1, binding = 0) uniform sampler2D revealage_image;
+
+layout(location = 0) out vec4 out_color;
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+
+    // revealage is the product of (1 - alpha) over every laser fragment here, cleared to 1
+    float revealage = texelFetch(revealage_image, pixel, 0).r;
+    if (revealage >= 1.0) discard;
+
+    vec4 accumulation = texelFetch(accumulation_image, pixel, 0);
+    vec3 average_color = accumulation.rgb / max(accumulation.a, 1e-5);
+
+    // premultiplied, blended over the scene like the linked list resolve
+    float alpha = 1.0 - revealage;
+    out_color = vec4(average_color * alpha, alpha);
+}
@@ -1,11 +1,11 @@
 #version 450
 
+#include "cube-instance.glsl"
+
 layout(location = 0) in vec3 in_position;
 
-layout(location = 4) in vec4 instance_model_column_0;
-layout(location = 5) in vec4 instance_model_column_1;
-layout(location = 6) in vec4 instance_model_column_2;
-layout(location = 7) in vec4 instance_model_column_3;
+layout(location = 4) in ivec4 instance_position_atlas_cell;
+layout(location = 5) in vec4 instance_rotation;
 
 layout(set = 0, binding = 0) uniform ViewConstants 
 {
@@ -27,6 +27,7 @@ view_constants;
 
 void main()
 {
-    mat4 model = mat4(instance_model_column_0, instance_model_column_1, instance_model_column_2, instance_model_column_3);
+    vec3 instance_position = view_constants.level_aabb_min.xyz + vec3(instance_position_atlas_cell.xyz) / CUBE_POSITION_UNITS_PER_TILE;
+    mat4 model = cubeInstanceModel(instance_position, instance_rotation);
     gl_Position = view_constants.light_view_proj * model * vec4(in_position, 1.0);
 }
@@ -20,13 +20,18 @@ layout(set = 0, binding = 0) uniform ViewConstants
 }
 view_constants;
 
-layout(push_constant) uniform ShadowPushConstants
+struct ModelInstance
 {
     mat4 model;
-}
-pc;
+    vec4 color;
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer ModelInstances
+{
+    ModelInstance instances[];
+};
 
 void main()
 {
-    gl_Position = view_constants.light_view_proj * pc.model * vec4(in_position, 1.0);
+    gl_Position = view_constants.light_view_proj * instances[gl_InstanceIndex].model * vec4(in_position, 1.0);
 }
@@ -21,20 +21,13 @@ view_constants;
 layout(set = 1, binding = 0) uniform sampler2D tex;
 
 layout(location = 0) in vec2 uv;
+layout(location = 1) flat in float alpha;
 
 layout(location = 0) out vec4 out_color;
 
-layout(push_constant) uniform PC 
-{
-    mat4 model;
-    vec4 uv_rect;
-    vec4 color;
-}
-pc;
-
 void main()
 {
     vec4 color = texture(tex, uv);
-    color.a *= pc.color.w;
+    color.a *= alpha;
     out_color = color;
 }
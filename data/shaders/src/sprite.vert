@@ -20,21 +20,20 @@ view_constants;
 
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec2 input_uv;
-layout(location = 2) in vec3 input_normal; // still declared to match vertex format, but unused
 
-layout(location = 0) out vec2 uv;
+// per instance
+layout(location = 4) in vec4 in_coords_alpha;
+layout(location = 5) in vec4 in_uv_rect;
+layout(location = 6) in vec2 in_size;
 
-layout(push_constant) uniform PC 
-{
-    mat4 model;
-    vec4 uv_rect;
-    vec4 color;
-}
-pc;
+layout(location = 0) out vec2 uv;
+layout(location = 1) flat out float alpha;
 
 void main()
 {
-    mat4 mvp = view_constants.view_proj * pc.model;
-    gl_Position = mvp * vec4(position, 1.0);
-    uv = pc.uv_rect.xy + input_uv * (pc.uv_rect.zw - pc.uv_rect.xy);
+    // sprites are never rotated, so the model matrix is just a scale and a translation
+    vec3 world_position = in_coords_alpha.xyz + vec3(position.xy * in_size, position.z);
+    gl_Position = view_constants.view_proj * vec4(world_position, 1.0);
+    uv = in_uv_rect.xy + input_uv * (in_uv_rect.zw - in_uv_rect.xy);
+    alpha = in_coords_alpha.w;
 }
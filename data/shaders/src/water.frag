@@ -30,7 +30,7 @@ view_constants;
 layout(set = 1, binding = 0) uniform sampler2D scene_texture;
 layout(set = 2, binding = 0) uniform sampler2D depth_texture;
 layout(set = 3, binding = 0) uniform sampler2D paint_texture;
-layout(set = 4, binding = 0) uniform sampler2D water_texture;
+layout(set = 4, binding = 0) uniform sampler2DArray water_frames; // normal rgb, height a
 layout(set = 5, binding = 0) uniform sampler2D reflection_texture;
 layout(set = 6, binding = 0) uniform sampler2DArray grid_texture;
 layout(set = 7, binding = 0) uniform sampler2DArray grid_normal_texture;
@@ -42,6 +42,14 @@ layout(set = 8, binding = 0) readonly buffer LaserLights
 laser_data;
 layout(set = 9, binding = 0) uniform sampler2D reflection_distance_texture;
 
+layout(push_constant) uniform PushConstants
+{
+    int frame_a;
+    int frame_b;
+    float frame_blend;
+}
+pc;
+
 layout(location = 0) in vec3 frag_world_pos;
 
 layout(location = 0) out vec4 out_color;
@@ -125,7 +133,10 @@ void main()
     
     // sample unmodified normal in order to figure out if should be grid here
     vec2 fft_uv = frag_world_pos.xz / view_constants.water_tile_length;
-    vec3 unmodified_normal = normalize(texture(water_texture, fft_uv).xyz);
+    vec3 unmodified_normal = normalize(mix(
+        texture(water_frames, vec3(fft_uv, float(pc.frame_a))).xyz,
+        texture(water_frames, vec3(fft_uv, float(pc.frame_b))).xyz,
+        pc.frame_blend));
 
     // get grid pos given movement by unmodified normals
     vec2 normal_push = unmodified_normal.xz * grid_push_by_normal;
@@ -18,7 +18,15 @@ layout(set = 0, binding = 0) uniform ViewConstants
 }
 view_constants;
 
-layout(set = 4, binding = 0) uniform sampler2D water_texture;
+layout(set = 4, binding = 0) uniform sampler2DArray water_frames; // normal rgb, height a
+
+layout(push_constant) uniform PushConstants
+{
+    int frame_a;
+    int frame_b;
+    float frame_blend;
+}
+pc;
 
 layout(location = 0) in vec3 in_position;
 layout(location = 1) in vec2 in_uv;
@@ -33,7 +41,10 @@ void main()
 {
     vec4 grid_world = instance_model * vec4(in_position, 1.0);
     vec2 fft_uv = grid_world.xz / view_constants.water_tile_length;
-    float height = textureLod(water_texture, fft_uv, 0.0).w;
+    float height = mix(
+        textureLod(water_frames, vec3(fft_uv, float(pc.frame_a)), 0.0).w,
+        textureLod(water_frames, vec3(fft_uv, float(pc.frame_b)), 0.0).w,
+        pc.frame_blend);
 
     height = 0.0;
 